@@ -46,6 +46,7 @@ const char *EmuSystem::creditsViewStr = CREDITS_INFO_STRING "(c) 2011-2022\nRobe
 bool EmuSystem::hasPALVideoSystem = true;
 bool EmuSystem::hasResetModes = true;
 IG::Audio::SampleFormat EmuSystem::audioSampleFormat = IG::Audio::SampleFormats::f32;
+bool EmuSystem::hasStereoSound = false; // TODO: stereo mode
 EmuSystem::NameFilterFunc EmuSystem::defaultFsFilter =
 	[](std::string_view name)
 	{
@@ -214,6 +215,30 @@ void A2600System::loadState(EmuApp &, IG::CStringView path)
 	updateSwitchValues();
 }
 
+size_t A2600System::stateSize()
+{
+	Serializer state;
+	if(!osystem.state().saveState(state))
+		return 0;
+	return state.size();
+}
+
+void A2600System::readState(EmuApp &, std::span<const uint8_t> buff)
+{
+	Serializer state{buff};
+	if(!osystem.state().loadState(state))
+		throw std::runtime_error{"Invalid state data"};
+	updateSwitchValues();
+}
+
+size_t A2600System::writeState(std::span<uint8_t> buff)
+{
+	Serializer state{buff};
+	if(!osystem.state().saveState(state))
+		throw std::runtime_error{"State data exceeds buffer size"};
+	return state.tellp();
+}
+
 void EmuApp::onCustomizeNavView(EmuApp::NavView &view)
 {
 	const Gfx::LGradientStopDesc navViewGrad[] =
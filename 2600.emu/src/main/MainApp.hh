@@ -30,7 +30,6 @@ public:
 		EmuApp{initParams, ctx}, a2600System{ctx, *this}
 	{
 		setDefaultVControlsButtonStagger(5);
-		audio().setStereo(false); // TODO: stereo mode
 	}
 
 	auto &system() { return a2600System;  }
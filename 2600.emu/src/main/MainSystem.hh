@@ -116,6 +116,9 @@ public:
 	void renderFramebuffer(EmuVideo &);
 	bool onVideoRenderFormatChange(EmuVideo &, PixelFormat);
 	bool resetSessionOptions(EmuApp &);
+	size_t stateSize();
+	void readState(EmuApp &, std::span<const uint8_t> buff);
+	size_t writeState(std::span<uint8_t> buff);
 
 private:
 	bool updatePaddle(Input::DragTrackerState dragState);
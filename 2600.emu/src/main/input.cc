@@ -188,7 +188,11 @@ void A2600System::handleInputAction(EmuApp *app, InputAction a)
 			p1DiffB ^= true;
 			if(app)
 			{
-				app->postMessage(1, false, p1DiffB ? "P1 Difficulty -> B" : "P1 Difficulty -> A");
+				// may run on the emulation thread
+				app->runOnMainThread([diffB = p1DiffB](ApplicationContext ctx)
+				{
+					EmuApp::get(ctx).postMessage(1, false, diffB ? "P1 Difficulty -> B" : "P1 Difficulty -> A");
+				});
 			}
 			ev.set(Event::ConsoleLeftDiffB, p1DiffB);
 			ev.set(Event::ConsoleLeftDiffA, !p1DiffB);
@@ -198,7 +202,10 @@ void A2600System::handleInputAction(EmuApp *app, InputAction a)
 			p2DiffB ^= true;
 			if(app)
 			{
-				app->postMessage(1, false, p2DiffB ? "P2 Difficulty -> B" : "P2 Difficulty -> A");
+				app->runOnMainThread([diffB = p2DiffB](ApplicationContext ctx)
+				{
+					EmuApp::get(ctx).postMessage(1, false, diffB ? "P2 Difficulty -> B" : "P2 Difficulty -> A");
+				});
 			}
 			ev.set(Event::ConsoleRightDiffB, p2DiffB);
 			ev.set(Event::ConsoleRightDiffA, !p2DiffB);
@@ -20,6 +20,7 @@
 #include <imagine/base/ApplicationContext.hh>
 #include <imagine/io/IOStream.hh>
 #include <imagine/io/FileIO.hh>
+#include <imagine/io/MapIO.hh>
 #include <emuframework/EmuApp.hh>
 
 using std::ios;
@@ -73,6 +74,18 @@ Serializer::Serializer()
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Serializer::Serializer(std::span<uint8_t> buff)
+  : myStream{make_unique<IG::IOStream<IG::MapIO>>(IG::MapIO{IG::IOBuffer{buff}}, ios::in | ios::out | ios::binary)}
+{
+  rewind();
+  myStream->exceptions( ios_base::failbit | ios_base::badbit | ios_base::eofbit );
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Serializer::Serializer(std::span<const uint8_t> buff)
+  : Serializer{std::span<uint8_t>{const_cast<uint8_t*>(buff.data()), buff.size()}} {}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Serializer::setPosition(size_t pos)
 {
@@ -101,6 +114,12 @@ size_t Serializer::size()
   return s;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t Serializer::tellp()
+{
+  return myStream->tellp();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt8 Serializer::getByte() const
 {
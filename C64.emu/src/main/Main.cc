@@ -20,6 +20,7 @@
 #include <imagine/gui/AlertView.hh>
 #include <imagine/util/format.hh>
 #include <imagine/util/string.h>
+#include <imagine/util/ScopeGuard.hh>
 #include <sys/time.h>
 
 extern "C"
@@ -69,6 +70,7 @@ const char *EmuSystem::creditsViewStr = CREDITS_INFO_STRING "(c) 2013-2022\nRobe
 bool EmuSystem::hasPALVideoSystem = true;
 bool EmuSystem::hasResetModes = true;
 bool EmuSystem::handlesGenericIO = false;
+bool EmuSystem::hasStereoSound = false;
 bool EmuApp::needsGlobalInstance = true;
 
 const char *EmuSystem::shortSystemName() const
@@ -287,6 +289,42 @@ void C64System::loadState(EmuApp &, IG::CStringView path)
 		return throwFileReadError();
 }
 
+size_t C64System::stateSize()
+{
+	// size depends on the attached media & RAM expansion so measure it with a test save
+	constexpr size_t maxStateSize = 32 * 1024 * 1024;
+	auto buff = std::make_unique_for_overwrite<uint8_t[]>(maxStateSize);
+	return writeMemorySnapshot({buff.get(), maxStateSize});
+}
+
+void C64System::readState(EmuApp &app, std::span<const uint8_t> buff)
+{
+	memorySnapshot = {const_cast<uint8_t*>(buff.data()), buff.size()};
+	auto resetMemorySnapshot = IG::scopeGuard([&](){ memorySnapshot = {}; });
+	loadState(app, memorySnapshotPath);
+}
+
+size_t C64System::writeState(std::span<uint8_t> buff)
+{
+	auto size = writeMemorySnapshot(buff);
+	if(!size)
+		throw std::runtime_error{"State data exceeds buffer size"};
+	return size;
+}
+
+// Returns 0 if the snapshot doesn't fit in the buffer
+size_t C64System::writeMemorySnapshot(std::span<uint8_t> buff)
+{
+	memorySnapshot = buff;
+	auto resetMemorySnapshot = IG::scopeGuard([&](){ memorySnapshot = {}; });
+	SnapshotTrapData data{.plugin{plugin}, .pathStr{memorySnapshotPath}};
+	plugin.interrupt_maincpu_trigger_trap(saveSnapshotTrap, (void*)&data);
+	execC64Frame(); // execute cpu trap
+	if(data.hasError)
+		return 0;
+	return plugin.snapshot_last_write_size();
+}
+
 VideoSystem C64System::videoSystem() const
 {
 	switch(intResource("MachineVideoStandard"))
@@ -27,10 +27,7 @@ public:
 	C64System c64System;
 
 	C64App(ApplicationInitParams initParams, ApplicationContext &ctx):
-		EmuApp{initParams, ctx}, c64System{ctx}
-	{
-		audio().setStereo(false);
-	}
+		EmuApp{initParams, ctx}, c64System{ctx} {}
 
 	auto &system() { return c64System;  }
 	const auto &system() const { return c64System;  }
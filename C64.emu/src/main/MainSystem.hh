@@ -79,6 +79,9 @@ constexpr uint8_t SYSTEM_FLAG_NO_AUTOSTART = bit(0);
 bool hasC64DiskExtension(std::string_view name);
 bool hasC64TapeExtension(std::string_view name);
 bool hasC64CartExtension(std::string_view name);
+
+// passed to VICE in place of a snapshot path to use C64System::memorySnapshot instead of a file
+constexpr const char *memorySnapshotPath = ":memory:";
 int systemCartType(ViceSystem system);
 
 class C64System final: public EmuSystem
@@ -100,6 +103,7 @@ public:
 	FS::PathString sysFilePath[Config::envIsLinux ? 5 : 3]{};
 	std::array<char, 21> externalPaletteResStr{};
 	std::array<char, 17> paletteFileResStr{};
+	std::span<uint8_t> memorySnapshot{};
 	Byte1Option optionDriveTrueEmulation{CFGKEY_DRIVE_TRUE_EMULATION, 0};
 	Byte1Option optionCropNormalBorders{CFGKEY_CROP_NORMAL_BORDERS, 1};
 	Byte1Option optionAutostartWarp{CFGKEY_AUTOSTART_WARP, 1};
@@ -216,6 +220,11 @@ public:
 	void renderFramebuffer(EmuVideo &);
 	bool shouldFastForward() const;
 	bool onVideoRenderFormatChange(EmuVideo &, PixelFormat);
+	size_t stateSize();
+	void readState(EmuApp &, std::span<const uint8_t> buff);
+	size_t writeState(std::span<uint8_t> buff);
+	// snapshots run the CPU to a trap & load them twice, too slow for rewind & run-ahead
+	size_t snapshotSize() { return 0; }
 
 protected:
 	bool initC64(EmuApp &app);
@@ -230,6 +239,7 @@ protected:
 	void setModel(int model);
 	void applyInitialOptionResources();
 	void execC64Frame();
+	size_t writeMemorySnapshot(std::span<uint8_t> buff);
 	void startCanvasRunningFrame();
 	void setCanvasSkipFrame(bool on);
 	bool updateCanvasPixelFormat(struct video_canvas_s *, PixelFormat);
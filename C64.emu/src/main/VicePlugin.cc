@@ -291,6 +291,13 @@ int VicePlugin::machine_read_snapshot(const char *name, int event_mode)
 	return -1;
 }
 
+size_t VicePlugin::snapshot_last_write_size() const
+{
+	if(snapshot_last_write_size_)
+		return std::max(snapshot_last_write_size_(), 0l);
+	return 0;
+}
+
 void VicePlugin::machine_set_restore_key(int v)
 {
 	if(machine_set_restore_key_)
@@ -522,6 +529,7 @@ VicePlugin commonVicePlugin(void *lib, ViceSystem system)
 	loadSymbolCheck(plugin.resources_get_default_value_, lib, "resources_get_default_value");
 	loadSymbolCheck(plugin.machine_write_snapshot_, lib, "machine_write_snapshot");
 	loadSymbolCheck(plugin.machine_read_snapshot_, lib, "machine_read_snapshot");
+	loadSymbolCheck(plugin.snapshot_last_write_size_, lib, "snapshot_last_write_size");
 	loadSymbolCheck(plugin.machine_set_restore_key_, lib, "machine_set_restore_key");
 	loadSymbolCheck(plugin.machine_trigger_reset_, lib, "machine_trigger_reset");
 	loadSymbolCheck(plugin.machine_drive_get_type_info_list_, lib, "machine_drive_get_type_info_list");
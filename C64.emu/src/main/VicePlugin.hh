@@ -62,6 +62,7 @@ struct VicePlugin
 	int (*resources_get_default_value_)(const char *name, void *value_return){};
 	int (*machine_write_snapshot_)(const char *name, int save_roms, int save_disks, int even_mode){};
 	int (*machine_read_snapshot_)(const char *name, int event_mode){};
+	long (*snapshot_last_write_size_)(){};
 	void (*machine_set_restore_key_)(int v){};
 	void (*machine_trigger_reset_)(const unsigned int mode){};
 	struct drive_type_info_s *(*machine_drive_get_type_info_list_)(){};
@@ -114,6 +115,7 @@ struct VicePlugin
 	int resources_get_default_value(const char *name, void *value_return) const;
 	int machine_write_snapshot(const char *name, int save_roms, int save_disks, int even_mode);
 	int machine_read_snapshot(const char *name, int event_mode);
+	size_t snapshot_last_write_size() const;
 	void machine_set_restore_key(int v);
 	void machine_trigger_reset(const unsigned int mode);
 	struct drive_type_info_s *machine_drive_get_type_info_list();
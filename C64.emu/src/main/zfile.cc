@@ -31,6 +31,14 @@ using namespace EmuEx;
 CLINK FILE *zfile_fopen(const char *path, const char *mode)
 {
 	auto appContext = gAppContext();
+	if(auto &sys = gC64System(); sys.memorySnapshot.data() && path == std::string_view{memorySnapshotPath})
+	{
+		auto f = MapIO{IOBuffer{sys.memorySnapshot}}.toFileStream(mode);
+		// unbuffered so a write past the end of the buffer fails right away instead of when closing
+		if(f)
+			setvbuf(f, nullptr, _IONBF, 0);
+		return f;
+	}
 	if(EmuApp::hasArchiveExtension(appContext.fileUriDisplayName(path)))
 	{
 		if(std::string_view{mode}.contains('w'))
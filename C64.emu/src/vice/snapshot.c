@@ -58,6 +58,7 @@ static char *current_module = NULL;
 static char read_name[SNAPSHOT_MACHINE_NAME_LEN];
 static char *current_machine_name = NULL;
 static char *current_filename = NULL;
+static long last_write_size = 0;
 static size_t current_fpos = 0;
 
 static const char snapshot_magic_string[] = "VICE Snapshot File\032";
@@ -805,7 +806,8 @@ snapshot_t *snapshot_create(const char *filename, uint8_t major_version, uint8_t
 
     current_filename = (char *)filename;
 
-    f = fopen(filename, MODE_WRITE);
+    /* opened through zfile_fopen() so the frontend can also provide memory streams */
+    f = zfile_fopen(filename, MODE_WRITE);
     if (f == NULL) {
         snapshot_error = SNAPSHOT_CANNOT_CREATE_SNAPSHOT_ERROR;
         return NULL;
@@ -960,8 +962,11 @@ int snapshot_close(snapshot_t *s)
             retval = 0;
         }
     } else {
+        /* the last module close leaves the position at the end of the snapshot */
+        last_write_size = ftell(s->file);
         if (fclose(s->file) == EOF) {
             snapshot_error = SNAPSHOT_WRITE_CLOSE_EOF_ERROR;
+            last_write_size = 0;
             retval = -1;
         } else {
             retval = 0;
@@ -972,6 +977,12 @@ int snapshot_close(snapshot_t *s)
     return retval;
 }
 
+/* size of the last snapshot written, 0 if closing it failed */
+long snapshot_last_write_size(void)
+{
+    return last_write_size;
+}
+
 static void display_error_with_vice_version(char *text, char *filename)
 {
     char *vmessage = lib_malloc(0x100);
@@ -163,6 +163,7 @@ extern snapshot_t *snapshot_open(const char *filename,
                                  uint8_t *minor_version_return,
                                  const char *snapshot_machine_name);
 extern int snapshot_close(snapshot_t *s);
+extern long snapshot_last_write_size(void);
 
 extern void snapshot_set_error(int error);
 extern int snapshot_get_error(void);
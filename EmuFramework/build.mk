@@ -4,7 +4,9 @@ ifneq ($(filter linux ios android,$(ENV)),)
  emuFramework_onScreenControls := 1
 endif
 
-SRC += AudioOptionView.cc \
+SRC += ArchiveContentCache.cc \
+AudioOptionView.cc \
+Benchmark.cc \
 BundledGamesView.cc \
 ButtonConfigView.cc \
 Cheats.cc \
@@ -26,10 +28,17 @@ EmuVideoLayer.cc \
 EmuView.cc \
 EmuViewController.cc \
 FilePicker.cc \
+FramePacingStats.cc \
 GUIOptionView.cc \
+InputActionQueue.cc \
+InputMovie.cc \
 InputManagerView.cc \
 pathUtils.cc \
 RecentGameView.cc \
+Rewind.cc \
+RunAhead.cc \
+SaveStateFile.cc \
+StateSaveWriter.cc \
 StateSlotView.cc \
 SystemOptionView.cc \
 VideoImageEffect.cc \
@@ -67,6 +76,7 @@ CFLAGS_WARN += -Werror=implicit-fallthrough
 
 include $(IMAGINE_PATH)/make/package/imagine.mk
 include $(IMAGINE_PATH)/make/package/stdc++.mk
+include $(IMAGINE_PATH)/make/package/zlib.mk
 
 include $(IMAGINE_PATH)/make/imagineStaticLibTarget.mk
 
@@ -0,0 +1,84 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/EmuSystem.hh>
+#include <imagine/base/ApplicationContext.hh>
+#include <imagine/io/IO.hh>
+#include <imagine/fs/FSDefs.hh>
+#include <imagine/util/string/CStringView.hh>
+#include <array>
+#include <cstdint>
+
+namespace IG
+{
+class ArchiveEntry;
+}
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+// Opens the content file inside an archive, keeping a decompressed copy in the cache directory when
+// the archive can be solid (7z & RAR) since reaching the entry would otherwise mean decompressing
+// everything before it on every launch. Each copy has an index file recording the archive's path,
+// size & modification time plus the entry's name, size & CRC32, and a change to the archive
+// invalidates it. Zip archives are always read directly since libarchive seeks to their entries
+// through the central directory. The least recently used copies are removed once the cache
+// exceeds maxCacheSize.
+
+class ArchiveContentCache
+{
+public:
+	struct Content
+	{
+		IO io;
+		FS::FileString name;
+	};
+
+	struct IndexHeader
+	{
+		static constexpr std::array<char, 8> magicValue{'E', 'm', 'u', 'E', 'x', 'A', 'c', '\0'};
+		static constexpr uint32_t currentVersion = 1;
+
+		std::array<char, 8> magic{magicValue};
+		uint32_t version{currentVersion};
+		uint32_t headerSize{sizeof(IndexHeader)};
+		uint64_t archiveSize{};
+		int64_t archiveMTime{}; // seconds since the UNIX epoch
+		uint64_t entrySize{};
+		uint32_t entryCRC32{};
+		uint16_t pathSize{};
+		uint16_t nameSize{};
+		// followed by the archive path & entry name
+	};
+
+	static constexpr uint64_t maxCacheSize = 512 * 1024 * 1024;
+	static constexpr uint64_t maxEntrySize = maxCacheSize / 2;
+
+	static Content open(ApplicationContext, IO archive, CStringView path, EmuSystem::NameFilterFunc);
+
+protected:
+	static bool findEntry(ArchiveEntry &, EmuSystem::NameFilterFunc);
+	static Content openCachedContent(CStringView indexPath, CStringView dataPath,
+		CStringView path, uint64_t archiveSize, FS::file_time_type archiveMTime);
+	static bool writeIndex(CStringView indexPath, IndexHeader, std::string_view path, std::string_view name);
+	static void trimCache(CStringView dir, CStringView keepIndexPath);
+	static FS::PathString cacheDirectory(ApplicationContext);
+};
+
+}
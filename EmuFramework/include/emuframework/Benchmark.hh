@@ -0,0 +1,116 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/EmuSystem.hh>
+#include <imagine/base/BaseApplication.hh>
+#include <imagine/fs/FSDefs.hh>
+#include <imagine/time/Time.hh>
+#include <imagine/pixmap/Pixmap.hh>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace EmuEx
+{
+
+class EmuApp;
+
+struct BenchmarkParams
+{
+	int frames{180}; // 0 if the command line value was invalid
+	bool video{true};
+	bool audio{};
+	bool hash{};
+	FS::PathString inputScriptPath{};
+	FS::PathString moviePath{};
+	FS::PathString reportPath{};
+};
+
+// Input events to replay during a benchmark, one per line as: <frame> <key> <1 = pushed, 0 = released>
+// where key is a system input key code as used in key configs, lines starting with # are ignored
+
+class BenchmarkInputScript
+{
+public:
+	struct Event
+	{
+		int frame{};
+		unsigned key{};
+		bool pushed{};
+	};
+
+	BenchmarkInputScript() = default;
+	BenchmarkInputScript(IG::ApplicationContext, IG::CStringView path);
+	void runEvents(EmuSystem &, EmuApp *, int frame);
+	size_t size() const { return events.size(); }
+
+protected:
+	std::vector<Event> events;
+	size_t nextEvent{};
+};
+
+// Hashes of the video & audio output during a benchmark, used to check a core still produces the
+// same output for the same content & input after a change. Only the visible pixels of each row are
+// hashed so the result doesn't depend on the frame's pitch. The system's snapshot at the end of the
+// run is also hashed when supported, covering runs without video output.
+
+class OutputChecksums
+{
+public:
+	void addVideoFrame(IG::PixmapView);
+	void addAudio(std::span<const uint8_t>);
+	void addState(std::span<const uint8_t> data) { stateHash = hashBytes(hashSeed, data); }
+	uint64_t video() const { return videoHash; }
+	uint64_t audio() const { return audioHash; }
+	std::optional<uint64_t> state() const { return stateHash; }
+	std::span<const uint64_t> frameHashes() const { return frameHashes_; }
+
+protected:
+	std::vector<uint64_t> frameHashes_;
+	uint64_t videoHash{hashSeed};
+	uint64_t audioHash{hashSeed};
+	std::optional<uint64_t> stateHash;
+
+	static constexpr uint64_t hashSeed = 0xcbf29ce484222325;
+	static uint64_t hashBytes(uint64_t hash, std::span<const uint8_t>);
+};
+
+class FrameTimeStats
+{
+public:
+	void reserve(size_t frames) { frameTimes.reserve(frames); }
+	void add(IG::Time t) { frameTimes.emplace_back(t); }
+	size_t frames() const { return frameTimes.size(); }
+	IG::Time total() const;
+	double framesPerSecond() const;
+	std::string toJson(std::string_view contentName, const BenchmarkParams &, const OutputChecksums * = {}) const;
+
+protected:
+	std::vector<IG::Time> frameTimes;
+};
+
+// Parses the --benchmark options, returns the content path or null if none was given
+const char *parseBenchmarkCommandArgs(IG::CommandArgs, std::optional<BenchmarkParams> &);
+
+// Loads & benchmarks the content given on the command line without an EmuApp, window, or renderer,
+// printing the report to stdout and returning the process exit code
+int runHeadlessBenchmark(EmuSystem &, IG::CommandArgs);
+
+}
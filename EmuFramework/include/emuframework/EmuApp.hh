@@ -18,6 +18,8 @@
 #include <emuframework/config.hh>
 #include <emuframework/EmuSystem.hh>
 #include <emuframework/EmuSystemTask.hh>
+#include <emuframework/InputActionQueue.hh>
+#include <emuframework/InputMovie.hh>
 #include <emuframework/EmuAudio.hh>
 #include <emuframework/EmuVideo.hh>
 #include <emuframework/EmuVideoLayer.hh>
@@ -25,6 +27,11 @@
 #include <emuframework/EmuInput.hh>
 #include <emuframework/VController.hh>
 #include <emuframework/TurboInput.hh>
+#include <emuframework/Rewind.hh>
+#include <emuframework/RunAhead.hh>
+#include <emuframework/StateSaveWriter.hh>
+#include <emuframework/Benchmark.hh>
+#include <emuframework/FramePacingStats.hh>
 #include <emuframework/Option.hh>
 #include <imagine/input/Input.hh>
 #include <imagine/input/android/MogaManager.hh>
@@ -126,6 +133,7 @@ public:
 	void closeSystem(bool allowAutosaveState = true);
 	void reloadSystem(EmuSystemCreateParams params = {});
 	void onSystemCreated();
+	void onSystemCreateFailed();
 	void promptSystemReloadDueToSetOption(ViewAttachParams, const Input::Event &, EmuSystemCreateParams params = {});
 	void pushAndShowNewCollectTextInputView(ViewAttachParams, const Input::Event &,
 		const char *msgText, const char *initialContent, CollectTextInputView::OnTextDelegate);
@@ -170,7 +178,14 @@ public:
 	void addTurboInputEvent(unsigned action);
 	void removeTurboInputEvent(unsigned action);
 	void runTurboInputEvents();
+	void queueInputAction(InputAction);
+	void applyInputAction(InputAction);
+	void runFrameInput();
+	bool startInputMovieRecording();
+	void stopInputMovieRecording();
+	bool isRecordingInputMovie() const { return inputMovie.isRecording(); }
 	void resetInput();
+	void resetSystem(EmuSystem::ResetMode);
 	void setRunSpeed(double speed);
 	void saveSessionOptions();
 	void loadSessionOptions();
@@ -183,6 +198,8 @@ public:
 	EmuVideo &video();
 	EmuViewController &viewController();
 	void cancelAutoSaveStateTimer();
+	void startFramePacingStats();
+	void stopFramePacingStats();
 	void startAutoSaveStateTimer();
 	void configFrameTime();
 	void setFaceButtonMapping(FaceButtonImageMap map);
@@ -228,7 +245,8 @@ public:
 	void setWindowFrameClockSource(IG::Window::FrameTimeSource src) { winFrameTimeSrc = src; }
 	IG::Window::FrameTimeSource windowFrameClockSource() const { return winFrameTimeSrc; }
 	static std::u16string_view mainViewName();
-	void runBenchmarkOneShot(EmuVideo &);
+	bool runBenchmarkOneShot(const BenchmarkParams &);
+	void runBenchmarkFromCommandLine(IG::CStringView path);
 	void onSelectFileFromPicker(IG::IO, IG::CStringView path, std::string_view displayName,
 		const Input::Event &, EmuSystemCreateParams, ViewAttachParams);
 	void handleOpenFileCommand(IG::CStringView path);
@@ -254,6 +272,8 @@ public:
 	bool soundIsEnabled() const;
 	void setAddSoundBuffersOnUnderrun(bool on);
 	bool addSoundBuffersOnUnderrun() const { return optionAddSoundBuffersOnUnderrun; }
+	void setAudioDynamicRateControl(bool on);
+	bool audioDynamicRateControl() const { return optionAudioDynamicRateControl; }
 	void setSoundDuringFastSlowModeEnabled(bool on);
 	bool soundDuringFastSlowModeIsEnabled() const;
 
@@ -299,6 +319,19 @@ public:
 	auto &fastSlowModeSpeedOption() { return optionFastSlowModeSpeed; }
 	double fastSlowModeSpeedAsDouble() { return optionFastSlowModeSpeed.val / 100.; }
 	auto &sustainedPerformanceModeOption() { return optionSustainedPerformanceMode; }
+	void setRewindBufferSize(int mebibytes);
+	int rewindBufferSize() const { return optionRewindBufferSize; }
+	void setRewindFrameInterval(int frames);
+	int rewindFrameInterval() const { return optionRewindFrameInterval; }
+	void setRewinding(bool on);
+	void resetRewind();
+	void setRunAheadFrames(int frames);
+	int runAheadFrames() const { return optionRunAheadFrames; }
+	void resetRunAhead();
+	void setFramePacingStatsMode(int mode);
+	int framePacingStatsMode() const { return optionFramePacingStats; }
+	bool framePacingStatsEnabled() const { return optionFramePacingStats; }
+	FramePacingStats &framePacingStats() { return framePacingStats_; }
 
 	// GUI Options
 	auto &pauseUnfocusedOption() { return optionPauseUnfocused; }
@@ -460,11 +493,19 @@ protected:
 	mutable Gfx::Texture assetBuffImg[wise_enum::size<AssetID>]{};
 	IG_UseMemberIf(VCONTROLS, VController, vController);
 	IG::Timer autoSaveStateTimer;
+	IG::Timer framePacingStatsTimer;
 	DelegateFunc<void ()> onUpdateInputDevices_{};
 	OnMainMenuOptionChanged onMainMenuOptionChanged_{};
 	KeyConfigContainer customKeyConfigs{};
 	InputDeviceSavedConfigContainer savedInputDevs{};
 	TurboInput turboActions{};
+	InputActionQueue inputActionQueue;
+	InputMovie inputMovie;
+	RewindManager rewindManager{};
+	RunAheadManager runAheadManager{};
+	StateSaveWriter stateSaveWriter;
+	std::optional<BenchmarkParams> cmdLineBenchmarkParams{};
+	FramePacingStats framePacingStats_{};
 	FS::PathString contentSearchPath_{};
 	[[no_unique_address]] IG::Data::PixmapReader pixmapReader;
 	[[no_unique_address]] IG::Data::PixmapWriter pixmapWriter;
@@ -484,10 +525,15 @@ protected:
 	Byte1Option optionConfirmAutoLoadState;
 	Byte1Option optionConfirmOverwriteState;
 	Byte2Option optionFastSlowModeSpeed;
+	Byte2Option optionRewindBufferSize;
+	Byte1Option optionRewindFrameInterval;
+	Byte1Option optionRunAheadFrames;
+	Byte1Option optionFramePacingStats;
 	Byte1Option optionSound;
 	Byte1Option optionSoundVolume;
 	Byte1Option optionSoundBuffers;
 	Byte1Option optionAddSoundBuffersOnUnderrun;
+	Byte1Option optionAudioDynamicRateControl;
 	IG_UseMemberIf(IG::Audio::Config::MULTIPLE_SYSTEM_APIS, Byte1Option, optionAudioAPI);
 	Byte1Option optionNotificationIcon;
 	Byte1Option optionTitleBar;
@@ -573,6 +619,7 @@ protected:
 	void addOnFrameDelegate(IG::OnFrameDelegate);
 	void onFocusChange(bool in);
 	void configureAppForEmulation(bool running);
+	FrameTimeStats playInputMovie(EmuAudio *);
 
 	const DoubleOption &frameTimeOption(VideoSystem system) const
 	{
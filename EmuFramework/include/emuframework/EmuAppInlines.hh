@@ -18,6 +18,13 @@
 #include <meta.h>
 #include <imagine/config/version.h>
 #include <main/MainApp.hh>
+#ifdef CONFIG_EMUFRAMEWORK_HEADLESS_BENCHMARK
+#include <emuframework/Benchmark.hh>
+#endif
+#if defined CONFIG_EMUFRAMEWORK_HEADLESS_BENCHMARK || defined CONFIG_EMUFRAMEWORK_HEADLESS_TEST
+#include <cstdlib>
+#include <memory>
+#endif
 
 const char *const IG::ApplicationContext::applicationName{CONFIG_APP_NAME};
 const char *const IG::ApplicationContext::applicationId{CONFIG_APP_ID};
@@ -57,10 +64,26 @@ bool EmuApp::willCreateSystem(ViewAttachParams attach, const Input::Event &e)
 namespace IG
 {
 
+#ifdef CONFIG_EMUFRAMEWORK_HEADLESS_BENCHMARK
+void ApplicationContext::onInit(ApplicationInitParams initParams)
+{
+	// run the system directly without creating the app, its window, or renderer
+	auto sys = std::make_unique<EmuEx::MainSystem>(*this);
+	::exit(EmuEx::runHeadlessBenchmark(*sys, initParams.commandArgs()));
+}
+#elif defined CONFIG_EMUFRAMEWORK_HEADLESS_TEST
+void ApplicationContext::onInit(ApplicationInitParams)
+{
+	auto sys = std::make_unique<EmuEx::MainSystem>(*this);
+	EmuEx::setGlobalSystem(*sys);
+	::exit(EmuEx::runSystemTests(*sys) ? 0 : 1);
+}
+#else
 void ApplicationContext::onInit(ApplicationInitParams initParams)
 {
 	auto &app = initApplication<EmuEx::MainApp>(initParams, *this);
 	app.mainInitCommon(initParams, *this);
 }
+#endif
 
 }
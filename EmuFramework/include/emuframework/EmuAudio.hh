@@ -20,10 +20,34 @@
 #include <imagine/vmem/RingBuffer.hh>
 #include <memory>
 #include <atomic>
+#include <cmath>
 
 namespace EmuEx
 {
 
+class FramePacingStats;
+class OutputChecksums;
+
+// Streaming cubic (Catmull-Rom) resampler for interleaved 16-bit or float samples,
+// keeps the last input frames & fractional position between calls so chunk boundaries stay continuous
+
+class AudioResampler
+{
+public:
+	constexpr AudioResampler() = default;
+	size_t resample(void *dest, size_t destFrames, const void *src, size_t srcFrames, IG::Audio::Format, double ratio);
+	size_t drain(void *dest, const void *src, size_t srcFrames, IG::Audio::Format);
+	void prime(const void *src, size_t srcFrames, IG::Audio::Format);
+	void reset() { *this = {}; }
+	size_t heldFrames() const { return pos < 2. ? std::ceil(2. - pos) : 0; }
+	static size_t outputFramesBound(size_t srcFrames, double ratio) { return srcFrames * ratio + 2; }
+
+protected:
+	static constexpr int maxChannels = 2;
+	float history[3][maxChannels]{};
+	double pos{2.}; // 2 is the first frame of the next input, anything less is still held in history
+};
+
 class EmuAudio
 {
 public:
@@ -39,6 +63,7 @@ public:
 		audioManagerPtr{&audioManager} {}
 	void open(IG::Audio::Api);
 	void start(IG::Microseconds targetBufferFillUSecs, IG::Microseconds bufferIncrementUSecs);
+	void startWithoutOutput(IG::Microseconds bufferUSecs);
 	void stop();
 	void close();
 	void flush();
@@ -47,15 +72,23 @@ public:
 	void setStereo(bool on);
 	void setSpeedMultiplier(double speed);
 	void setAddSoundBuffersOnUnderrun(bool on);
+	void setDynamicRateControl(bool on);
 	void setVolume(int8_t vol);
+	void setStats(FramePacingStats *stats) { statsPtr.store(stats, std::memory_order_release); }
+	void setOutputChecksums(OutputChecksums *checksums) { checksumsPtr = checksums; }
+	size_t framesWritten() const;
+	size_t framesCapacity() const;
 	IG::Audio::Format format() const;
 	explicit operator bool() const;
 
 protected:
 	IG::Audio::OutputStream audioStream{};
 	const IG::Audio::Manager *audioManagerPtr{};
+	std::atomic<FramePacingStats*> statsPtr{}; // also read from the audio callback
+	OutputChecksums *checksumsPtr{};
 	IG::RingBuffer rBuff{};
 	IG::Time lastUnderrunTime{};
+	AudioResampler resampler{};
 	double speedMultiplier = 1.;
 	size_t targetBufferFillBytes{};
 	size_t bufferIncrementBytes{};
@@ -64,11 +97,10 @@ protected:
 	float requestedVolume = 1.0;
 	std::atomic<AudioWriteState> audioWriteState = AudioWriteState::BUFFER;
 	bool addSoundBuffersOnUnderrun = false;
+	bool dynamicRateControl = false;
 	int8_t channels = 2;
 
 	size_t framesFree() const;
-	size_t framesWritten() const;
-	size_t framesCapacity() const;
 	bool shouldStartAudioWrites(size_t bytesToWrite = 0) const;
 	void resizeAudioBuffer(size_t targetBufferFillBytes);
 	const IG::Audio::Manager &audioManager() const;
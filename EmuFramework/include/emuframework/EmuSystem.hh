@@ -55,6 +55,8 @@ class EmuVideo;
 class EmuApp;
 struct EmuFrameTimeInfo;
 class VControllerKeyboard;
+class FrameTimeStats;
+class BenchmarkInputScript;
 
 struct AspectRatioInfo
 {
@@ -87,6 +89,11 @@ struct InputAction
 	unsigned key{};
 	Input::Action state{};
 	uint32_t metaState{};
+	// Where in the frame's time slice the action happened, 0 (start) to frameOffsetMax (end),
+	// for cores that poll input mid-frame. Only set for queued actions, 0 otherwise.
+	uint16_t frameOffset{};
+
+	static constexpr uint16_t frameOffsetMax = 0xFFFF;
 };
 
 enum class VideoSystem: uint8_t
@@ -152,6 +159,7 @@ public:
 	static bool handlesGenericIO;
 	static bool hasCheats;
 	static bool hasSound;
+	static bool hasStereoSound;
 	static int forcedSoundRate;
 	static IG::Audio::SampleFormat audioSampleFormat;
 	static bool constFrameRate;
@@ -203,6 +211,14 @@ public:
 	bool shouldFastForward() const;
 	FS::FileString contentDisplayNameForPath(CStringView path) const;
 	IG::Rotation contentRotation() const;
+	size_t stateSize();
+	void readState(EmuApp &, std::span<const uint8_t> buff);
+	size_t writeState(std::span<uint8_t> buff);
+	// in-memory states for rewind & run-ahead, never written to disk so they can use a faster
+	// format than writeState() as long as it's readable for the rest of the session
+	size_t snapshotSize();
+	void readSnapshot(EmuApp &, std::span<const uint8_t> buff);
+	size_t writeSnapshot(std::span<uint8_t> buff);
 
 	ApplicationContext appContext() const { return appCtx; }
 	bool isActive() const { return state == State::ACTIVE; }
@@ -211,6 +227,9 @@ public:
 	bool stateExists(int slot) const;
 	static std::string_view stateSlotName(int slot);
 	std::string_view stateSlotName() { return stateSlotName(stateSlot()); }
+	uint64_t frameCount() const { return frameCount_; }
+	void setFrameCount(uint64_t count) { frameCount_ = count; }
+	void advanceFrameCount(int frames) { frameCount_ += frames; }
 	int stateSlot() const { return saveStateSlot; }
 	void setStateSlot(int slot) { saveStateSlot = slot; }
 	void decStateSlot() { if(--saveStateSlot < -1) saveStateSlot = 9; }
@@ -251,12 +270,13 @@ public:
 	void sessionOptionSet();
 	void resetSessionOptionsSet() { sessionOptionsSet = false; }
 	bool sessionOptionsAreSet() const { return sessionOptionsSet; }
-	void createWithMedia(IG::IO, IG::CStringView path,
+	// app is null when loading without a UI, skipping the session state it keeps for the previous content
+	void createWithMedia(EmuApp *, IG::IO, IG::CStringView path,
 		std::string_view displayName, EmuSystemCreateParams, OnLoadProgressDelegate);
 	FS::PathString willLoadContentFromPath(std::string_view path, std::string_view displayName);
-	void loadContentFromPath(IG::CStringView path, std::string_view displayName,
+	void loadContentFromPath(EmuApp *, IG::CStringView path, std::string_view displayName,
 		EmuSystemCreateParams, OnLoadProgressDelegate);
-	void loadContentFromFile(IG::IO, IG::CStringView path, std::string_view displayName,
+	void loadContentFromFile(EmuApp *, IG::IO, IG::CStringView path, std::string_view displayName,
 		EmuSystemCreateParams, OnLoadProgressDelegate);
 	int updateAudioFramesPerVideoFrame();
 	double frameRate() const;
@@ -272,7 +292,7 @@ public:
 	void setStartFrameTime(IG::FrameTime time);
 	EmuFrameTimeInfo advanceFramesWithTime(IG::FrameTime time);
 	void setSpeedMultiplier(EmuAudio &, double speed);
-	IG::Time benchmark(EmuVideo &video);
+	FrameTimeStats benchmark(EmuApp *, EmuVideo *, EmuAudio *, int frames, BenchmarkInputScript * = {});
 	bool hasContent() const;
 	void resetFrameTime();
 	void pause(EmuApp &);
@@ -296,6 +316,7 @@ protected:
 	double audioFramesPerVideoFrameFloat{};
 	double currentAudioFramesPerVideoFrame{};
 	int audioFramesPerVideoFrame{};
+	uint64_t frameCount_{}; // frames emulated since the content was loaded
 	int saveStateSlot{};
 	State state{};
 	bool sessionOptionsSet{};
@@ -313,7 +334,7 @@ protected:
 	void setupContentUriPaths(IG::CStringView uri, std::string_view displayName);
 	void setupContentFilePaths(IG::CStringView filePath, std::string_view displayName);
 	void updateContentSaveDirectory();
-	void closeAndSetupNew(IG::CStringView path, std::string_view displayName);
+	void closeAndSetupNew(EmuApp *, IG::CStringView path, std::string_view displayName);
 
 	static auto &frameTimeVar(auto &self, VideoSystem system)
 	{
@@ -334,5 +355,9 @@ public:
 
 // Global instance access if required by the emulated system, valid if EmuApp::needsGlobalInstance initialized to true
 EmuSystem &gSystem();
+// Sets the global instance when running a system without an EmuApp
+void setGlobalSystem(EmuSystem &);
+// Defined by a system's test target, runs its tests without an EmuApp and returns true if all passed
+bool runSystemTests(EmuSystem &);
 
 }
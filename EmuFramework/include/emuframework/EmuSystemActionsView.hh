@@ -32,7 +32,7 @@ public:
 	void onShow() override;
 	void loadStandardItems();
 
-	static constexpr int STANDARD_ITEMS = 9;
+	static constexpr int STANDARD_ITEMS = 10;
 	static constexpr int MAX_SYSTEM_ITEMS = 6;
 
 protected:
@@ -43,6 +43,7 @@ protected:
 	TextMenuItem stateSlot;
 	IG_UseMemberIf(Config::envIsAndroid, TextMenuItem, addLauncherIcon);
 	TextMenuItem screenshot;
+	TextMenuItem recordInput;
 	TextMenuItem resetSessionOptions;
 	TextMenuItem close;
 	StaticArrayList<MenuItem*, STANDARD_ITEMS + MAX_SYSTEM_ITEMS> item;
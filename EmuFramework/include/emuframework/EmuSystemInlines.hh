@@ -186,6 +186,48 @@ void EmuSystem::saveState(IG::CStringView uri)
 	static_cast<MainSystem*>(this)->saveState(uri);
 }
 
+size_t EmuSystem::stateSize()
+{
+	if(&MainSystem::stateSize != &EmuSystem::stateSize)
+		return static_cast<MainSystem*>(this)->stateSize();
+	return 0;
+}
+
+void EmuSystem::readState(EmuApp &app, std::span<const uint8_t> buff)
+{
+	if(&MainSystem::readState != &EmuSystem::readState)
+		static_cast<MainSystem*>(this)->readState(app, buff);
+}
+
+size_t EmuSystem::writeState(std::span<uint8_t> buff)
+{
+	if(&MainSystem::writeState != &EmuSystem::writeState)
+		return static_cast<MainSystem*>(this)->writeState(buff);
+	return 0;
+}
+
+size_t EmuSystem::snapshotSize()
+{
+	if(&MainSystem::snapshotSize != &EmuSystem::snapshotSize)
+		return static_cast<MainSystem*>(this)->snapshotSize();
+	return stateSize();
+}
+
+void EmuSystem::readSnapshot(EmuApp &app, std::span<const uint8_t> buff)
+{
+	if(&MainSystem::readSnapshot != &EmuSystem::readSnapshot)
+		static_cast<MainSystem*>(this)->readSnapshot(app, buff);
+	else
+		readState(app, buff);
+}
+
+size_t EmuSystem::writeSnapshot(std::span<uint8_t> buff)
+{
+	if(&MainSystem::writeSnapshot != &EmuSystem::writeSnapshot)
+		return static_cast<MainSystem*>(this)->writeSnapshot(buff);
+	return writeState(buff);
+}
+
 void EmuSystem::clearInputBuffers(EmuInputView &view)
 {
 	static_cast<MainSystem*>(this)->clearInputBuffers(view);
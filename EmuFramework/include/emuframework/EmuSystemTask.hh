@@ -15,7 +15,7 @@
 	You should have received a copy of the GNU General Public License
 	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
 
-#include <imagine/base/MessagePort.hh>
+#include <imagine/base/SPSCMessagePort.hh>
 #include <thread>
 
 namespace EmuEx
@@ -73,7 +73,7 @@ public:
 
 private:
 	EmuApp *appPtr{};
-	IG::MessagePort<CommandMessage> commandPort{"EmuSystemTask Command"};
+	IG::SPSCMessagePort<CommandMessage> commandPort{"EmuSystemTask Command"};
 	std::thread taskThread{};
 	bool videoFormatChanged{};
 };
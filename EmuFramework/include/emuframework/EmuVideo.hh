@@ -20,6 +20,8 @@
 #include <emuframework/EmuSystemTaskContext.hh>
 #include <imagine/gfx/PixmapBufferTexture.hh>
 #include <imagine/gfx/SyncFence.hh>
+#include <imagine/pixmap/MemPixmap.hh>
+#include <array>
 #include <optional>
 
 namespace EmuEx
@@ -28,6 +30,7 @@ namespace EmuEx
 using namespace IG;
 class EmuVideo;
 class EmuSystem;
+class OutputChecksums;
 
 class [[nodiscard]] EmuVideoImage
 {
@@ -49,6 +52,7 @@ class EmuVideo : public EmuAppHelper<EmuVideo>
 public:
 	using FrameFinishedDelegate = DelegateFunc<void (EmuVideo &)>;
 	using FormatChangedDelegate = DelegateFunc<void (EmuVideo &)>;
+	static constexpr int thumbnailMaxSize = 64;
 
 	constexpr EmuVideo() = default;
 	void setRendererTask(Gfx::RendererTask &);
@@ -69,6 +73,8 @@ public:
 	bool addFence(Gfx::RendererCommands &cmds);
 	void clear();
 	void takeGameScreenshot();
+	void setOutputChecksums(OutputChecksums *checksums) { checksumsPtr = checksums; }
+	IG::PixmapView captureThumbnail(EmuSystem &);
 	bool isExternalTexture() const;
 	Gfx::PixmapBufferTexture &image();
 	Gfx::Renderer &renderer() const;
@@ -91,18 +97,24 @@ protected:
 	Gfx::RendererTask *rTask{};
 	Gfx::SyncFence fence{};
 	Gfx::PixmapBufferTexture vidImg{};
+	IG::MemPixmap memImg{}; // frame storage when there's no renderer task, as in the headless benchmark
 	FrameFinishedDelegate onFrameFinished{};
 	FormatChangedDelegate onFormatChanged{};
+	OutputChecksums *checksumsPtr{};
 	IG::PixelFormat renderFmt{};
 	Gfx::TextureBufferMode bufferMode{};
 	bool screenshotNextFrame{};
 	bool singleBuffer{};
 	bool needsFence{};
+	bool thumbnailRequested{};
 	Gfx::ColorSpace colSpace{};
 	bool useLinearFilter{true};
+	IG::WP thumbnailSize{};
+	std::array<uint16_t, thumbnailMaxSize * thumbnailMaxSize> thumbnailData{}; // downscaled copy of the last captured frame
 
 	void doScreenshot(EmuSystemTaskContext, IG::PixmapView pix);
 	void postFrameFinished(EmuSystemTaskContext);
+	void writeThumbnail(IG::PixmapView pix);
 	void syncImageAccess();
 	void updateNeedsFence();
 	Gfx::TextureSamplerConfig samplerConfig() const { return samplerConfigForLinearFilter(useLinearFilter); }
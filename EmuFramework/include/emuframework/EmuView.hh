@@ -16,9 +16,7 @@
 	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
 
 #include <imagine/gui/View.hh>
-#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
 #include <imagine/gfx/GfxText.hh>
-#endif
 
 namespace EmuEx
 {
@@ -39,8 +37,8 @@ public:
 	bool inputEvent(const Input::Event &) final;
 	bool hasLayer() const { return layer; }
 	void setLayoutInputView(EmuInputView *view);
-	void updateAudioStats(int underruns, int overruns, int callbacks, double avgCallbackFrames, int frames);
-	void clearAudioStats();
+	void updateStats(IG::utf16String);
+	void clearStats();
 	EmuVideoLayer *videoLayer() const { return layer; }
 	EmuSystem &system() { return *sysPtr; }
 
@@ -48,10 +46,8 @@ private:
 	EmuVideoLayer *layer{};
 	EmuInputView *inputView{};
 	EmuSystem *sysPtr{};
-	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-	Gfx::Text audioStatsText{};
-	Gfx::GCRect audioStatsRect{};
-	#endif
+	Gfx::Text statsText{};
+	Gfx::GCRect statsRect{};
 };
 
 }
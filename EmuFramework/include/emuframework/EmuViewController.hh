@@ -80,8 +80,8 @@ public:
 	void updateExtraWindowViewport(IG::Window &, IG::Viewport, Gfx::RendererTask &);
 	bool drawMainWindow(IG::Window &win, IG::WindowDrawParams, Gfx::RendererTask &);
 	bool drawExtraWindow(IG::Window &win, IG::WindowDrawParams, Gfx::RendererTask &);
-	void updateEmuAudioStats(int underruns, int overruns, int callbacks, double avgCallbackFrames, int frames);
-	void clearEmuAudioStats();
+	void updateEmuStats(IG::utf16String);
+	void clearEmuStats();
 	void popToSystemActionsMenu();
 	void postDrawToEmuWindows();
 	IG::Screen *emuWindowScreen() const;
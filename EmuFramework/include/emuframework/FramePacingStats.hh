@@ -0,0 +1,82 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/time/Time.hh>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace EmuEx
+{
+
+class EmuAudio;
+
+struct FramePacingReport
+{
+	double seconds{};
+	unsigned hostFrames{};
+	unsigned emuFrames{};
+	unsigned skippedFrames{};
+	unsigned repeatedFrames{};
+	unsigned missedVsyncs{};
+	double avgEmuFrameMSecs{};
+	double maxEmuFrameMSecs{};
+	double avgRendererWaitMSecs{};
+	double maxRendererWaitMSecs{};
+	unsigned audioUnderruns{};
+	unsigned audioOverruns{};
+	size_t audioFramesBuffered{};
+	size_t audioFramesCapacity{};
+
+	std::string overlayString() const;
+	std::string json() const;
+};
+
+// Counters for finding the source of stutter in the emulation loop, written from the main,
+// emulation, and audio threads and collected into a FramePacingReport at a fixed interval
+
+class FramePacingStats
+{
+public:
+	FramePacingStats() = default;
+	void reset();
+	void addHostFrame(IG::FrameParams, int emuFrames);
+	void addEmuFrameTime(IG::Time);
+	void addRendererWaitTime(IG::Time);
+	void addAudioUnderrun() { audioUnderruns.fetch_add(1, std::memory_order_relaxed); }
+	void addAudioOverrun() { audioOverruns.fetch_add(1, std::memory_order_relaxed); }
+	FramePacingReport collect(const EmuAudio &);
+
+protected:
+	std::atomic_uint hostFrames{};
+	std::atomic_uint emuFrames{};
+	std::atomic_uint skippedFrames{};
+	std::atomic_uint repeatedFrames{};
+	std::atomic_uint missedVsyncs{};
+	std::atomic_uint emuFrameSamples{};
+	std::atomic<int64_t> emuFrameNSecs{};
+	std::atomic<int64_t> maxEmuFrameNSecs{};
+	std::atomic_uint rendererWaitSamples{};
+	std::atomic<int64_t> rendererWaitNSecs{};
+	std::atomic<int64_t> maxRendererWaitNSecs{};
+	std::atomic_uint audioUnderruns{};
+	std::atomic_uint audioOverruns{};
+	IG::FrameTime lastHostTimestamp{};
+	IG::Time lastCollectTime{};
+};
+
+}
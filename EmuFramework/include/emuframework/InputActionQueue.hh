@@ -0,0 +1,62 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/EmuSystem.hh>
+#include <imagine/base/SPSCMessagePort.hh>
+#include <imagine/time/Time.hh>
+#include <array>
+
+namespace EmuEx
+{
+
+class EmuApp;
+
+// Passes input actions from the main thread to the emulation thread so cores only see input
+// between frames. Actions are timestamped when queued, then drained at the start of each run of
+// frames and applied before the first frame ending after their timestamp, assuming the frames of
+// a run end at even intervals up to when it started. This keeps input spread over the frames it
+// happened during when catching up on several frames at once. Each action's position within its
+// frame is passed on in InputAction::frameOffset. Whatever is still queued when the emulation
+// thread pauses gets applied by the main thread with flush().
+
+class InputActionQueue
+{
+public:
+	struct TimedAction
+	{
+		InputAction action;
+		IG::Time time;
+	};
+
+	static constexpr size_t capacity = 64;
+
+	bool push(InputAction);
+	void beginFrames(int frames, IG::FloatSeconds frameTime);
+	void runFrameActions(EmuApp &);
+	void flush(EmuApp &);
+
+protected:
+	IG::SPSCMessagePort<TimedAction, capacity> port{"InputActionQueue"};
+	std::array<TimedAction, capacity> actions{};
+	size_t actionCount{};
+	size_t nextAction{};
+	IG::Time runStartTime{};
+	IG::Time frameTime{};
+	int framesLeft{};
+};
+
+}
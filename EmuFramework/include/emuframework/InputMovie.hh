@@ -0,0 +1,91 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/EmuSystem.hh>
+#include <imagine/base/ApplicationContext.hh>
+#include <imagine/util/string/CStringView.hh>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace EmuEx
+{
+
+class EmuApp;
+
+// Log of every input action passed to the system, tagged with the frame it was applied before,
+// starting from an in-memory state taken when recording began. Replaying it from that state
+// reproduces the session exactly, independent of host timing. Files are laid out as:
+// [Header][start state in a SaveStateFile container][Event...]
+// Actions only reach the log through EmuApp::applyInputAction() & resets through EmuApp::resetSystem(),
+// so recording ends when a state is loaded or rewinding starts since neither can be replayed from the log.
+
+class InputMovie
+{
+public:
+	struct Header
+	{
+		static constexpr std::array<char, 8> magicValue{'E', 'm', 'u', 'E', 'x', 'M', 'v', '\0'};
+		static constexpr uint32_t currentVersion = 1;
+
+		std::array<char, 8> magic{magicValue};
+		uint32_t version{currentVersion};
+		uint32_t headerSize{sizeof(Header)};
+		uint64_t stateFileSize{};
+		uint32_t frames{};
+		uint32_t events{};
+	};
+
+	enum class EventType : uint8_t { ACTION, CLEAR_INPUT, RESET };
+
+	struct Event
+	{
+		uint32_t frame{};
+		uint32_t key{};
+		uint32_t metaState{};
+		Input::Action action{};
+		EventType type{};
+		uint16_t frameOffset{};
+	};
+
+	InputMovie() = default;
+	void startRecording(EmuSystem &);
+	void stopRecording();
+	bool isRecording() const { return recording; }
+	bool isPlaying() const { return playing; }
+	uint32_t frames() const { return frameCount; }
+	size_t events() const { return eventLog.size(); }
+	void record(InputAction);
+	void recordClearInput();
+	void recordReset(EmuSystem::ResetMode);
+	void endFrameInput() { if(recording) frameCount++; }
+	void startPlayback(EmuApp &);
+	void playFrame(EmuApp &);
+	void save(IG::ApplicationContext, IG::CStringView path) const;
+	void load(IG::ApplicationContext, IG::CStringView path);
+
+protected:
+	std::vector<uint8_t> startState;
+	std::vector<Event> eventLog;
+	uint32_t frameCount{};
+	uint32_t playFrameIdx{};
+	size_t nextEvent{};
+	bool recording{};
+	bool playing{};
+};
+
+}
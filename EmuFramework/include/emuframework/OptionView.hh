@@ -93,6 +93,8 @@ protected:
 	TextMenuItem renderPixelFormatItem[3];
 	MultiChoiceMenuItem renderPixelFormat;
 	IG_UseMemberIf(Config::envIsAndroid, BoolMenuItem, presentationTime);
+	TextMenuItem framePacingStatsItem[4];
+	MultiChoiceMenuItem framePacingStats;
 	TextHeadingMenuItem visualsHeading;
 	TextHeadingMenuItem screenShapeHeading;
 	TextHeadingMenuItem advancedHeading;
@@ -112,6 +114,7 @@ protected:
 	TextMenuItem::SelectDelegate setImgEffectPixelFormatDel();
 	TextMenuItem::SelectDelegate setWindowDrawableConfigDel(Gfx::DrawableConfig);
 	TextMenuItem::SelectDelegate setImageBuffersDel();
+	TextMenuItem::SelectDelegate setFramePacingStatsDel();
 	EmuVideo &emuVideo() const;
 };
 
@@ -131,6 +134,7 @@ protected:
 	TextMenuItem soundBuffersItem[7];
 	MultiChoiceMenuItem soundBuffers;
 	BoolMenuItem addSoundBuffersOnUnderrun;
+	BoolMenuItem dynamicRateControl;
 	StaticArrayList<TextMenuItem, 5> audioRateItem;
 	MultiChoiceMenuItem audioRate;
 	IG_UseMemberIf(IG::Audio::Manager::HAS_SOLO_MIX, BoolMenuItem, audioSoloMix);
@@ -157,11 +161,20 @@ protected:
 	BoolMenuItem confirmOverwriteState;
 	TextMenuItem fastSlowModeSpeedItem[8];
 	MultiChoiceMenuItem fastSlowModeSpeed;
+	TextMenuItem rewindBufferSizeItem[6];
+	MultiChoiceMenuItem rewindBufferSize;
+	TextMenuItem rewindFrameIntervalItem[5];
+	MultiChoiceMenuItem rewindFrameInterval;
+	TextMenuItem runAheadFramesItem[5];
+	MultiChoiceMenuItem runAheadFrames;
 	IG_UseMemberIf(Config::envIsAndroid, BoolMenuItem, performanceMode);
 	StaticArrayList<MenuItem*, 24> item;
 
 	TextMenuItem::SelectDelegate setAutoSaveStateDel();
 	TextMenuItem::SelectDelegate setFastSlowModeSpeedDel();
+	TextMenuItem::SelectDelegate setRewindBufferSizeDel();
+	TextMenuItem::SelectDelegate setRewindFrameIntervalDel();
+	TextMenuItem::SelectDelegate setRunAheadFramesDel();
 };
 
 class FilePathOptionView : public TableView, public EmuAppHelper<FilePathOptionView>
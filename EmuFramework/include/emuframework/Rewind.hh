@@ -0,0 +1,74 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/vmem/RingBuffer.hh>
+#include <imagine/util/container/VMemArray.hh>
+#include <algorithm>
+#include <cstdint>
+#include <span>
+
+namespace EmuEx
+{
+
+class EmuApp;
+class EmuSystem;
+
+// Stores periodic in-memory snapshots of the emulated system as XOR deltas against the next newer
+// snapshot, run-length encoded. The newest full snapshot is kept uncompressed so stepping back only
+// needs to decode & apply the newest delta. Deltas are kept in a mirrored ring buffer with a size
+// header & footer so the oldest entry can be dropped when space runs out and the newest one can be
+// popped when rewinding.
+
+class RewindManager
+{
+public:
+	static constexpr size_t entryOverhead = sizeof(uint32_t) * 2;
+	static constexpr size_t stateHeaderSize = sizeof(uint64_t);
+
+	constexpr RewindManager() = default;
+	void reset(EmuSystem &, size_t bufferBytes);
+	void deinit();
+	void clear();
+	size_t bufferSize() const { return ringBuff.capacity(); }
+	void setFrameInterval(int frames) { frameInterval_ = std::max(frames, 1); }
+	int frameInterval() const { return frameInterval_; }
+	bool isEnabled() const { return ringBuff && stateBuff.size(); }
+	bool isRewinding() const { return rewinding; }
+	void setRewinding(bool on) { rewinding = on && isEnabled(); }
+	size_t states() const { return stateCount; }
+	void onFramesCompleted(EmuSystem &, int frames);
+	bool rewindState(EmuApp &);
+
+	static size_t encodeDeltaBound(size_t size);
+	static size_t encodeDelta(std::span<const uint8_t> newer, std::span<const uint8_t> older, uint8_t *out);
+	static void applyDelta(std::span<uint8_t> state, std::span<const uint8_t> delta);
+
+protected:
+	IG::RingBuffer ringBuff;
+	IG::VMemArray<uint8_t> stateBuff; // newest full snapshot
+	IG::VMemArray<uint8_t> tempStateBuff; // scratch space for the incoming snapshot
+	size_t stateCount{};
+	int frameInterval_{1};
+	int framesUntilSave{};
+	bool hasSnapshot{};
+	bool rewinding{};
+
+	bool saveSnapshot(EmuSystem &);
+	void dropOldestEntry();
+};
+
+}
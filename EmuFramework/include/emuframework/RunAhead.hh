@@ -0,0 +1,52 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/EmuSystemTaskContext.hh>
+#include <imagine/util/container/VMemArray.hh>
+#include <cstdint>
+
+namespace EmuEx
+{
+
+class EmuApp;
+class EmuSystem;
+class EmuVideo;
+class EmuAudio;
+
+// Hides internal input latency of the emulated game by running extra frames ahead of the real one
+// and presenting the last of them. After each real frame the system state is saved to memory, the
+// look-ahead frames run with the same input & no audio output, and the saved state is restored so
+// the next host frame continues from the real timeline.
+
+class RunAheadManager
+{
+public:
+	static constexpr int maxFrames = 4;
+
+	constexpr RunAheadManager() = default;
+	void reset(EmuSystem &, int frames);
+	void deinit();
+	int frames() const { return frames_; }
+	bool isEnabled() const { return frames_ && stateBuff.size(); }
+	void runFrame(EmuApp &, EmuSystemTaskContext, EmuVideo *, EmuAudio *);
+
+protected:
+	IG::VMemArray<uint8_t> stateBuff;
+	int frames_{};
+};
+
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/pixmap/Pixmap.hh>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace EmuEx
+{
+
+// Container for save state files written by the framework:
+// [Header][RGB565 thumbnail pixels][payload]
+// The payload is either the system's writeState() data or, for systems that only save directly
+// to a file, the contents of that file, optionally deflate compressed. Fields added in later
+// versions read as zero from older files since headerSize covers only the fields that were written.
+
+class SaveStateFile
+{
+public:
+	enum class Compression : uint8_t { NONE, DEFLATE };
+
+	static constexpr uint8_t SYSTEM_FILE_PAYLOAD = 1 << 0; // payload is the output of EmuSystem::saveState()
+
+	struct Header
+	{
+		static constexpr std::array<char, 8> magicValue{'E', 'm', 'u', 'E', 'x', 'S', 't', '\0'};
+		static constexpr uint32_t currentVersion = 2;
+
+		std::array<char, 8> magic{magicValue};
+		uint32_t version{currentVersion};
+		uint32_t headerSize{sizeof(Header)};
+		uint64_t payloadSize{}; // stored size, after compression
+		// version 2
+		uint64_t stateSize{}; // size before compression
+		uint64_t frameCount{};
+		int64_t timestamp{}; // seconds since the UNIX epoch
+		uint16_t thumbnailWidth{};
+		uint16_t thumbnailHeight{};
+		Compression compression{};
+		uint8_t flags{};
+		uint16_t reserved{};
+
+		size_t thumbnailBytes() const { return thumbnailWidth * thumbnailHeight * sizeof(uint16_t); }
+	};
+
+	static bool isStateFile(std::span<const uint8_t> headerData);
+	static Header readHeader(std::span<const uint8_t> fileData);
+	static IG::PixmapView thumbnail(std::span<const uint8_t> fileData, const Header &);
+	static void readPayload(std::span<const uint8_t> fileData, const Header &, std::vector<uint8_t> &out);
+	static void write(std::vector<uint8_t> &out, Header, IG::PixmapView thumbnail, std::span<const uint8_t> state);
+};
+
+}
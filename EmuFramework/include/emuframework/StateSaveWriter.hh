@@ -0,0 +1,85 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/SaveStateFile.hh>
+#include <imagine/base/SPSCMessagePort.hh>
+#include <imagine/base/ApplicationContext.hh>
+#include <imagine/fs/FSDefs.hh>
+#include <imagine/util/string/CStringView.hh>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <semaphore>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+class EmuApp;
+class EmuSystem;
+
+// Saves states without blocking on file I/O. The system serializes into one of a pair of pooled
+// buffers while emulation is paused, then a background thread compresses it into the SaveStateFile
+// container, writes the file & reports errors back on the main thread. A new save only blocks if
+// both buffers are still waiting to be written. Systems without writeState() save to a temporary
+// file first and have its contents stored as the payload.
+
+class StateSaveWriter
+{
+public:
+	StateSaveWriter() = default;
+	~StateSaveWriter();
+	void save(EmuApp &, CStringView path);
+	void wait();
+	static void load(EmuApp &, CStringView path);
+
+protected:
+	static constexpr size_t buffers = 2;
+
+	struct Buffer
+	{
+		std::vector<uint8_t> state;
+		std::vector<uint8_t> fileData;
+		std::vector<uint16_t> thumbnail;
+		WP thumbnailSize{};
+		SaveStateFile::Header header{};
+		FS::PathString path;
+		std::atomic_bool inUse{};
+	};
+
+	struct WriteMessage
+	{
+		int8_t buffIdx{-1}; // -1 exits the thread
+	};
+
+	EmuApp *appPtr{};
+	std::array<Buffer, buffers> buff;
+	std::counting_semaphore<buffers> freeBuffers{buffers};
+	SPSCMessagePort<WriteMessage> writePort{"StateSaveWriter"};
+	std::thread ioThread;
+
+	void start(EmuApp &);
+	void writeFile(Buffer &);
+	static void writeSystemState(EmuSystem &, Buffer &);
+	static FS::PathString tempStatePath(ApplicationContext);
+};
+
+}
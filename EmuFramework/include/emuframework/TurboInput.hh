@@ -16,6 +16,7 @@
 	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
 
 #include <array>
+#include <atomic>
 
 namespace EmuEx
 {
@@ -26,13 +27,15 @@ struct TurboInput
 {
 	using Action = unsigned;
 
-	std::array<Action, 5> activeAction{};
+	// slots are set from the main thread & read by the emulation thread
+	std::array<std::atomic<Action>, 5> activeAction{};
 	int clock = 0;
 
 	constexpr TurboInput() {}
 	void addEvent(unsigned action);
 	void removeEvent(unsigned action);
 	void update(EmuApp &);
+	void reset();
 };
 
 }
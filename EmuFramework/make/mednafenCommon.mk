@@ -80,6 +80,7 @@ MDFN_CDROM_SRC := mednafen-emuex/CDImpl.cc \
 
 MDFN_CDROM_STANDALONE_SRC := $(MDFN_CDROM_SRC) \
  mednafen-emuex/MDFNApi.cc \
+ mednafen-emuex/MThreading.cc \
  mednafen-emuex/StreamImpl.cc \
  mednafen-emuex/VirtualFS.cpp \
  mednafen-emuex/MDFNFILE.cc \
@@ -0,0 +1,213 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "ArchiveCache"
+#include <emuframework/ArchiveContentCache.hh>
+#include <imagine/io/ArchiveIO.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/fs/FS.hh>
+#include <imagine/util/format.hh>
+#include <imagine/util/string.h>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace EmuEx
+{
+
+static_assert(std::is_trivially_copyable_v<ArchiveContentCache::IndexHeader>);
+
+// FNV-1a, stable across builds unlike std::hash
+static uint64_t pathHash(std::string_view path)
+{
+	uint64_t hash = 0xcbf29ce484222325;
+	for(auto c : path)
+	{
+		hash ^= uint8_t(c);
+		hash *= 0x100000001b3;
+	}
+	return hash;
+}
+
+static FS::PathString dataPathForIndex(std::string_view indexPath)
+{
+	auto path = FS::PathString{stringWithoutDotExtension(indexPath)};
+	path += ".bin";
+	return path;
+}
+
+ArchiveContentCache::Content ArchiveContentCache::open(ApplicationContext ctx, IO archive, CStringView path, EmuSystem::NameFilterFunc filter)
+{
+	auto archiveSize = archive.size();
+	auto archiveMTime = ctx.fileUriLastWriteTime(path);
+	auto dir = cacheDirectory(ctx);
+	auto indexPath = FS::pathString(dir, fmt::format("{:016x}.idx", pathHash(path)));
+	auto dataPath = dataPathForIndex(indexPath);
+	if(archiveMTime)
+	{
+		if(auto content = openCachedContent(indexPath, dataPath, path, archiveSize, archiveMTime);
+			content.io)
+		{
+			logMsg("using extracted copy of %s:%s", content.name.data(), dataPath.data());
+			return content;
+		}
+	}
+	ArchiveEntry entry{std::move(archive)};
+	if(!findEntry(entry, filter))
+		throw std::runtime_error("No recognized file extensions in archive");
+	FS::FileString name{entry.name()};
+	if(!archiveMTime || !entry.canBeSolid() || entry.size() > maxEntrySize)
+	{
+		return {entry.moveIO(), name};
+	}
+	IndexHeader header
+	{
+		.archiveSize = archiveSize,
+		.archiveMTime = archiveMTime,
+		.entrySize = entry.size(),
+		.entryCRC32 = entry.crc32(),
+		.pathSize = uint16_t(path.size()),
+		.nameSize = uint16_t(name.size()),
+	};
+	logMsg("extracting %s (%llu bytes) to:%s", name.data(), (unsigned long long)header.entrySize, dataPath.data());
+	FS::create_directory(dir);
+	FS::remove(indexPath);
+	auto tempPath = dataPath;
+	tempPath += ".tmp";
+	auto entryIO = entry.moveIO();
+	FileIO tempFile{tempPath, OpenFlagsMask::NEW | OpenFlagsMask::TEST};
+	bool extracted = tempFile && entryIO.send(tempFile, nullptr, header.entrySize) == ssize_t(header.entrySize);
+	tempFile = {};
+	if(!extracted || !FS::rename(tempPath, dataPath) || !writeIndex(indexPath, header, path, name))
+	{
+		logErr("error extracting to cache, reading from archive instead");
+		FS::remove(tempPath);
+		FS::remove(dataPath);
+		// the entry was partly read, so start over from the beginning of the archive
+		entry = entryIO.releaseArchive();
+		entry.rewind();
+		if(!findEntry(entry, filter))
+			throw std::runtime_error("No recognized file extensions in archive");
+		return {entry.moveIO(), name};
+	}
+	trimCache(dir, indexPath);
+	return {FileIO{dataPath, IOAccessHint::ALL}, name};
+}
+
+bool ArchiveContentCache::findEntry(ArchiveEntry &entry, EmuSystem::NameFilterFunc filter)
+{
+	for(bool hasEntry = entry.hasEntry(); hasEntry; hasEntry = entry.readNextEntry())
+	{
+		if(entry.type() == FS::file_type::directory)
+		{
+			continue;
+		}
+		auto name = entry.name();
+		logMsg("archive file entry:%s", name.data());
+		if(filter(name))
+			return true;
+	}
+	return false;
+}
+
+ArchiveContentCache::Content ArchiveContentCache::openCachedContent(CStringView indexPath, CStringView dataPath,
+	CStringView path, uint64_t archiveSize, FS::file_time_type archiveMTime)
+{
+	IndexHeader header;
+	std::string archivePath, name;
+	{
+		FileIO indexFile{indexPath, IOAccessHint::ALL, OpenFlagsMask::TEST};
+		if(!indexFile || indexFile.read(&header, sizeof(header)) != sizeof(header))
+			return {};
+		if(header.magic != IndexHeader::magicValue || header.version != IndexHeader::currentVersion ||
+			header.headerSize != sizeof(header))
+		{
+			logWarn("ignoring invalid index:%s", indexPath.data());
+			return {};
+		}
+		if(header.archiveSize != archiveSize || header.archiveMTime != archiveMTime)
+		{
+			logMsg("archive changed since extraction:%s", path.data());
+			return {};
+		}
+		archivePath.resize(header.pathSize);
+		name.resize(header.nameSize);
+		if(indexFile.read(archivePath.data(), archivePath.size()) != ssize_t(archivePath.size()) ||
+			indexFile.read(name.data(), name.size()) != ssize_t(name.size()) ||
+			archivePath != path.data()) // hash collision with another archive
+		{
+			return {};
+		}
+	}
+	FileIO dataFile{dataPath, IOAccessHint::ALL, OpenFlagsMask::TEST};
+	if(!dataFile || dataFile.size() != header.entrySize)
+		return {};
+	// rewriting the index marks this copy as recently used for trimCache()
+	writeIndex(indexPath, header, archivePath, name);
+	return {std::move(dataFile), FS::FileString{name}};
+}
+
+bool ArchiveContentCache::writeIndex(CStringView indexPath, IndexHeader header, std::string_view path, std::string_view name)
+{
+	FileIO indexFile{indexPath, OpenFlagsMask::NEW | OpenFlagsMask::TEST};
+	return indexFile &&
+		indexFile.write(&header, sizeof(header)) == sizeof(header) &&
+		indexFile.write(path.data(), path.size()) == ssize_t(path.size()) &&
+		indexFile.write(name.data(), name.size()) == ssize_t(name.size());
+}
+
+void ArchiveContentCache::trimCache(CStringView dir, CStringView keepIndexPath)
+{
+	struct CachedCopy
+	{
+		FS::PathString indexPath;
+		std::uintmax_t size;
+		FS::file_time_type lastUse;
+	};
+	std::vector<CachedCopy> copies;
+	std::uintmax_t totalSize{};
+	for(auto &e : FS::directory_iterator{dir})
+	{
+		if(!e.name().ends_with(".idx"))
+			continue;
+		auto size = FS::status(dataPathForIndex(e.path())).size();
+		copies.push_back({e.path(), size, FS::status(e.path()).lastWriteTime()});
+		totalSize += size;
+	}
+	if(totalSize <= maxCacheSize)
+		return;
+	std::ranges::sort(copies, {}, &CachedCopy::lastUse);
+	for(auto &c : copies)
+	{
+		if(totalSize <= maxCacheSize)
+			break;
+		if(std::string_view{c.indexPath} == keepIndexPath)
+			continue;
+		logMsg("removing extracted copy:%s", c.indexPath.data());
+		FS::remove(c.indexPath);
+		FS::remove(dataPathForIndex(c.indexPath));
+		totalSize -= c.size;
+	}
+}
+
+FS::PathString ArchiveContentCache::cacheDirectory(ApplicationContext ctx)
+{
+	return FS::pathString(ctx.cachePath(), "archiveContent");
+}
+
+}
@@ -96,6 +96,15 @@ AudioOptionView::AudioOptionView(ViewAttachParams attach, bool customMenu):
 			app().setAddSoundBuffersOnUnderrun(item.flipBoolValue(*this));
 		}
 	},
+	dynamicRateControl
+	{
+		"Dynamic Rate Control", &defaultFace(),
+		app().audioDynamicRateControl(),
+		[this](BoolMenuItem &item)
+		{
+			app().setAudioDynamicRateControl(item.flipBoolValue(*this));
+		}
+	},
 	audioRate
 	{
 		"Sound Rate", &defaultFace(),
@@ -173,6 +182,7 @@ void AudioOptionView::loadStockItems()
 	}
 	item.emplace_back(&soundBuffers);
 	item.emplace_back(&addSoundBuffersOnUnderrun);
+	item.emplace_back(&dynamicRateControl);
 	if constexpr(IG::Audio::Manager::HAS_SOLO_MIX)
 	{
 		item.emplace_back(&audioSoloMix);
@@ -0,0 +1,334 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+
+#define LOGTAG "Benchmark"
+#include <emuframework/Benchmark.hh>
+#include <emuframework/EmuApp.hh>
+#include <emuframework/EmuVideo.hh>
+#include <emuframework/EmuAudio.hh>
+#include <imagine/audio/Manager.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/io/IO.hh>
+#include <imagine/util/format.hh>
+#include <imagine/util/ranges.hh>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <cstdio>
+
+namespace EmuEx
+{
+
+static std::string_view nextToken(std::string_view &line)
+{
+	auto start = line.find_first_not_of(" \t\r");
+	if(start == line.npos)
+	{
+		line = {};
+		return {};
+	}
+	line.remove_prefix(start);
+	auto end = std::min(line.find_first_of(" \t\r"), line.size());
+	auto token = line.substr(0, end);
+	line.remove_prefix(end);
+	return token;
+}
+
+template<class T>
+static bool parseToken(std::string_view &line, T &val)
+{
+	auto token = nextToken(line);
+	auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), val);
+	return ec == std::errc{} && ptr == token.data() + token.size();
+}
+
+BenchmarkInputScript::BenchmarkInputScript(IG::ApplicationContext ctx, IG::CStringView path)
+{
+	auto buff = ctx.openFileUri(path, IOAccessHint::ALL).buffer(IOBufferMode::RELEASE);
+	if(!buff)
+		throw std::runtime_error(fmt::format("Can't read input script:{}", path));
+	std::string_view text{(const char*)buff.data(), buff.size()};
+	int lineNum = 0;
+	while(text.size())
+	{
+		lineNum++;
+		auto lineEnd = std::min(text.find('\n'), text.size());
+		auto line = text.substr(0, lineEnd);
+		text.remove_prefix(std::min(lineEnd + 1, text.size()));
+		if(line.find_first_not_of(" \t\r") == line.npos || line.starts_with('#'))
+			continue;
+		Event e;
+		int pushed;
+		if(!parseToken(line, e.frame) || !parseToken(line, e.key) || !parseToken(line, pushed))
+			throw std::runtime_error(fmt::format("Invalid input script line:{}", lineNum));
+		e.pushed = pushed;
+		events.emplace_back(e);
+	}
+	std::ranges::stable_sort(events, {}, &Event::frame);
+	logMsg("read %zu input events from script:%s", events.size(), path.data());
+}
+
+void BenchmarkInputScript::runEvents(EmuSystem &sys, EmuApp *app, int frame)
+{
+	for(; nextEvent < events.size() && events[nextEvent].frame <= frame; nextEvent++)
+	{
+		auto &e = events[nextEvent];
+		sys.handleInputAction(app, {sys.translateInputAction(e.key),
+			e.pushed ? Input::Action::PUSHED : Input::Action::RELEASED});
+	}
+}
+
+const char *parseBenchmarkCommandArgs(IG::CommandArgs arg, std::optional<BenchmarkParams> &benchParams)
+{
+	// options: --benchmark[=frames] --benchmark-no-video --benchmark-audio --benchmark-hash
+	// --benchmark-input=<script path> --benchmark-movie=<input recording path> --benchmark-report=<JSON report path>
+	const char *launchPath{};
+	for(auto argStr : std::span{arg.v, size_t(std::max(arg.c, 0))}.subspan(std::min(arg.c, 1)))
+	{
+		std::string_view opt{argStr};
+		if(!opt.starts_with("--benchmark"))
+		{
+			if(!launchPath)
+				launchPath = argStr;
+			continue;
+		}
+		if(!benchParams)
+			benchParams.emplace();
+		if(opt.starts_with("--benchmark="))
+		{
+			auto framesStr = opt.substr(12);
+			int frames{};
+			auto [ptr, ec] = std::from_chars(framesStr.data(), framesStr.data() + framesStr.size(), frames);
+			if(ec != std::errc{} || ptr != framesStr.data() + framesStr.size() || frames < 1)
+			{
+				logErr("invalid frame count in option:%s", argStr);
+				frames = 0;
+			}
+			benchParams->frames = frames;
+		}
+		else if(opt == "--benchmark-no-video")
+			benchParams->video = false;
+		else if(opt == "--benchmark-audio")
+			benchParams->audio = true;
+		else if(opt == "--benchmark-hash")
+			benchParams->hash = true;
+		else if(opt.starts_with("--benchmark-input="))
+			benchParams->inputScriptPath = opt.substr(18);
+		else if(opt.starts_with("--benchmark-movie="))
+		{
+			// recordings always replay without video
+			benchParams->moviePath = opt.substr(18);
+			benchParams->video = false;
+		}
+		else if(opt.starts_with("--benchmark-report="))
+			benchParams->reportPath = opt.substr(19);
+		else if(opt != "--benchmark")
+			logWarn("unknown option:%s", argStr);
+	}
+	if(!launchPath)
+	{
+		benchParams.reset();
+		return nullptr;
+	}
+	logMsg("starting content from command line:%s", launchPath);
+	return launchPath;
+}
+
+int runHeadlessBenchmark(EmuSystem &sys, IG::CommandArgs args)
+{
+	std::optional<BenchmarkParams> paramsOpt;
+	auto path = parseBenchmarkCommandArgs(args, paramsOpt);
+	if(!path)
+	{
+		fmt::print(stderr, "usage: {} <content path> [--benchmark=frames] [--benchmark-no-video] [--benchmark-audio] "
+			"[--benchmark-hash] [--benchmark-input=script path] [--benchmark-report=JSON report path]\n",
+			args.c ? args.v[0] : "benchmark");
+		return 1;
+	}
+	auto params = paramsOpt.value_or(BenchmarkParams{});
+	if(!params.frames)
+		return 1;
+	if(params.moviePath.size())
+	{
+		// playback restores the recording's input state through the app's input view
+		fmt::print(stderr, "input recordings need the full app, use its --benchmark-movie option instead\n");
+		return 1;
+	}
+	auto ctx = sys.appContext();
+	setGlobalSystem(sys);
+	std::string contentName;
+	FrameTimeStats stats;
+	OutputChecksums checksums;
+	try
+	{
+		BenchmarkInputScript inputScript;
+		if(params.inputScriptPath.size())
+			inputScript = {ctx, params.inputScriptPath};
+		sys.onOptionsLoaded();
+		// frames are written to memory instead of a texture since the video has no renderer task
+		EmuVideo video;
+		video.setRenderPixelFormat(sys, EmuSystem::canRenderRGBA8888 ? IG::PIXEL_RGBA8888 : IG::PIXEL_RGB565, {});
+		IG::Audio::Manager audioManager{ctx};
+		EmuAudio audio{audioManager};
+		sys.createWithMedia(nullptr, {}, path, ctx.fileUriDisplayName(path), {},
+			[](int pos, int max, const char *label){ return true; });
+		contentName = sys.contentDisplayName();
+		sys.configAudioPlayback(audio, 48000);
+		if(params.audio)
+			audio.startWithoutOutput(IG::Milliseconds{100});
+		if(params.hash)
+		{
+			video.setOutputChecksums(&checksums);
+			audio.setOutputChecksums(&checksums);
+		}
+		logMsg("starting headless benchmark of %s", path);
+		stats = sys.benchmark(nullptr, params.video ? &video : nullptr, params.audio ? &audio : nullptr,
+			params.frames, &inputScript);
+		video.setOutputChecksums({});
+		audio.setOutputChecksums({});
+		if(params.hash && sys.snapshotSize())
+		{
+			std::vector<uint8_t> snapshot(sys.snapshotSize());
+			snapshot.resize(sys.writeSnapshot(snapshot));
+			checksums.addState(snapshot);
+		}
+		sys.flushBackupMemory();
+		sys.closeSystem();
+	}
+	catch(std::exception &err)
+	{
+		fmt::print(stderr, "error running benchmark: {}\n", err.what());
+		return 1;
+	}
+	auto report = stats.toJson(contentName, params, params.hash ? &checksums : nullptr);
+	if(params.reportPath.size())
+	{
+		try
+		{
+			ctx.openFileUri(params.reportPath, OpenFlagsMask::NEW).write(report.data(), report.size());
+		}
+		catch(std::exception &err)
+		{
+			fmt::print(stderr, "error writing benchmark report: {}\n", err.what());
+			return 1;
+		}
+	}
+	else
+	{
+		std::fputs(report.c_str(), stdout);
+	}
+	return 0;
+}
+
+IG::Time FrameTimeStats::total() const
+{
+	IG::Time sum{};
+	for(auto t : frameTimes) { sum += t; }
+	return sum;
+}
+
+double FrameTimeStats::framesPerSecond() const
+{
+	auto secs = IG::FloatSeconds{total()}.count();
+	return secs > 0. ? frames() / secs : 0.;
+}
+
+uint64_t OutputChecksums::hashBytes(uint64_t hash, std::span<const uint8_t> data)
+{
+	// FNV-1a style mixing, a word at a time since frames are hashed every emulated frame
+	constexpr uint64_t prime = 0x100000001b3;
+	size_t i = 0;
+	for(; i + sizeof(uint64_t) <= data.size(); i += sizeof(uint64_t))
+	{
+		uint64_t word;
+		memcpy(&word, data.data() + i, sizeof(word));
+		hash = (hash ^ word) * prime;
+		hash ^= hash >> 29;
+	}
+	for(; i < data.size(); i++)
+	{
+		hash = (hash ^ data[i]) * prime;
+	}
+	return hash;
+}
+
+void OutputChecksums::addVideoFrame(IG::PixmapView pix)
+{
+	uint64_t hash = hashSeed;
+	auto rowBytes = pix.format().pixelBytes(pix.w());
+	auto data = (const uint8_t*)pix.data();
+	for(auto y : IG::iotaCount(pix.h()))
+	{
+		hash = hashBytes(hash, {data + y * pix.pitchBytes(), size_t(rowBytes)});
+	}
+	frameHashes_.emplace_back(hash);
+	videoHash = (videoHash ^ hash) * 0x100000001b3;
+}
+
+void OutputChecksums::addAudio(std::span<const uint8_t> data)
+{
+	audioHash = hashBytes(audioHash, data);
+}
+
+std::string FrameTimeStats::toJson(std::string_view contentName, const BenchmarkParams &params,
+	const OutputChecksums *checksums) const
+{
+	auto sorted = frameTimes;
+	std::ranges::sort(sorted);
+	// nearest-rank percentile of the sorted frame times, in microseconds
+	auto percentileUSecs = [&](double p)
+	{
+		if(sorted.empty())
+			return 0.;
+		auto rank = std::clamp(size_t(std::ceil(p * sorted.size())), 1zu, sorted.size());
+		return std::chrono::duration<double, std::micro>{sorted[rank - 1]}.count();
+	};
+	// keep the content name valid as a JSON string
+	std::string name;
+	for(auto c : contentName)
+	{
+		if(c == '"' || c == '\\')
+			name += '\\';
+		if((unsigned char)c >= 0x20)
+			name += c;
+	}
+	std::string hashes;
+	if(checksums)
+	{
+		hashes = fmt::format(",\"videoHash\":\"{:016x}\",\"audioHash\":\"{:016x}\",\"frameHashes\":[",
+			checksums->video(), checksums->audio());
+		for(auto h : checksums->frameHashes())
+		{
+			hashes += fmt::format("\"{:016x}\",", h);
+		}
+		if(hashes.back() == ',')
+			hashes.back() = ']';
+		else
+			hashes += ']';
+		if(checksums->state())
+			hashes += fmt::format(",\"stateHash\":\"{:016x}\"", *checksums->state());
+	}
+	return fmt::format("{{\"content\":\"{}\",\"frames\":{},\"video\":{},\"audio\":{},"
+		"\"totalSeconds\":{:.6f},\"fps\":{:.2f},"
+		"\"frameTimeUSecs\":{{\"min\":{:.1f},\"median\":{:.1f},\"p99\":{:.1f},\"max\":{:.1f}}}{}}}\n",
+		name, frames(), params.video, params.audio,
+		IG::FloatSeconds{total()}.count(), framesPerSecond(),
+		percentileUSecs(0.), percentileUSecs(.5), percentileUSecs(.99), percentileUSecs(1.), hashes);
+}
+
+}
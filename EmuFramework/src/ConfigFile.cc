@@ -293,6 +293,10 @@ void EmuApp::saveConfigFile(FileIO &io)
 		optionMenuOrientation,
 		optionConfirmOverwriteState,
 		optionFastSlowModeSpeed,
+		optionRewindBufferSize,
+		optionRewindFrameInterval,
+		optionRunAheadFrames,
+		optionFramePacingStats,
 		#ifdef CONFIG_INPUT_DEVICE_HOTSWAP
 		optionNotifyInputDeviceChange,
 		#endif
@@ -317,6 +321,7 @@ void EmuApp::saveConfigFile(FileIO &io)
 		#endif
 		optionSoundBuffers,
 		optionAddSoundBuffersOnUnderrun,
+		optionAudioDynamicRateControl,
 		#ifdef CONFIG_AUDIO_MULTIPLE_SYSTEM_APIS
 		optionAudioAPI,
 		#endif
@@ -586,6 +591,10 @@ EmuApp::ConfigParams EmuApp::loadConfigFile(IG::ApplicationContext ctx)
 					if(ctx.hasTranslucentSysUI()) readOptionValue(io, size, layoutBehindSystemUI);
 				bcase CFGKEY_CONFIRM_OVERWRITE_STATE: optionConfirmOverwriteState.readFromIO(io, size);
 				bcase CFGKEY_FAST_SLOW_MODE_SPEED: optionFastSlowModeSpeed.readFromIO(io, size);
+				bcase CFGKEY_REWIND_BUFFER_SIZE: optionRewindBufferSize.readFromIO(io, size);
+				bcase CFGKEY_REWIND_FRAME_INTERVAL: optionRewindFrameInterval.readFromIO(io, size);
+				bcase CFGKEY_RUN_AHEAD_FRAMES: optionRunAheadFrames.readFromIO(io, size);
+				bcase CFGKEY_FRAME_PACING_STATS: optionFramePacingStats.readFromIO(io, size);
 				#ifdef CONFIG_INPUT_DEVICE_HOTSWAP
 				bcase CFGKEY_NOTIFY_INPUT_DEVICE_CHANGE: optionNotifyInputDeviceChange.readFromIO(io, size);
 				#endif
@@ -609,6 +618,7 @@ EmuApp::ConfigParams EmuApp::loadConfigFile(IG::ApplicationContext ctx)
 				bcase CFGKEY_SOUND_BUFFERS: optionSoundBuffers.readFromIO(io, size);
 				bcase CFGKEY_SOUND_VOLUME: optionSoundVolume.readFromIO(io, size);
 				bcase CFGKEY_ADD_SOUND_BUFFERS_ON_UNDERRUN: optionAddSoundBuffersOnUnderrun.readFromIO(io, size);
+				bcase CFGKEY_AUDIO_DYNAMIC_RATE_CONTROL: optionAudioDynamicRateControl.readFromIO(io, size);
 				bcase CFGKEY_AUDIO_SOLO_MIX: audioManager().setSoloMix(readOptionValue<bool>(io, size));
 				#ifdef CONFIG_AUDIO_MULTIPLE_SYSTEM_APIS
 				bcase CFGKEY_AUDIO_API: optionAudioAPI.readFromIO(io, size);
@@ -49,6 +49,9 @@ namespace EmuEx
 constexpr uint8_t OPTION_SOUND_ENABLED_FLAG = IG::bit(0);
 constexpr uint8_t OPTION_SOUND_DURING_FAST_SLOW_MODE_ENABLED_FLAG = IG::bit(1);
 constexpr uint8_t OPTION_SOUND_DEFAULT_FLAGS = OPTION_SOUND_ENABLED_FLAG | OPTION_SOUND_DURING_FAST_SLOW_MODE_ENABLED_FLAG;
+
+constexpr uint8_t FRAME_PACING_STATS_OVERLAY_FLAG = IG::bit(0);
+constexpr uint8_t FRAME_PACING_STATS_LOG_FLAG = IG::bit(1);
 static EmuApp *gAppPtr{};
 [[gnu::weak]] bool EmuApp::hasIcon = true;
 [[gnu::weak]] bool EmuApp::autoSaveStateDefault = true;
@@ -130,6 +133,19 @@ EmuApp::EmuApp(ApplicationInitParams initParams, ApplicationContext &ctx):
 			return true;
 		}
 	},
+	framePacingStatsTimer
+	{
+		"EmuApp::framePacingStatsTimer",
+		[this]()
+		{
+			auto report = framePacingStats_.collect(audio());
+			if(optionFramePacingStats & FRAME_PACING_STATS_OVERLAY_FLAG)
+				viewController().updateEmuStats(report.overlayString());
+			if(optionFramePacingStats & FRAME_PACING_STATS_LOG_FLAG)
+				logMsg("frame pacing:%s", report.json().c_str());
+			return true;
+		}
+	},
 	pixmapReader{ctx},
 	pixmapWriter{ctx},
 	vibrationManager_{ctx},
@@ -148,12 +164,17 @@ EmuApp::EmuApp(ApplicationInitParams initParams, ApplicationContext &ctx):
 	optionConfirmAutoLoadState{CFGKEY_CONFIRM_AUTO_LOAD_STATE, 1},
 	optionConfirmOverwriteState{CFGKEY_CONFIRM_OVERWRITE_STATE, 1},
 	optionFastSlowModeSpeed{CFGKEY_FAST_SLOW_MODE_SPEED, 800, false, optionIsValidWithMinMax<int(MIN_RUN_SPEED * 100.), int(MAX_RUN_SPEED * 100.)>},
+	optionRewindBufferSize{CFGKEY_REWIND_BUFFER_SIZE, 0, false, optionIsValidWithMax<1024, uint16_t>},
+	optionRewindFrameInterval{CFGKEY_REWIND_FRAME_INTERVAL, 2, false, optionIsValidWithMinMax<1, 60, uint8_t>},
+	optionRunAheadFrames{CFGKEY_RUN_AHEAD_FRAMES, 0, false, optionIsValidWithMax<RunAheadManager::maxFrames, uint8_t>},
+	optionFramePacingStats{CFGKEY_FRAME_PACING_STATS, 0, false, optionIsValidWithMax<FRAME_PACING_STATS_OVERLAY_FLAG | FRAME_PACING_STATS_LOG_FLAG, uint8_t>},
 	optionSound{CFGKEY_SOUND, OPTION_SOUND_DEFAULT_FLAGS},
 	optionSoundVolume{CFGKEY_SOUND_VOLUME,
 		100, false, optionIsValidWithMinMax<0, 100, uint8_t>},
 	optionSoundBuffers{CFGKEY_SOUND_BUFFERS,
 		3, 0, optionIsValidWithMinMax<1, 7, uint8_t>},
 	optionAddSoundBuffersOnUnderrun{CFGKEY_ADD_SOUND_BUFFERS_ON_UNDERRUN, 1, 0},
+	optionAudioDynamicRateControl{CFGKEY_AUDIO_DYNAMIC_RATE_CONTROL, 1, 0},
 	optionAudioAPI{CFGKEY_AUDIO_API, 0},
 	optionNotificationIcon{CFGKEY_NOTIFICATION_ICON, 1, !Config::envIsAndroid},
 	optionTitleBar{CFGKEY_TITLE_BAR, 1, !CAN_HIDE_TITLE_BAR},
@@ -288,8 +309,11 @@ static void suspendEmulation(EmuApp &app)
 void EmuApp::closeSystem(bool allowAutosaveState)
 {
 	showUI();
+	stopInputMovieRecording();
 	emuSystemTask.stop();
 	system().closeRuntimeSystem(*this, allowAutosaveState);
+	rewindManager.deinit();
+	runAheadManager.deinit();
 	viewController().onSystemClosed();
 }
 
@@ -338,17 +362,6 @@ void EmuApp::showExitAlert(ViewAttachParams attach, const Input::Event &e)
 		attach, system().hasContent()), e, false);
 }
 
-static const char *parseCommandArgs(IG::CommandArgs arg)
-{
-	if(arg.c < 2)
-	{
-		return nullptr;
-	}
-	auto launchPath = arg.v[1];
-	logMsg("starting content from command line:%s", launchPath);
-	return launchPath;
-}
-
 bool EmuApp::setWindowDrawableConfig(Gfx::DrawableConfig conf)
 {
 	windowDrawableConf = conf;
@@ -508,7 +521,7 @@ void EmuApp::mainInitCommon(IG::ApplicationInitParams initParams, IG::Applicatio
 	system().onOptionsLoaded();
 	loadSystemOptions();
 	updateLegacySavePathOnStoragePath(ctx, system());
-	auto launchGame = parseCommandArgs(initParams.commandArgs());
+	auto launchGame = parseBenchmarkCommandArgs(initParams.commandArgs(), cmdLineBenchmarkParams);
 	if(launchGame)
 		system().setInitialLoadPath(launchGame);
 	audioManager().setMusicVolumeControlHint();
@@ -516,6 +529,7 @@ void EmuApp::mainInitCommon(IG::ApplicationInitParams initParams, IG::Applicatio
 		optionSoundRate.reset();
 	emuAudio.setRate(optionSoundRate);
 	emuAudio.setAddSoundBuffersOnUnderrun(optionAddSoundBuffersOnUnderrun);
+	emuAudio.setDynamicRateControl(optionAudioDynamicRateControl);
 	if(!renderer.supportsColorSpace())
 		windowDrawableConf.colorSpace = {};
 	applyOSNavStyle(ctx, false);
@@ -541,6 +555,7 @@ void EmuApp::mainInitCommon(IG::ApplicationInitParams initParams, IG::Applicatio
 					ctx.addNotification(title, title, system().contentDisplayName());
 				}
 			}
+			stateSaveWriter.wait();
 			emuAudio.close();
 			audioManager().endSession();
 
@@ -654,6 +669,8 @@ void EmuApp::mainInitCommon(IG::ApplicationInitParams initParams, IG::Applicatio
 					auto frameInfo = sys.advanceFramesWithTime(params.timestamp());
 					if(!frameInfo.advanced)
 					{
+						if(framePacingStatsEnabled()) [[unlikely]]
+							framePacingStats_.addHostFrame(params, 0);
 						return true;
 					}
 					if(!shouldSkipLateFrames() && !altSpeed)
@@ -662,6 +679,8 @@ void EmuApp::mainInitCommon(IG::ApplicationInitParams initParams, IG::Applicatio
 					}
 					constexpr int maxFrameSkip = 8;
 					auto framesToEmulate = std::min(frameInfo.advanced, maxFrameSkip);
+					if(framePacingStatsEnabled()) [[unlikely]]
+						framePacingStats_.addHostFrame(params, framesToEmulate);
 					EmuAudio *audioPtr = audio ? &audio : nullptr;
 					/*logMsg("frame present time:%.4f next display frame:%.4f",
 						std::chrono::duration_cast<IG::FloatSeconds>(frameInfo.presentTime).count(),
@@ -709,6 +728,13 @@ void EmuApp::mainInitCommon(IG::ApplicationInitParams initParams, IG::Applicatio
 			win.setOnDraw(
 				[this](IG::Window &win, IG::Window::DrawParams params)
 				{
+					if(framePacingStatsEnabled()) [[unlikely]]
+					{
+						auto drawStart = IG::steadyClockTimestamp();
+						auto needsDraw = viewController().drawMainWindow(win, params, renderer.task());
+						framePacingStats_.addRendererWaitTime(IG::steadyClockTimestamp() - drawStart);
+						return needsDraw;
+					}
 					return viewController().drawMainWindow(win, params, renderer.task());
 				});
 
@@ -823,7 +849,10 @@ void EmuApp::mainInitCommon(IG::ApplicationInitParams initParams, IG::Applicatio
 				launchPathStr.size())
 			{
 				system().setInitialLoadPath("");
-				handleOpenFileCommand(launchPathStr);
+				if(cmdLineBenchmarkParams)
+					runBenchmarkFromCommandLine(launchPathStr);
+				else
+					handleOpenFileCommand(launchPathStr);
 			}
 
 			win.show();
@@ -915,13 +944,90 @@ void EmuApp::handleOpenFileCommand(IG::CStringView path)
 	onSelectFileFromPicker({}, path, name, Input::KeyEvent{}, {}, attachParams());
 }
 
-void EmuApp::runBenchmarkOneShot(EmuVideo &emuVideo)
+bool EmuApp::runBenchmarkOneShot(const BenchmarkParams &params)
 {
 	logMsg("starting benchmark");
-	IG::FloatSeconds time = system().benchmark(emuVideo);
+	auto contentName = system().contentDisplayName();
+	FrameTimeStats stats;
+	OutputChecksums checksums;
+	auto setChecksums = [&](OutputChecksums *ptr)
+	{
+		if(!params.hash)
+			return;
+		video().setOutputChecksums(ptr);
+		audio().setOutputChecksums(ptr);
+	};
+	try
+	{
+		BenchmarkInputScript inputScript;
+		if(params.inputScriptPath.size())
+			inputScript = {appContext(), params.inputScriptPath};
+		setChecksums(&checksums);
+		if(params.audio)
+			startAudio();
+		// audio stays unallocated if sound is disabled or there's no output device
+		auto audioPtr = params.audio && audio() ? &audio() : nullptr;
+		if(params.moviePath.size())
+		{
+			inputMovie.load(appContext(), params.moviePath);
+			stats = playInputMovie(audioPtr);
+		}
+		else
+		{
+			stats = system().benchmark(this, params.video ? &video() : nullptr, audioPtr,
+				params.frames, &inputScript);
+		}
+		if(params.audio)
+			audio().stop();
+		setChecksums({});
+		if(params.hash && system().snapshotSize())
+		{
+			std::vector<uint8_t> snapshot(system().snapshotSize());
+			snapshot.resize(system().writeSnapshot(snapshot));
+			checksums.addState(snapshot);
+		}
+	}
+	catch(std::exception &err)
+	{
+		setChecksums({});
+		closeSystem(false);
+		postErrorMessage(err.what());
+		return false;
+	}
 	closeSystem(false);
-	logMsg("done in: %f", time.count());
-	postMessage(2, 0, fmt::format("{:.2f} fps", double(180.)/time.count()));
+	logMsg("done in: %f", IG::FloatSeconds{stats.total()}.count());
+	auto report = stats.toJson(contentName, params, params.hash ? &checksums : nullptr);
+	logMsg("%s", report.c_str());
+	if(params.reportPath.size())
+	{
+		try
+		{
+			appContext().openFileUri(params.reportPath, OpenFlagsMask::NEW).write(report.data(), report.size());
+		}
+		catch(std::exception &err)
+		{
+			logErr("error writing benchmark report:%s", err.what());
+			return false;
+		}
+	}
+	postMessage(2, 0, fmt::format("{:.2f} fps", stats.framesPerSecond()));
+	return true;
+}
+
+void EmuApp::runBenchmarkFromCommandLine(IG::CStringView path)
+{
+	auto ctx = appContext();
+	if(!cmdLineBenchmarkParams->frames)
+	{
+		ctx.exit(1);
+		return;
+	}
+	logMsg("running benchmark of %s from command line", path.data());
+	createSystemWithMedia({}, path, ctx.fileUriDisplayName(path), ctx.defaultInputEvent(), {}, attachParams(),
+		[this](const Input::Event &)
+		{
+			appContext().exit(runBenchmarkOneShot(*cmdLineBenchmarkParams) ? 0 : 1);
+		});
 }
 
 void EmuApp::showEmulation()
@@ -948,7 +1054,9 @@ void EmuApp::startEmulation()
 	setCPUNeedsLowLatency(appContext(), true);
 	emuSystemTask.start();
 	system().start(*this);
+	inputMovie.recordClearInput();
 	addOnFrameDelayed();
+	startFramePacingStats();
 }
 
 void EmuApp::showUI(bool updateTopView)
@@ -965,6 +1073,9 @@ void EmuApp::pauseEmulation()
 	setCPUNeedsLowLatency(appContext(), false);
 	video().setOnFrameFinished([](EmuVideo &){});
 	emuSystemTask.pause();
+	inputActionQueue.flush(*this);
+	stopFramePacingStats();
+	rewindManager.setRewinding(false);
 	system().pause(*this);
 	setRunSpeed(1.);
 	emuVideoLayer.setBrightness(.75f);
@@ -1041,7 +1152,7 @@ void EmuApp::reloadSystem(EmuSystemCreateParams params)
 	auto ctx = appContext();
 	try
 	{
-		system().createWithMedia({}, system().contentLocation(),
+		system().createWithMedia(this, {}, system().contentLocation(),
 			ctx.fileUriDisplayName(system().contentLocation()), params,
 			[](int pos, int max, const char *label){ return true; });
 		onSystemCreated();
@@ -1058,9 +1169,18 @@ void EmuApp::onSystemCreated()
 {
 	prepareAudio();
 	updateContentRotation();
+	resetRewind();
+	resetRunAhead();
 	viewController().onSystemCreated();
 }
 
+void EmuApp::onSystemCreateFailed()
+{
+	// a benchmark from the command line has nothing left to run, report the error in the exit code
+	if(cmdLineBenchmarkParams)
+		appContext().exit(1);
+}
+
 void EmuApp::promptSystemReloadDueToSetOption(ViewAttachParams attach, const Input::Event &e, EmuSystemCreateParams params)
 {
 	if(!system().hasContent())
@@ -1101,6 +1221,7 @@ void EmuApp::createSystemWithMedia(IO io, IG::CStringView path, std::string_view
 	if(!EmuApp::hasArchiveExtension(displayName) && !EmuSystem::defaultFsFilter(displayName))
 	{
 		postErrorMessage("File doesn't have a valid extension");
+		onSystemCreateFailed();
 		return;
 	}
 	if(!EmuApp::willCreateSystem(attachParams, e))
@@ -1118,7 +1239,7 @@ void EmuApp::createSystemWithMedia(IO io, IG::CStringView path, std::string_view
 			logMsg("starting loader thread");
 			try
 			{
-				system().createWithMedia(std::move(io), pathStr, nameStr, params,
+				system().createWithMedia(this, std::move(io), pathStr, nameStr, params,
 					[&msgPort](int pos, int max, const char *label)
 					{
 						int len = label ? std::string_view{label}.size() : -1;
@@ -1188,7 +1309,7 @@ bool EmuApp::saveState(IG::CStringView path)
 	logMsg("saving state %s", path.data());
 	try
 	{
-		system().saveState(path);
+		stateSaveWriter.save(*this, path);
 		return true;
 	}
 	catch(std::exception &err)
@@ -1212,9 +1333,11 @@ bool EmuApp::loadState(IG::CStringView path)
 	}
 	logMsg("loading state %s", path.data());
 	syncEmulationThread();
+	stopInputMovieRecording();
+	stateSaveWriter.wait();
 	try
 	{
-		system().loadState(*this, path);
+		StateSaveWriter::load(*this, path);
 		return true;
 	}
 	catch(std::exception &err)
@@ -1293,12 +1416,108 @@ void EmuApp::runTurboInputEvents()
 	turboActions.update(*this);
 }
 
+void EmuApp::queueInputAction(InputAction action)
+{
+	// only go through the queue while the emulation thread may be running frames
+	if(!system().isActive())
+	{
+		applyInputAction(action);
+		return;
+	}
+	if(inputActionQueue.push(action)) [[likely]]
+		return;
+	// Queue is full, wait for the emulation thread to finish its frames and apply everything
+	// here in order. Blocking in the port itself could deadlock since the thread only drains
+	// it when the main thread sends more frames to run.
+	logWarn("input action queue full, applying actions before next frame");
+	syncEmulationThread();
+	inputActionQueue.flush(*this);
+	applyInputAction(action);
+}
+
+void EmuApp::applyInputAction(InputAction action)
+{
+	if(inputMovie.isRecording()) [[unlikely]]
+		inputMovie.record(action);
+	system().handleInputAction(this, action);
+}
+
+void EmuApp::runFrameInput()
+{
+	if(inputMovie.isPlaying()) [[unlikely]]
+	{
+		inputMovie.playFrame(*this);
+		return;
+	}
+	runTurboInputEvents();
+	inputActionQueue.runFrameActions(*this);
+	inputMovie.endFrameInput();
+}
+
+bool EmuApp::startInputMovieRecording()
+{
+	if(!system().hasContent())
+		return false;
+	syncEmulationThread();
+	try
+	{
+		inputMovie.startRecording(system());
+		return true;
+	}
+	catch(std::exception &err)
+	{
+		postErrorMessage(err.what());
+		return false;
+	}
+}
+
+void EmuApp::stopInputMovieRecording()
+{
+	if(!inputMovie.isRecording())
+		return;
+	syncEmulationThread();
+	inputMovie.stopRecording();
+	try
+	{
+		inputMovie.save(appContext(), system().contentSaveFilePath(".emumovie"));
+		postMessage(2, false, fmt::format("Saved input recording of {} frames", inputMovie.frames()));
+	}
+	catch(std::exception &err)
+	{
+		postErrorMessage(err.what());
+	}
+}
+
+FrameTimeStats EmuApp::playInputMovie(EmuAudio *audio)
+{
+	// run each frame synced through the emulation thread without video so only the system's own work is timed
+	inputMovie.startPlayback(*this);
+	FrameTimeStats stats;
+	stats.reserve(inputMovie.frames());
+	emuSystemTask.start();
+	while(inputMovie.isPlaying())
+	{
+		auto frameStart = IG::steadyClockTimestamp();
+		emuSystemTask.runFrame(nullptr, audio, 1, false, true);
+		stats.add(IG::steadyClockTimestamp() - frameStart);
+	}
+	emuSystemTask.stop();
+	return stats;
+}
+
 void EmuApp::resetInput()
 {
-	turboActions = {};
+	turboActions.reset();
 	setRunSpeed(1.);
 }
 
+void EmuApp::resetSystem(EmuSystem::ResetMode mode)
+{
+	syncEmulationThread();
+	system().reset(*this, mode);
+	inputMovie.recordReset(mode);
+}
+
 void EmuApp::setRunSpeed(double speed)
 {
 	assumeExpr(speed > 0.);
@@ -1447,6 +1666,83 @@ void EmuApp::startAutoSaveStateTimer()
 	}
 }
 
+void EmuApp::setRewindBufferSize(int mebibytes)
+{
+	optionRewindBufferSize = mebibytes;
+	resetRewind();
+}
+
+void EmuApp::setRewindFrameInterval(int frames)
+{
+	optionRewindFrameInterval = frames;
+	rewindManager.setFrameInterval(frames);
+}
+
+void EmuApp::setRewinding(bool on)
+{
+	if(on == rewindManager.isRewinding())
+		return;
+	syncEmulationThread();
+	if(on && !rewindManager.isEnabled())
+	{
+		postErrorMessage(system().snapshotSize() ? "Rewind is disabled in System Options" : "Rewind isn't supported by this system");
+		return;
+	}
+	if(on)
+		stopInputMovieRecording();
+	rewindManager.setRewinding(on);
+}
+
+void EmuApp::resetRewind()
+{
+	if(!system().hasContent())
+		return;
+	syncEmulationThread();
+	rewindManager.setFrameInterval(optionRewindFrameInterval);
+	rewindManager.reset(system(), size_t(optionRewindBufferSize.val) * 1024 * 1024);
+}
+
+void EmuApp::setRunAheadFrames(int frames)
+{
+	optionRunAheadFrames = frames;
+	resetRunAhead();
+	if(frames && system().hasContent() && !runAheadManager.isEnabled())
+		postErrorMessage("Run-ahead isn't supported by this system");
+}
+
+void EmuApp::setFramePacingStatsMode(int mode)
+{
+	optionFramePacingStats = mode;
+	if(!system().isStarted())
+		return;
+	stopFramePacingStats();
+	startFramePacingStats();
+}
+
+void EmuApp::startFramePacingStats()
+{
+	if(!framePacingStatsEnabled())
+		return;
+	framePacingStats_.reset();
+	audio().setStats(&framePacingStats_);
+	framePacingStatsTimer.run(IG::Seconds{1}, IG::Seconds{1});
+}
+
+void EmuApp::stopFramePacingStats()
+{
+	framePacingStatsTimer.cancel();
+	audio().setStats({});
+	viewController().clearEmuStats();
+}
+
+void EmuApp::resetRunAhead()
+{
+	if(!system().hasContent())
+		return;
+	syncEmulationThread();
+	runAheadManager.reset(system(), optionRunAheadFrames);
+}
+
 VController &EmuApp::defaultVController()
 {
 	return vController;
@@ -1459,6 +1755,16 @@ void EmuApp::configFrameTime()
 
 void EmuApp::runFrames(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *audio, int frames, bool skipForward)
 {
+	if(rewindManager.isRewinding()) [[unlikely]]
+	{
+		// step back one snapshot per host frame and only render its next frame, audio stays silent
+		rewindManager.rewindState(*this);
+		inputActionQueue.beginFrames(1, system().frameTime());
+		inputActionQueue.runFrameActions(*this);
+		system().runFrame(taskCtx, video, nullptr);
+		return;
+	}
+	inputActionQueue.beginFrames(frames, system().frameTime());
 	if(skipForward) [[unlikely]]
 	{
 		if(skipForwardFrames(taskCtx, frames - 1))
@@ -1476,9 +1782,14 @@ void EmuApp::runFrames(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *
 	{
 		skipFrames(taskCtx, frames - 1, audio);
 	}
-	runTurboInputEvents();
-	system().runFrame(taskCtx, video, audio);
+	runFrameInput();
+	if(runAheadManager.isEnabled() && !skipForward)
+		runAheadManager.runFrame(*this, taskCtx, video, audio);
+	else
+		system().runFrame(taskCtx, video, audio);
 	system().updateBackupMemoryCounter();
+	system().advanceFrameCount(frames);
+	rewindManager.onFramesCompleted(system(), frames);
 }
 
 void EmuApp::skipFrames(EmuSystemTaskContext taskCtx, int frames, EmuAudio *audio)
@@ -1486,7 +1797,7 @@ void EmuApp::skipFrames(EmuSystemTaskContext taskCtx, int frames, EmuAudio *audi
 	assert(system().hasContent());
 	for(auto i : iotaCount(frames))
 	{
-		runTurboInputEvents();
+		runFrameInput();
 		system().runFrame(taskCtx, nullptr, audio);
 	}
 }
@@ -1621,6 +1932,12 @@ void EmuApp::setAddSoundBuffersOnUnderrun(bool on)
 	audio().setAddSoundBuffersOnUnderrun(on);
 }
 
+void EmuApp::setAudioDynamicRateControl(bool on)
+{
+	optionAudioDynamicRateControl = on;
+	audio().setDynamicRateControl(on);
+}
+
 bool EmuApp::soundDuringFastSlowModeIsEnabled() const
 {
 	return optionSound & OPTION_SOUND_DURING_FAST_SLOW_MODE_ENABLED_FLAG;
@@ -1897,6 +2214,6 @@ EmuApp &EmuApp::get(IG::ApplicationContext ctx)
 
 EmuApp &gApp() { return *gAppPtr; }
 
-IG::ApplicationContext gAppContext() { return gApp().appContext(); }
+IG::ApplicationContext gAppContext() { return gSystem().appContext(); }
 
 }
@@ -16,58 +16,18 @@
 #define LOGTAG "EmuAudio"
 #include <emuframework/EmuAudio.hh>
 #include <emuframework/EmuSystem.hh>
+#include <emuframework/FramePacingStats.hh>
+#include <emuframework/Benchmark.hh>
 #include <imagine/audio/Manager.hh>
 #include <imagine/util/algorithm.h>
 #include <imagine/logger/logger.h>
+#include <algorithm>
+#include <type_traits>
+#include <cstring>
 
 namespace EmuEx
 {
 
-struct AudioStats
-{
-	constexpr AudioStats() = default;
-	int underruns{};
-	int overruns{};
-	std::atomic_uint callbacks{};
-	std::atomic_uint callbackBytes{};
-
-	void reset()
-	{
-		underruns = overruns = 0;
-		callbacks = 0;
-		callbackBytes = 0;
-	}
-};
-
-#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-static AudioStats audioStats{};
-static IG::Timer audioStatsTimer{"audioStatsTimer"};
-#endif
-
-static void startAudioStats(IG::Audio::Format format)
-{
-	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-	audioStats.reset();
-	audioStatsTimer.run(IG::Seconds(1), IG::Seconds(1), {},
-		[format]()
-		{
-			auto frames = format.bytesToFrames(audioStats.callbackBytes);
-			emuViewController.updateEmuAudioStats(audioStats.underruns, audioStats.overruns,
-				audioStats.callbacks, frames / (double)audioStats.callbacks, frames);
-			audioStats.callbacks = 0;
-			audioStats.callbackBytes = 0;
-		});
-	#endif
-}
-
-static void stopAudioStats()
-{
-	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-	audioStatsTimer.deinit();
-	clearEmuAudioStats();
-	#endif
-}
-
 size_t EmuAudio::framesFree() const
 {
 	return format().bytesToFrames(rBuff.freeSpace());
@@ -89,32 +49,81 @@ bool EmuAudio::shouldStartAudioWrites(size_t bytesToWrite) const
 	return rBuff.size() + bytesToWrite >= targetBufferFillBytes;
 }
 
-template<typename T>
-static void simpleResample(T * __restrict__ dest, size_t destFrames, const T * __restrict__ src, size_t srcFrames)
+// maximum ratio adjustment when dynamic rate control is active
+constexpr double maxRateDelta = .005;
+
+static float cubicInterpolate(float x0, float x1, float x2, float x3, float t)
 {
-	if(!destFrames)
-		return;
-	float ratio = (float)srcFrames/(float)destFrames;
-	for(auto i : iotaCount(destFrames))
+	auto a = -.5f * x0 + 1.5f * x1 - 1.5f * x2 + .5f * x3;
+	auto b = x0 - 2.5f * x1 + 2.f * x2 - .5f * x3;
+	auto c = -.5f * x0 + .5f * x2;
+	return ((a * t + b) * t + c) * t + x1;
+}
+
+template<class T>
+static float loadSample(const T *src, size_t idx)
+{
+	if constexpr(std::is_floating_point_v<T>)
+		return src[idx];
+	else
+		return src[idx] * (1.f / 32768.f);
+}
+
+template<class T>
+static void storeSample(T *dest, size_t idx, float val)
+{
+	if constexpr(std::is_floating_point_v<T>)
+		dest[idx] = val;
+	else
+		dest[idx] = std::clamp(std::lround(val * 32768.f), -32768l, 32767l);
+}
+
+template<class T, int channels>
+static size_t resampleFrames(T * __restrict__ dest, size_t destFrames, const T * __restrict__ src, size_t srcFrames,
+	float (&history)[3][2], double &pos, double step)
+{
+	// position 0 is the 2nd newest history frame, so an input frame index k maps to history for k < 0
+	auto frame = [&](ptrdiff_t k, int ch)
+	{
+		return k < 0 ? history[k + 3][ch] : loadSample(src, k * channels + ch);
+	};
+	size_t outFrames = 0;
+	double t = pos;
+	while(t < srcFrames && outFrames < destFrames)
+	{
+		auto base = (ptrdiff_t)t;
+		auto frac = float(t - base);
+		for(auto ch : iotaCount(channels))
+		{
+			storeSample(dest, outFrames * channels + ch,
+				cubicInterpolate(frame(base - 3, ch), frame(base - 2, ch), frame(base - 1, ch), frame(base, ch), frac));
+		}
+		outFrames++;
+		t += step;
+	}
+	// drop any input that didn't fit in the destination
+	pos = t < srcFrames ? 0. : t - srcFrames;
+	float newHistory[3][2];
+	for(auto i : iotaCount(3))
 	{
-		size_t srcPos = std::floor((float)i * ratio);
-		if(srcPos >= srcFrames) [[unlikely]]
+		for(auto ch : iotaCount(channels))
 		{
-			logMsg("resample pos %zu too high", srcPos);
-			srcPos = srcFrames-1;
+			newHistory[i][ch] = frame(ptrdiff_t(srcFrames) - 3 + i, ch);
 		}
-		dest[i] = src[srcPos];
 	}
+	memcpy(history, newHistory, sizeof(history));
+	return outFrames;
 }
 
-static void simpleResample(void *dest, size_t destFrames, const void *src, size_t srcFrames, IG::Audio::Format format)
+size_t AudioResampler::resample(void *dest, size_t destFrames, const void *src, size_t srcFrames, IG::Audio::Format format, double ratio)
 {
+	assumeExpr(ratio > 0.);
+	auto step = 1. / ratio;
+	bool isFloat = format.sample.isFloat();
 	if(format.channels == 1)
 	{
-		if(format.sample.isFloat())
-			simpleResample((uint32_t*)dest, destFrames, (uint32_t*)src, srcFrames);
-		else
-			simpleResample((uint16_t*)dest, destFrames, (uint16_t*)src, srcFrames);
+		return isFloat ? resampleFrames<float, 1>((float*)dest, destFrames, (const float*)src, srcFrames, history, pos, step)
+			: resampleFrames<int16_t, 1>((int16_t*)dest, destFrames, (const int16_t*)src, srcFrames, history, pos, step);
 	}
 	else
 	{
@@ -122,13 +131,38 @@ static void simpleResample(void *dest, size_t destFrames, const void *src, size_
 		{
 			bug_unreachable("channels == %d", format.channels);
 		}
-		if(format.sample.isFloat())
-			simpleResample((uint64_t*)dest, destFrames, (uint64_t*)src, srcFrames);
-		else
-			simpleResample((uint32_t*)dest, destFrames, (uint32_t*)src, srcFrames);
+		return isFloat ? resampleFrames<float, 2>((float*)dest, destFrames, (const float*)src, srcFrames, history, pos, step)
+			: resampleFrames<int16_t, 2>((int16_t*)dest, destFrames, (const int16_t*)src, srcFrames, history, pos, step);
 	}
 }
 
+size_t AudioResampler::drain(void *dest, const void *src, size_t srcFrames, IG::Audio::Format format)
+{
+	// output the frames still held in history before input starts bypassing the resampler,
+	// using the new input to interpolate the last ones
+	auto frames = heldFrames();
+	if(!frames)
+		return 0;
+	return resample(dest, frames, src, srcFrames, format, 1.);
+}
+
+void AudioResampler::prime(const void *src, size_t srcFrames, IG::Audio::Format format)
+{
+	// keep history continuous when input bypasses the resampler, the newest history frame
+	// is the last one output so resampling resumes with the next input frame
+	auto newFrames = std::min(srcFrames, size_t(3));
+	memmove(history, history + newFrames, (3 - newFrames) * sizeof(history[0]));
+	for(auto i : iotaCount(newFrames))
+	{
+		for(auto ch : iotaCount(format.channels))
+		{
+			auto idx = (srcFrames - newFrames + i) * format.channels + ch;
+			history[3 - newFrames + i][ch] = format.sample.isFloat() ? loadSample((const float*)src, idx) : loadSample((const int16_t*)src, idx);
+		}
+	}
+	pos = 2.;
+}
+
 void EmuAudio::resizeAudioBuffer(size_t targetBufferFillBytes)
 {
 	auto oldCapacity = rBuff.capacity();
@@ -169,10 +203,6 @@ void EmuAudio::start(IG::Microseconds targetBufferFillUSecs, IG::Microseconds bu
 			[this, outputSampleFormat = outputFormat.sample, inputSampleFormat = inputFormat.sample, channels = outputFormat.channels](void *samples, size_t frames)
 			{
 				IG::Audio::Format outputFormat{{}, outputSampleFormat, channels};
-				#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-				audioStats.callbacks++;
-				audioStats.callbackBytes += bytes;
-				#endif
 				if(audioWriteState == AudioWriteState::ACTIVE)
 				{
 					IG::Audio::Format inputFormat = {{}, inputSampleFormat, channels};
@@ -196,9 +226,8 @@ void EmuAudio::start(IG::Microseconds targetBufferFillUSecs, IG::Microseconds bu
 							audioWriteState = AudioWriteState::UNDERRUN;
 						}
 						lastUnderrunTime = now;
-						#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-						audioStats.underruns++;
-						#endif
+						if(auto stats = statsPtr.load(std::memory_order_acquire))
+							stats->addAudioUnderrun();
 					}
 					return true;
 				}
@@ -210,12 +239,10 @@ void EmuAudio::start(IG::Microseconds targetBufferFillUSecs, IG::Microseconds bu
 			}
 		};
 		outputConf.wantedLatencyHint = {};
-		startAudioStats(inputFormat);
 		audioStream.open(outputConf);
 	}
 	else
 	{
-		startAudioStats(inputFormat);
 		if(shouldStartAudioWrites())
 		{
 			if(Config::DEBUG_BUILD)
@@ -230,13 +257,22 @@ void EmuAudio::start(IG::Microseconds targetBufferFillUSecs, IG::Microseconds bu
 	}
 }
 
+void EmuAudio::startWithoutOutput(IG::Microseconds bufferUSecs)
+{
+	// accept frames without opening a stream, writes are discarded once processed
+	targetBufferFillBytes = format().timeToBytes(bufferUSecs);
+	bufferIncrementBytes = 0;
+	resizeAudioBuffer(targetBufferFillBytes);
+	audioWriteState = AudioWriteState::BUFFER;
+}
+
 void EmuAudio::stop()
 {
-	stopAudioStats();
 	audioWriteState = AudioWriteState::BUFFER;
 	if(audioStream)
 		audioStream.close();
 	rBuff.clear();
+	resampler.reset();
 }
 
 void EmuAudio::close()
@@ -250,17 +286,19 @@ void EmuAudio::flush()
 {
 	if(!audioStream) [[unlikely]]
 		return;
-	stopAudioStats();
 	audioWriteState = AudioWriteState::BUFFER;
 	if(audioStream)
 		audioStream.flush();
 	rBuff.clear();
+	resampler.reset();
 }
 
 void EmuAudio::writeFrames(const void *samples, size_t framesToWrite)
 {
 	assumeExpr(rBuff);
 	auto inputFormat = format();
+	if(checksumsPtr) [[unlikely]]
+		checksumsPtr->addAudio({(const uint8_t*)samples, inputFormat.framesToBytes(framesToWrite)});
 	switch(audioWriteState)
 	{
 		case AudioWriteState::MULTI_UNDERRUN:
@@ -279,32 +317,39 @@ void EmuAudio::writeFrames(const void *samples, size_t framesToWrite)
 		break;
 	}
 	const size_t sampleFrames = framesToWrite;
-	if(speedMultiplier != 1.) [[unlikely]]
+	double ratio = 1. / speedMultiplier;
+	if(dynamicRateControl && audioWriteState == AudioWriteState::ACTIVE && speedMultiplier == 1.)
 	{
-		framesToWrite = std::ceil((double)framesToWrite / speedMultiplier);
-		framesToWrite = std::max(framesToWrite, 1zu);
+		// nudge the rate so the buffer fill converges on the target instead of drifting into an underrun/overrun
+		auto fillError = (double(targetBufferFillBytes) - double(rBuff.size())) / double(targetBufferFillBytes);
+		ratio *= 1. + maxRateDelta * std::clamp(fillError, -1., 1.);
 	}
-	auto bytes = inputFormat.framesToBytes(framesToWrite);
-	auto freeBytes = rBuff.freeSpace();
-	if(bytes <= freeBytes)
+	auto freeFrames = inputFormat.bytesToFrames(rBuff.freeSpace());
+	size_t bytes;
+	if(ratio == 1. && sampleFrames + resampler.heldFrames() <= freeFrames)
 	{
-		if(sampleFrames != framesToWrite)
-		{
-			simpleResample(rBuff.writeAddr(), framesToWrite, samples, sampleFrames, inputFormat);
-			rBuff.commitWrite(bytes);
-		}
-		else
-			rBuff.writeUnchecked(samples, bytes);
+		auto drainedBytes = inputFormat.framesToBytes(resampler.drain(rBuff.writeAddr(), samples, sampleFrames, inputFormat));
+		rBuff.commitWrite(drainedBytes);
+		bytes = inputFormat.framesToBytes(sampleFrames);
+		rBuff.writeUnchecked(samples, bytes);
+		resampler.prime(samples, sampleFrames, inputFormat);
+		bytes += drainedBytes;
 	}
 	else
 	{
-		logMsg("overrun, only %zu out of %zu bytes free", freeBytes, bytes);
-		#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-		audioStats.overruns++;
-		#endif
-		auto freeFrames = inputFormat.bytesToFrames(freeBytes);
-		simpleResample(rBuff.writeAddr(), freeFrames, samples, sampleFrames, inputFormat);
-		rBuff.commitWrite(freeBytes);
+		if(AudioResampler::outputFramesBound(sampleFrames, ratio) > freeFrames) [[unlikely]]
+		{
+			logMsg("overrun, only %zu out of %zu frames free", freeFrames, AudioResampler::outputFramesBound(sampleFrames, ratio));
+			if(auto stats = statsPtr.load(std::memory_order_acquire))
+				stats->addAudioOverrun();
+			// squeeze the input into the remaining space
+			ratio = std::min(ratio, double(freeFrames) / sampleFrames);
+			if(!freeFrames)
+				return;
+		}
+		auto writtenFrames = resampler.resample(rBuff.writeAddr(), freeFrames, samples, sampleFrames, inputFormat, ratio);
+		bytes = inputFormat.framesToBytes(writtenFrames);
+		rBuff.commitWrite(bytes);
 	}
 	if(audioWriteState == AudioWriteState::BUFFER && shouldStartAudioWrites(bytes))
 	{
@@ -317,6 +362,11 @@ void EmuAudio::writeFrames(const void *samples, size_t framesToWrite)
 		}
 		audioWriteState = AudioWriteState::ACTIVE;
 	}
+	if(!audioStream) [[unlikely]]
+	{
+		// nothing reads the buffer without an output stream
+		rBuff.clear();
+	}
 }
 
 void EmuAudio::setRate(int newRate)
@@ -359,6 +409,11 @@ void EmuAudio::setAddSoundBuffersOnUnderrun(bool on)
 	addSoundBuffersOnUnderrun = on;
 }
 
+void EmuAudio::setDynamicRateControl(bool on)
+{
+	dynamicRateControl = on;
+}
+
 void EmuAudio::setVolume(int8_t vol)
 {
 	if(vol == 100)
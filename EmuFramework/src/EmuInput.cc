@@ -33,19 +33,19 @@ void TurboInput::update(EmuApp &app)
 {
 	static const int turboFrames = 4;
 
-	for(auto e : activeAction)
+	for(auto &slot : activeAction)
 	{
-		if(e)
+		if(auto e = slot.load(std::memory_order_relaxed); e)
 		{
 			if(clock == 0)
 			{
 				//logMsg("turbo push for player %d, action %d", e.player, e.action);
-				app.system().handleInputAction(&app, {e, Input::Action::PUSHED});
+				app.applyInputAction({e, Input::Action::PUSHED});
 			}
 			else if(clock == turboFrames/2)
 			{
 				//logMsg("turbo release for player %d, action %d", e.player, e.action);
-				app.system().handleInputAction(&app, {e, Input::Action::RELEASED});
+				app.applyInputAction({e, Input::Action::RELEASED});
 			}
 		}
 	}
@@ -494,10 +494,10 @@ void EmuApp::updateVControllerMapping()
 
 void TurboInput::addEvent(unsigned action)
 {
-	Action *slot = IG::find_if(activeAction, [](Action a){ return a == 0; });
+	auto slot = IG::find_if(activeAction, [](auto &a){ return a.load(std::memory_order_relaxed) == 0; });
 	if(slot != activeAction.end())
 	{
-		*slot = action;
+		slot->store(action, std::memory_order_relaxed);
 		logMsg("added turbo event action %d", action);
 	}
 }
@@ -506,14 +506,24 @@ void TurboInput::removeEvent(unsigned action)
 {
 	for(auto &e : activeAction)
 	{
-		if(e == action)
+		if(e.load(std::memory_order_relaxed) == action)
 		{
-			e = 0;
+			e.store(0, std::memory_order_relaxed);
 			logMsg("removed turbo event action %d", action);
 		}
 	}
 }
 
+// Only call while the emulation thread isn't running frames
+void TurboInput::reset()
+{
+	for(auto &e : activeAction)
+	{
+		e.store(0, std::memory_order_relaxed);
+	}
+	clock = 0;
+}
+
 bool KeyConfig::operator ==(KeyConfig const& rhs) const
 {
 	return name == rhs.name;
@@ -221,6 +221,14 @@ bool EmuInputView::inputEvent(const Input::Event &e)
 							logMsg("fast-forward state:%d", ffToggleActive);
 						}
 
+						bcase guiKeyIdxRewind:
+						{
+							if(isRepeated)
+								continue;
+							emuApp.setRewinding(isPushed);
+							logMsg("rewind state:%d", isPushed);
+						}
+
 						bcase guiKeyIdxExit:
 						if(isPushed)
 						{
@@ -250,7 +258,7 @@ bool EmuInputView::inputEvent(const Input::Event &e)
 									emuApp.removeTurboInputEvent(sysAction);
 								}
 							}
-							sys.handleInputAction(&emuApp, {sysAction, keyEv.state(), keyEv.metaKeyBits()});
+							emuApp.queueInputAction({sysAction, keyEv.state(), keyEv.metaKeyBits()});
 						}
 					}
 				}
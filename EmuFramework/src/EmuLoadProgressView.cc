@@ -45,6 +45,7 @@ EmuLoadProgressView::EmuLoadProgressView(ViewAttachParams attach, const Input::E
 						auto &app = this->app();
 						app.popModalViews();
 						app.postErrorMessage(4, errorStr);
+						app.onSystemCreateFailed();
 						return;
 					}
 					bcase EmuSystem::LoadProgress::OK:
@@ -67,7 +67,9 @@ enum { CFGKEY_SOUND = 0, CFGKEY_TOUCH_CONTROL_DISPLAY = 1,
 	CFGKEY_RENDER_PIXEL_FORMAT = 88, CFGKEY_RUN_FRAMES_IN_THREAD = 89,
 	CFGKEY_SHOW_HIDDEN_FILES = 90, CFGKEY_RENDERER_PRESENTATION_TIME = 91,
 	CFGKEY_LAYOUT_BEHIND_SYSTEM_UI = 92, CFGKEY_VCONTROLLER_ALLOW_PAST_CONTENT_BOUNDS = 93,
-	CFGKEY_CONTENT_ROTATION = 94,
+	CFGKEY_CONTENT_ROTATION = 94, CFGKEY_REWIND_BUFFER_SIZE = 95,
+	CFGKEY_REWIND_FRAME_INTERVAL = 96, CFGKEY_RUN_AHEAD_FRAMES = 97,
+	CFGKEY_FRAME_PACING_STATS = 98, CFGKEY_AUDIO_DYNAMIC_RATE_CONTROL = 99,
 	// 256+ is reserved
 };
 
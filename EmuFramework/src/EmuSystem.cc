@@ -19,8 +19,9 @@
 #include <emuframework/EmuApp.hh>
 #include <emuframework/EmuAudio.hh>
 #include <emuframework/EmuVideo.hh>
+#include <emuframework/Benchmark.hh>
+#include <emuframework/ArchiveContentCache.hh>
 #include <imagine/base/ApplicationContext.hh>
-#include <imagine/fs/ArchiveFS.hh>
 #include <imagine/fs/FS.hh>
 #include <imagine/io/IO.hh>
 #include <imagine/input/DragTracker.hh>
@@ -47,6 +48,7 @@ namespace EmuEx
 [[gnu::weak]] bool EmuSystem::hasResetModes = false;
 [[gnu::weak]] bool EmuSystem::handlesArchiveFiles = false;
 [[gnu::weak]] bool EmuSystem::handlesGenericIO = true;
+[[gnu::weak]] bool EmuSystem::hasStereoSound = true;
 [[gnu::weak]] bool EmuSystem::hasCheats = false;
 [[gnu::weak]] bool EmuSystem::hasSound = true;
 [[gnu::weak]] int EmuSystem::forcedSoundRate = 0;
@@ -228,16 +230,18 @@ void EmuSystem::closeRuntimeSystem(EmuApp &app, bool allowAutosaveState)
 {
 	if(hasContent())
 	{
-		app.video().clear();
-		app.audio().flush();
+		// save first since capturing the state's thumbnail renders the last frame again
 		if(allowAutosaveState)
 			app.saveAutoState();
+		app.video().clear();
+		app.audio().flush();
 		app.saveSessionOptions();
 		logMsg("closing game:%s", contentName_.data());
 		flushBackupMemory();
 		closeSystem();
 		app.cancelAutoSaveStateTimer();
 		state = State::OFF;
+		frameCount_ = 0;
 	}
 	clearGamePaths();
 }
@@ -273,15 +277,19 @@ void EmuSystem::start(EmuApp &app)
 	app.startAutoSaveStateTimer();
 }
 
-IG::Time EmuSystem::benchmark(EmuVideo &video)
+FrameTimeStats EmuSystem::benchmark(EmuApp *app, EmuVideo *video, EmuAudio *audio, int frames, BenchmarkInputScript *inputScript)
 {
-	auto now = IG::steadyClockTimestamp();
-	for(auto i : iotaCount(180))
+	FrameTimeStats stats;
+	stats.reserve(frames);
+	for(auto i : iotaCount(frames))
 	{
-		runFrame({}, &video, nullptr);
+		if(inputScript)
+			inputScript->runEvents(*this, app, i);
+		auto frameStart = IG::steadyClockTimestamp();
+		runFrame({}, video, audio);
+		stats.add(IG::steadyClockTimestamp() - frameStart);
 	}
-	auto after = IG::steadyClockTimestamp();
-	return after-now;
+	return stats;
 }
 
 void EmuSystem::configFrameTime(int rate)
@@ -298,6 +306,7 @@ void EmuSystem::configAudioPlayback(EmuAudio &emuAudio, int rate)
 {
 	configFrameTime(rate);
 	emuAudio.setRate(rate);
+	emuAudio.setStereo(hasStereoSound);
 }
 
 int EmuSystem::updateAudioFramesPerVideoFrame()
@@ -364,73 +373,56 @@ bool EmuSystem::setFrameTime(VideoSystem system, IG::FloatSeconds time)
 	return FS::PathString{path};
 }
 
-void EmuSystem::closeAndSetupNew(IG::CStringView path, std::string_view displayName)
+void EmuSystem::closeAndSetupNew(EmuApp *app, IG::CStringView path, std::string_view displayName)
 {
-	auto &app = EmuApp::get(appContext());
-	closeRuntimeSystem(app, true);
+	if(app)
+		closeRuntimeSystem(*app, true);
+	else
+		clearGamePaths();
 	if(!IG::isUri(path))
 		setupContentFilePaths(path, displayName);
 	else
 		setupContentUriPaths(path, displayName);
 	logMsg("set content name:%s location:%s", contentName_.data(), contentLocation_.data());
-	app.loadSessionOptions();
+	if(app)
+		app->loadSessionOptions();
 }
 
-void EmuSystem::createWithMedia(IO io, IG::CStringView path, std::string_view displayName,
+void EmuSystem::createWithMedia(EmuApp *app, IO io, IG::CStringView path, std::string_view displayName,
 	EmuSystemCreateParams params, OnLoadProgressDelegate onLoadProgress)
 {
 	if(io)
-		loadContentFromFile(std::move(io), path, displayName, params, onLoadProgress);
+		loadContentFromFile(app, std::move(io), path, displayName, params, onLoadProgress);
 	else
-		loadContentFromPath(path, displayName, params, onLoadProgress);
+		loadContentFromPath(app, path, displayName, params, onLoadProgress);
 }
 
-void EmuSystem::loadContentFromPath(IG::CStringView pathStr, std::string_view displayName, EmuSystemCreateParams params, OnLoadProgressDelegate onLoadProgress)
+void EmuSystem::loadContentFromPath(EmuApp *app, IG::CStringView pathStr, std::string_view displayName, EmuSystemCreateParams params, OnLoadProgressDelegate onLoadProgress)
 {
 	auto path = willLoadContentFromPath(pathStr, displayName);
 	if(!handlesGenericIO)
 	{
-		closeAndSetupNew(path, displayName);
+		closeAndSetupNew(app, path, displayName);
 		IO nullIO{};
 		loadContent(nullIO, params, onLoadProgress);
 		return;
 	}
 	logMsg("load from %s:%s", IG::isUri(path) ? "uri" : "path", path.data());
-	loadContentFromFile(appContext().openFileUri(path, IOAccessHint::SEQUENTIAL), path, displayName, params, onLoadProgress);
+	loadContentFromFile(app, appContext().openFileUri(path, IOAccessHint::SEQUENTIAL), path, displayName, params, onLoadProgress);
 }
 
-void EmuSystem::loadContentFromFile(IO file, IG::CStringView path, std::string_view displayName, EmuSystemCreateParams params, OnLoadProgressDelegate onLoadProgress)
+void EmuSystem::loadContentFromFile(EmuApp *app, IO file, IG::CStringView path, std::string_view displayName, EmuSystemCreateParams params, OnLoadProgressDelegate onLoadProgress)
 {
 	if(EmuApp::hasArchiveExtension(displayName))
 	{
-		IO io{};
-		FS::FileString originalName{};
-		for(auto &entry : FS::ArchiveIterator{std::move(file)})
-		{
-			if(entry.type() == FS::file_type::directory)
-			{
-				continue;
-			}
-			auto name = entry.name();
-			logMsg("archive file entry:%s", name.data());
-			if(EmuSystem::defaultFsFilter(name))
-			{
-				originalName = name;
-				io = entry.moveIO();
-				break;
-			}
-		}
-		if(!io)
-		{
-			throw std::runtime_error("No recognized file extensions in archive");
-		}
-		closeAndSetupNew(path, displayName);
-		contentFileName_ = originalName;
-		loadContent(io, params, onLoadProgress);
+		auto content = ArchiveContentCache::open(appContext(), std::move(file), path, EmuSystem::defaultFsFilter);
+		closeAndSetupNew(app, path, displayName);
+		contentFileName_ = content.name;
+		loadContent(content.io, params, onLoadProgress);
 	}
 	else
 	{
-		closeAndSetupNew(path, displayName);
+		closeAndSetupNew(app, path, displayName);
 		loadContent(file, params, onLoadProgress);
 	}
 }
@@ -544,6 +536,10 @@ bool EmuSystem::updateBackupMemoryCounter()
 	return false;
 }
 
-EmuSystem &gSystem() { return gApp().system(); }
+static EmuSystem *gSystemPtr{};
+
+EmuSystem &gSystem() { return gSystemPtr ? *gSystemPtr : gApp().system(); }
+
+void setGlobalSystem(EmuSystem &sys) { gSystemPtr = &sys; }
 
 }
@@ -34,25 +34,25 @@ namespace EmuEx
 class ResetAlertView : public BaseAlertView, public EmuAppHelper<ResetAlertView>
 {
 public:
-	ResetAlertView(ViewAttachParams attach, IG::utf16String label, EmuSystem &sys):
+	ResetAlertView(ViewAttachParams attach, IG::utf16String label):
 		BaseAlertView{attach, std::move(label), items},
 		items
 		{
 			TextMenuItem
 			{
 				"Soft Reset", &defaultFace(),
-				[this, &sys]()
+				[this]()
 				{
-					sys.reset(app(), EmuSystem::ResetMode::SOFT);
+					app().resetSystem(EmuSystem::ResetMode::SOFT);
 					app().showEmulation();
 				}
 			},
 			TextMenuItem
 			{
 				"Hard Reset", &defaultFace(),
-				[this, &sys]()
+				[this]()
 				{
-					sys.reset(app(), EmuSystem::ResetMode::HARD);
+					app().resetSystem(EmuSystem::ResetMode::HARD);
 					app().showEmulation();
 				}
 			},
@@ -68,6 +68,11 @@ static auto makeStateSlotStr(EmuSystem &sys, int slot)
 	return fmt::format("State Slot ({})", sys.saveSlotChar(slot));
 }
 
+static const char *recordInputStr(EmuApp &app)
+{
+	return app.isRecordingInputMovie() ? "Stop Input Recording" : "Start Input Recording";
+}
+
 void EmuSystemActionsView::onShow()
 {
 	if(app().viewController().isShowingEmulation())
@@ -80,6 +85,8 @@ void EmuSystemActionsView::onShow()
 	loadState.setActive(system().hasContent() && system().stateExists(system().stateSlot()));
 	stateSlot.compile(makeStateSlotStr(system(), system().stateSlot()), renderer(), projP);
 	screenshot.setActive(system().hasContent());
+	recordInput.setActive(system().hasContent());
+	recordInput.compile(recordInputStr(app()), renderer(), projP);
 	doIfUsed(addLauncherIcon, [&](auto &mItem){ mItem.setActive(system().hasContent()); });
 	resetSessionOptions.setActive(app().hasSavedSessionOptions());
 	close.setActive(system().hasContent());
@@ -99,6 +106,8 @@ void EmuSystemActionsView::loadStandardItems()
 	if(used(addLauncherIcon))
 		item.emplace_back(&addLauncherIcon);
 	item.emplace_back(&screenshot);
+	recordInput.setName(recordInputStr(app()));
+	item.emplace_back(&recordInput);
 	item.emplace_back(&resetSessionOptions);
 	item.emplace_back(&close);
 }
@@ -125,7 +134,7 @@ EmuSystemActionsView::EmuSystemActionsView(ViewAttachParams attach, bool customM
 			{
 				if(EmuSystem::hasResetModes)
 				{
-					pushAndShowModal(makeView<ResetAlertView>("Really reset?", system()), e);
+					pushAndShowModal(makeView<ResetAlertView>("Really reset?"), e);
 				}
 				else
 				{
@@ -133,7 +142,7 @@ EmuSystemActionsView::EmuSystemActionsView(ViewAttachParams attach, bool customM
 					ynAlertView->setOnYes(
 						[this]()
 						{
-							system().reset(app(), EmuSystem::ResetMode::SOFT);
+							app().resetSystem(EmuSystem::ResetMode::SOFT);
 							app().showEmulation();
 						});
 					pushAndShowModal(std::move(ynAlertView), e);
@@ -246,6 +255,36 @@ EmuSystemActionsView::EmuSystemActionsView(ViewAttachParams attach, bool customM
 			pushAndShowModal(std::move(ynAlertView), e);
 		}
 	},
+	recordInput
+	{
+		{}, &defaultFace(),
+		[this](TextMenuItem &item, View &, const Input::Event &e)
+		{
+			if(!system().hasContent())
+				return;
+			if(app().isRecordingInputMovie())
+			{
+				app().stopInputMovieRecording();
+				item.compile(recordInputStr(app()), renderer(), projP);
+				return;
+			}
+			auto pathName = appContext().fileUriDisplayName(system().contentSaveDirectory());
+			if(pathName.empty())
+			{
+				app().postMessage("Save path isn't valid");
+				return;
+			}
+			auto ynAlertView = makeView<YesNoAlertView>(
+				fmt::format("Record input from now until stopped or a state is loaded and save it to folder {}?", pathName));
+			ynAlertView->setOnYes(
+				[this]()
+				{
+					if(app().startInputMovieRecording())
+						app().showEmulation();
+				});
+			pushAndShowModal(std::move(ynAlertView), e);
+		}
+	},
 	resetSessionOptions
 	{
 		"Reset Saved Options", &defaultFace(),
@@ -34,10 +34,10 @@ void EmuSystemTask::start()
 	taskThread = IG::makeThreadSync(
 		[this](auto &sem)
 		{
-			auto eventLoop = IG::EventLoop::makeForThread();
-			bool started = true;
-			commandPort.attach(eventLoop,
-				[this, &started](auto msgs)
+			sem.release();
+			logMsg("starting thread command loop");
+			commandPort.run(
+				[this](auto msgs)
 				{
 					for(auto msg : msgs)
 					{
@@ -48,8 +48,14 @@ void EmuSystemTask::start()
 								auto frames = msg.args.run.frames;
 								assumeExpr(frames);
 								//logMsg("running %d frame(s)", frames);
+								bool trackStats = app().framePacingStatsEnabled();
+								auto frameStart = trackStats ? IG::steadyClockTimestamp() : IG::Time{};
 								app().runFrames({this, msg.semPtr}, msg.args.run.video, msg.args.run.audio,
 									frames, msg.args.run.skipForward);
+								if(!msg.args.run.video && msg.semPtr)
+									msg.semPtr->release(); // no video frame will signal the waiting thread
+								if(trackStats) [[unlikely]]
+									app().framePacingStats().addEmuFrameTime((IG::steadyClockTimestamp() - frameStart) / frames);
 							}
 							bcase Command::PAUSE:
 							{
@@ -60,8 +66,6 @@ void EmuSystemTask::start()
 							bcase Command::EXIT:
 							{
 								//logMsg("got exit command");
-								started = false;
-								IG::EventLoop::forThread().stop();
 								return false;
 							}
 							bdefault:
@@ -72,11 +76,7 @@ void EmuSystemTask::start()
 					}
 					return true;
 				});
-			sem.release();
-			logMsg("starting thread event loop");
-			eventLoop.run(started);
 			logMsg("exiting thread");
-			commandPort.detach();
 		});
 }
 
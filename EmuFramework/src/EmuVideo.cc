@@ -16,10 +16,13 @@
 #define LOGTAG "EmuVideo"
 #include <emuframework/EmuVideo.hh>
 #include <emuframework/EmuApp.hh>
+#include <emuframework/Benchmark.hh>
 #include <imagine/gfx/Renderer.hh>
 #include <imagine/gfx/RendererTask.hh>
 #include <imagine/gfx/RendererCommands.hh>
+#include <imagine/util/math/int.hh>
 #include <imagine/logger/logger.h>
+#include <cstring>
 
 namespace EmuEx
 {
@@ -38,6 +41,8 @@ void EmuVideo::resetImage(IG::PixelFormat newFmt)
 
 IG::PixmapDesc EmuVideo::deleteImage()
 {
+	if(!rTask)
+		return std::exchange(memImg, {}).desc();
 	auto desc = vidImg.pixmapDesc();
 	vidImg = {};
 	return desc;
@@ -66,7 +71,11 @@ bool EmuVideo::setFormat(IG::PixmapDesc desc, EmuSystemTaskContext taskCtx)
 	{
 		return false; // no change to size/format
 	}
-	if(!vidImg)
+	if(!rTask)
+	{
+		memImg = {desc};
+	}
+	else if(!vidImg)
 	{
 		Gfx::TextureConfig conf{desc, samplerConfig()};
 		conf.colorSpace = colSpace;
@@ -90,7 +99,7 @@ bool EmuVideo::setFormat(IG::PixmapDesc desc, EmuSystemTaskContext taskCtx)
 
 void EmuVideo::dispatchFormatChanged()
 {
-	onFormatChanged(*this);
+	onFormatChanged.callSafe(*this);
 }
 
 void EmuVideo::syncImageAccess()
@@ -100,6 +109,8 @@ void EmuVideo::syncImageAccess()
 
 EmuVideoImage EmuVideo::startFrame(EmuSystemTaskContext taskCtx)
 {
+	if(!rTask)
+		return {taskCtx, *this, {nullptr, memImg.view(), {}, 0, false}};
 	auto lockedTex = vidImg.lock();
 	syncImageAccess();
 	return {taskCtx, *this, lockedTex};
@@ -165,7 +176,12 @@ void EmuVideo::finishFrame(EmuSystemTaskContext taskCtx, Gfx::LockedTextureBuffe
 	{
 		doScreenshot(taskCtx, texBuff.pixmap());
 	}
-	vidImg.unlock(texBuff);
+	if(thumbnailRequested) [[unlikely]]
+		writeThumbnail(texBuff.pixmap());
+	if(checksumsPtr) [[unlikely]]
+		checksumsPtr->addVideoFrame(texBuff.pixmap());
+	if(rTask)
+		vidImg.unlock(texBuff);
 	postFrameFinished(taskCtx);
 }
 
@@ -175,8 +191,15 @@ void EmuVideo::finishFrame(EmuSystemTaskContext taskCtx, IG::PixmapView pix)
 	{
 		doScreenshot(taskCtx, pix);
 	}
-	syncImageAccess();
-	vidImg.write(pix, vidImg.WRITE_FLAG_ASYNC);
+	if(thumbnailRequested) [[unlikely]]
+		writeThumbnail(pix);
+	if(checksumsPtr) [[unlikely]]
+		checksumsPtr->addVideoFrame(pix);
+	if(rTask)
+	{
+		syncImageAccess();
+		vidImg.write(pix, vidImg.WRITE_FLAG_ASYNC);
+	}
 	postFrameFinished(taskCtx);
 }
 
@@ -229,6 +252,49 @@ void EmuVideo::doScreenshot(EmuSystemTaskContext taskCtx, IG::PixmapView pix)
 	}
 }
 
+template <class Src>
+static void sampleThumbnail(uint16_t *dest, IG::PixmapView pix, IG::WP size, int step, auto &&toRGB565)
+{
+	for(auto y : iotaCount(size.y))
+	{
+		auto srcLine = (const char*)pix.data() + y * step * pix.pitchBytes();
+		for(auto x : iotaCount(size.x))
+		{
+			Src p;
+			memcpy(&p, srcLine + x * step * sizeof(Src), sizeof(Src));
+			*dest++ = toRGB565(p);
+		}
+	}
+}
+
+IG::PixmapView EmuVideo::captureThumbnail(EmuSystem &sys)
+{
+	// have the system render its last frame again so it's captured in finishFrame(),
+	// systems that can't do that get no thumbnail
+	thumbnailSize = {};
+	if(!vidImg)
+		return {};
+	thumbnailRequested = true;
+	sys.renderFramebuffer(*this);
+	thumbnailRequested = false;
+	return {{thumbnailSize, IG::PIXEL_RGB565}, thumbnailData.data()};
+}
+
+void EmuVideo::writeThumbnail(IG::PixmapView pix)
+{
+	// nearest neighbor samples of the frame for save state previews
+	int step = std::max(divRoundUp(std::max(pix.w(), pix.h()), thumbnailMaxSize), 1);
+	thumbnailSize = {pix.w() / step, pix.h() / step};
+	auto dest = thumbnailData.data();
+	switch(pix.format().id())
+	{
+		case IG::PIXEL_RGB565: return sampleThumbnail<uint16_t>(dest, pix, thumbnailSize, step, [](uint16_t p){ return p; });
+		case IG::PIXEL_RGBA8888: return sampleThumbnail<uint32_t>(dest, pix, thumbnailSize, step, IG::transformRGBX8888ToRGB565);
+		case IG::PIXEL_BGRA8888: return sampleThumbnail<uint32_t>(dest, pix, thumbnailSize, step, IG::transformBGRX8888ToRGB565);
+		default: thumbnailSize = {};
+	}
+}
+
 bool EmuVideo::isExternalTexture() const
 {
 	if constexpr(Config::envIsAndroid)
@@ -273,6 +339,8 @@ void EmuVideoImage::endFrame()
 
 IG::WP EmuVideo::size() const
 {
+	if(!rTask)
+		return memImg ? memImg.desc().size() : IG::WP{1, 1};
 	if(!vidImg)
 		return {1, 1};
 	else
@@ -281,6 +349,8 @@ IG::WP EmuVideo::size() const
 
 bool EmuVideo::formatIsEqual(IG::PixmapDesc desc) const
 {
+	if(!rTask)
+		return memImg && desc == memImg.desc();
 	return vidImg && desc == vidImg.pixmapDesc();
 }
 
@@ -353,8 +423,8 @@ bool EmuVideo::setRenderPixelFormat(EmuSystem &sys, IG::PixelFormat fmt, Gfx::Co
 		}
 	}
 	assert(fmt);
-	assert(bufferMode != Gfx::TextureBufferMode::DEFAULT);
-	if(fmt == IG::PIXEL_RGBA8888 && renderer().hasBgraFormat(bufferMode))
+	assert(!rTask || bufferMode != Gfx::TextureBufferMode::DEFAULT);
+	if(fmt == IG::PIXEL_RGBA8888 && rTask && renderer().hasBgraFormat(bufferMode))
 		fmt = IG::PIXEL_BGRA8888;
 	if(renderFmt == fmt)
 		return false;
@@ -365,7 +435,8 @@ bool EmuVideo::setRenderPixelFormat(EmuSystem &sys, IG::PixelFormat fmt, Gfx::Co
 	{
 		setFormat({oldPixDesc.size(), fmt});
 	}
-	app().renderSystemFramebuffer(*this);
+	if(rTask)
+		app().renderSystemFramebuffer(*this);
 	return true;
 }
 
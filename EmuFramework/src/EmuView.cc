@@ -28,13 +28,13 @@ EmuView::EmuView(ViewAttachParams attach, EmuVideoLayer *layer, EmuSystem &sys):
 	View{attach},
 	layer{layer},
 	sysPtr{&sys}
-{}
+{
+	statsText.setFace(&defaultFace());
+}
 
 void EmuView::prepareDraw()
 {
-	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-	audioStatsText.makeGlyphs(renderer());
-	#endif
+	statsText.makeGlyphs(renderer());
 }
 
 void EmuView::draw(Gfx::RendererCommands &__restrict__ cmds)
@@ -44,19 +44,18 @@ void EmuView::draw(Gfx::RendererCommands &__restrict__ cmds)
 	{
 		layer->draw(cmds, projP);
 	}
-	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-	if(audioStatsText.isVisible())
+	if(statsText.isVisible())
 	{
-		cmds.setCommonProgram(CommonProgram::NO_TEX);
-		cmds.setBlendMode(BLEND_MODE_ALPHA);
+		auto &basicEffect = cmds.basicEffect();
+		basicEffect.disableTexture(cmds);
+		cmds.set(BlendMode::ALPHA);
 		cmds.setColor(0., 0., 0., .7);
-		GeomRect::draw(cmds, audioStatsRect);
+		GeomRect::draw(cmds, statsRect);
 		cmds.setColor(1., 1., 1., 1.);
-		cmds.setCommonProgram(CommonProgram::TEX_ALPHA);
-		audioStatsText.draw(cmds, projP.alignXToPixel(audioStatsRect.x + TableView::globalXIndent),
-			projP.alignYToPixel(audioStatsRect.yCenter()), LC2DO, projP);
+		basicEffect.enableAlphaTexture(cmds);
+		statsText.draw(cmds, projP.alignXToPixel(statsRect.x + statsText.spaceWidth()),
+			projP.alignYToPixel(statsRect.yCenter()), LC2DO, projP);
 	}
-	#endif
 }
 
 void EmuView::place()
@@ -65,14 +64,13 @@ void EmuView::place()
 	{
 		layer->place(viewRect(), displayRect(), projP, inputView, system());
 	}
-	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-	if(audioStatsText.compile(renderer(), projP))
+	if(statsText.compile(renderer(), projP))
 	{
-		audioStatsRect = projP.bounds();
-		audioStatsRect.y2 = (audioStatsRect.y + audioStatsText.nominalHeight * audioStatsText.lines)
-			+ audioStatsText.nominalHeight * .5f; // adjust to bottom
+		statsRect = projP.bounds();
+		statsRect.x2 = statsRect.x + statsText.width() + statsText.spaceWidth() * 2.f;
+		statsRect.y2 = (statsRect.y + statsText.nominalHeight() * statsText.currentLines())
+			+ statsText.nominalHeight() * .5f; // adjust to bottom
 	}
-	#endif
 }
 
 bool EmuView::inputEvent(const Input::Event &e)
@@ -85,20 +83,21 @@ void EmuView::setLayoutInputView(EmuInputView *view)
 	inputView = view;
 }
 
-void EmuView::updateAudioStats(int underruns, int overruns, int callbacks, double avgCallbackFrames, int frames)
+void EmuView::updateStats(IG::utf16String str)
 {
-	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-	audioStatsText.setString(fmt::format("Underruns:{}\nOverruns:{}\nCallbacks per second:{}\nFrames per callback:{:.2f}\nTotal frames:{}",
-		underruns, overruns, callbacks, avgCallbackFrames, frames), &View::defaultFace);
+	waitForDrawFinished();
+	statsText.setString(std::move(str));
 	place();
-	#endif
+	postDraw();
 }
 
-void EmuView::clearAudioStats()
+void EmuView::clearStats()
 {
-	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-	audioStatsText.setString(nullptr);
-	#endif
+	if(!statsText.stringSize())
+		return;
+	waitForDrawFinished();
+	statsText.setString({});
+	postDraw();
 }
 
 }
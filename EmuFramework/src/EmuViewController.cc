@@ -330,14 +330,14 @@ void EmuViewController::updateExtraWindowViewport(IG::Window &win, IG::Viewport
 	emuView.place();
 }
 
-void EmuViewController::updateEmuAudioStats(int underruns, int overruns, int callbacks, double avgCallbackFrames, int frames)
+void EmuViewController::updateEmuStats(IG::utf16String str)
 {
-	emuView.updateAudioStats(underruns, overruns, callbacks, avgCallbackFrames, frames);
+	emuView.updateStats(std::move(str));
 }
 
-void EmuViewController::clearEmuAudioStats()
+void EmuViewController::clearEmuStats()
 {
-	emuView.clearAudioStats();
+	emuView.clearStats();
 }
 
 void EmuViewController::popToSystemActionsMenu()
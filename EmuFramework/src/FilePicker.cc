@@ -80,7 +80,7 @@ std::unique_ptr<EmuFilePicker> EmuFilePicker::makeForBenchmarking(ViewAttachPara
 			app.createSystemWithMedia({}, path, displayName, e, {}, picker.attachParams(),
 				[&app](const Input::Event &)
 				{
-					app.runBenchmarkOneShot(app.video());
+					app.runBenchmarkOneShot({});
 				});
 		});
 	return picker;
@@ -0,0 +1,122 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+
+#include <emuframework/FramePacingStats.hh>
+#include <emuframework/EmuAudio.hh>
+#include <imagine/util/format.hh>
+
+namespace EmuEx
+{
+
+static void addTime(std::atomic<int64_t> &sum, std::atomic<int64_t> &max, IG::Time t)
+{
+	auto nsecs = t.count();
+	sum.fetch_add(nsecs, std::memory_order_relaxed);
+	auto prevMax = max.load(std::memory_order_relaxed);
+	while(nsecs > prevMax && !max.compare_exchange_weak(prevMax, nsecs, std::memory_order_relaxed)) {}
+}
+
+static double toMSecs(int64_t nsecs) { return nsecs / 1.e6; }
+
+void FramePacingStats::reset()
+{
+	hostFrames = emuFrames = skippedFrames = repeatedFrames = missedVsyncs = 0;
+	emuFrameSamples = rendererWaitSamples = 0;
+	emuFrameNSecs = maxEmuFrameNSecs = rendererWaitNSecs = maxRendererWaitNSecs = 0;
+	audioUnderruns = audioOverruns = 0;
+	lastHostTimestamp = {};
+	lastCollectTime = IG::steadyClockTimestamp();
+}
+
+void FramePacingStats::addHostFrame(IG::FrameParams params, int emuFrames_)
+{
+	hostFrames.fetch_add(1, std::memory_order_relaxed);
+	if(lastHostTimestamp.count())
+		missedVsyncs.fetch_add(params.elapsedFrames(lastHostTimestamp) - 1, std::memory_order_relaxed);
+	lastHostTimestamp = params.timestamp();
+	if(!emuFrames_)
+		repeatedFrames.fetch_add(1, std::memory_order_relaxed);
+	else
+		skippedFrames.fetch_add(emuFrames_ - 1, std::memory_order_relaxed);
+	emuFrames.fetch_add(emuFrames_, std::memory_order_relaxed);
+}
+
+void FramePacingStats::addEmuFrameTime(IG::Time t)
+{
+	emuFrameSamples.fetch_add(1, std::memory_order_relaxed);
+	addTime(emuFrameNSecs, maxEmuFrameNSecs, t);
+}
+
+void FramePacingStats::addRendererWaitTime(IG::Time t)
+{
+	rendererWaitSamples.fetch_add(1, std::memory_order_relaxed);
+	addTime(rendererWaitNSecs, maxRendererWaitNSecs, t);
+}
+
+FramePacingReport FramePacingStats::collect(const EmuAudio &audio)
+{
+	auto now = IG::steadyClockTimestamp();
+	auto emuSamples = std::max(emuFrameSamples.exchange(0), 1u);
+	auto waitSamples = std::max(rendererWaitSamples.exchange(0), 1u);
+	FramePacingReport report
+	{
+		.seconds = IG::FloatSeconds{now - lastCollectTime}.count(),
+		.hostFrames = hostFrames.exchange(0),
+		.emuFrames = emuFrames.exchange(0),
+		.skippedFrames = skippedFrames.exchange(0),
+		.repeatedFrames = repeatedFrames.exchange(0),
+		.missedVsyncs = missedVsyncs.exchange(0),
+		.avgEmuFrameMSecs = toMSecs(emuFrameNSecs.exchange(0) / emuSamples),
+		.maxEmuFrameMSecs = toMSecs(maxEmuFrameNSecs.exchange(0)),
+		.avgRendererWaitMSecs = toMSecs(rendererWaitNSecs.exchange(0) / waitSamples),
+		.maxRendererWaitMSecs = toMSecs(maxRendererWaitNSecs.exchange(0)),
+		.audioUnderruns = audioUnderruns.exchange(0),
+		.audioOverruns = audioOverruns.exchange(0),
+		.audioFramesBuffered = audio ? audio.framesWritten() : 0,
+		.audioFramesCapacity = audio ? audio.framesCapacity() : 0,
+	};
+	lastCollectTime = now;
+	return report;
+}
+
+std::string FramePacingReport::overlayString() const
+{
+	auto emuPerHost = hostFrames ? double(emuFrames) / hostFrames : 0.;
+	return fmt::format("Host frames:{} Emu/host:{:.2f}\n"
+		"Skipped:{} Repeated:{} Missed vsyncs:{}\n"
+		"Emu frame:{:.2f}ms (max {:.2f}ms)\n"
+		"Renderer wait:{:.2f}ms (max {:.2f}ms)\n"
+		"Audio buffer:{}/{} Underruns:{} Overruns:{}",
+		hostFrames, emuPerHost,
+		skippedFrames, repeatedFrames, missedVsyncs,
+		avgEmuFrameMSecs, maxEmuFrameMSecs,
+		avgRendererWaitMSecs, maxRendererWaitMSecs,
+		audioFramesBuffered, audioFramesCapacity, audioUnderruns, audioOverruns);
+}
+
+std::string FramePacingReport::json() const
+{
+	return fmt::format("{{\"seconds\":{:.3f},\"hostFrames\":{},\"emuFrames\":{},\"skippedFrames\":{},"
+		"\"repeatedFrames\":{},\"missedVsyncs\":{},\"emuFrameMSecs\":{{\"avg\":{:.3f},\"max\":{:.3f}}},"
+		"\"rendererWaitMSecs\":{{\"avg\":{:.3f},\"max\":{:.3f}}},"
+		"\"audio\":{{\"framesBuffered\":{},\"framesCapacity\":{},\"underruns\":{},\"overruns\":{}}}}}",
+		seconds, hostFrames, emuFrames, skippedFrames,
+		repeatedFrames, missedVsyncs, avgEmuFrameMSecs, maxEmuFrameMSecs,
+		avgRendererWaitMSecs, maxRendererWaitMSecs,
+		audioFramesBuffered, audioFramesCapacity, audioUnderruns, audioOverruns);
+}
+
+}
@@ -0,0 +1,79 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "InputActionQueue"
+#include <emuframework/InputActionQueue.hh>
+#include <emuframework/EmuApp.hh>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+
+namespace EmuEx
+{
+
+bool InputActionQueue::push(InputAction action)
+{
+	return port.trySend({action, IG::steadyClockTimestamp()});
+}
+
+void InputActionQueue::beginFrames(int frames, IG::FloatSeconds frameTime_)
+{
+	runStartTime = IG::steadyClockTimestamp();
+	frameTime = std::chrono::duration_cast<IG::Time>(frameTime_);
+	framesLeft = frames;
+	// apply anything left from the previous run first, then whatever arrived since
+	std::move(actions.begin() + nextAction, actions.begin() + actionCount, actions.begin());
+	actionCount -= nextAction;
+	nextAction = 0;
+	// only take messages there's room for, the rest stay in the port until the next run
+	while(actionCount < actions.size() && port.tryReceive(actions[actionCount]))
+	{
+		actionCount++;
+	}
+}
+
+void InputActionQueue::runFrameActions(EmuApp &app)
+{
+	framesLeft = std::max(framesLeft - 1, 0);
+	// the last frame of a run gets everything queued up to when the run started
+	auto frameEnd = runStartTime - frameTime * framesLeft;
+	auto frameStart = frameEnd - frameTime;
+	while(nextAction < actionCount && (!framesLeft || actions[nextAction].time <= frameEnd))
+	{
+		auto [action, time] = actions[nextAction++];
+		if(frameTime.count() > 0)
+		{
+			auto offset = std::clamp(time - frameStart, IG::Time{}, frameTime);
+			action.frameOffset = offset.count() * InputAction::frameOffsetMax / frameTime.count();
+		}
+		app.applyInputAction(action);
+	}
+}
+
+// Only call while the emulation thread isn't running frames
+void InputActionQueue::flush(EmuApp &app)
+{
+	while(nextAction < actionCount)
+	{
+		app.applyInputAction(actions[nextAction++].action);
+	}
+	actionCount = nextAction = 0;
+	framesLeft = 0;
+	for(auto a : port.messages())
+	{
+		app.applyInputAction(a.action);
+	}
+}
+
+}
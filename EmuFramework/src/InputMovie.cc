@@ -0,0 +1,146 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "InputMovie"
+#include <emuframework/InputMovie.hh>
+#include <emuframework/SaveStateFile.hh>
+#include <emuframework/EmuApp.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/util/format.hh>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+namespace EmuEx
+{
+
+static_assert(std::is_trivially_copyable_v<InputMovie::Header> && std::is_trivially_copyable_v<InputMovie::Event>);
+
+void InputMovie::startRecording(EmuSystem &sys)
+{
+	auto stateSize = sys.stateSize();
+	if(!stateSize)
+		throw std::runtime_error{"Input recording isn't supported by this system"};
+	startState.resize(stateSize);
+	startState.resize(sys.writeState(startState));
+	eventLog.clear();
+	frameCount = 0;
+	playing = false;
+	recording = true;
+	logMsg("started recording from %zu byte state", startState.size());
+}
+
+void InputMovie::stopRecording()
+{
+	if(!recording)
+		return;
+	recording = false;
+	logMsg("stopped recording after %u frames with %zu events", frameCount, eventLog.size());
+}
+
+void InputMovie::record(InputAction a)
+{
+	eventLog.emplace_back(Event{frameCount, a.key, a.metaState, a.state, EventType::ACTION, a.frameOffset});
+}
+
+void InputMovie::recordClearInput()
+{
+	if(!recording)
+		return;
+	eventLog.emplace_back(Event{.frame = frameCount, .type = EventType::CLEAR_INPUT});
+}
+
+void InputMovie::recordReset(EmuSystem::ResetMode mode)
+{
+	if(!recording)
+		return;
+	eventLog.emplace_back(Event{.frame = frameCount, .key = uint32_t(mode), .type = EventType::RESET});
+}
+
+void InputMovie::startPlayback(EmuApp &app)
+{
+	if(startState.empty())
+		throw std::runtime_error{"No input recording loaded"};
+	app.system().readState(app, startState);
+	app.system().clearInputBuffers(app.viewController().inputView());
+	recording = false;
+	playing = frameCount > 0;
+	playFrameIdx = 0;
+	nextEvent = 0;
+}
+
+void InputMovie::playFrame(EmuApp &app)
+{
+	auto &sys = app.system();
+	for(; nextEvent < eventLog.size() && eventLog[nextEvent].frame <= playFrameIdx; nextEvent++)
+	{
+		auto &e = eventLog[nextEvent];
+		switch(e.type)
+		{
+			case EventType::ACTION:
+				sys.handleInputAction(&app, {e.key, e.action, e.metaState, e.frameOffset});
+				break;
+			case EventType::CLEAR_INPUT:
+				sys.clearInputBuffers(app.viewController().inputView());
+				break;
+			case EventType::RESET:
+				sys.reset(app, EmuSystem::ResetMode(e.key));
+				break;
+		}
+	}
+	if(++playFrameIdx == frameCount)
+		playing = false;
+}
+
+void InputMovie::save(IG::ApplicationContext ctx, IG::CStringView path) const
+{
+	std::vector<uint8_t> stateFile;
+	SaveStateFile::write(stateFile, {}, {}, startState);
+	Header header{.stateFileSize = stateFile.size(), .frames = frameCount, .events = uint32_t(eventLog.size())};
+	std::vector<uint8_t> fileData(sizeof(Header) + stateFile.size() + eventLog.size() * sizeof(Event));
+	memcpy(fileData.data(), &header, sizeof(Header));
+	std::ranges::copy(stateFile, fileData.begin() + sizeof(Header));
+	memcpy(fileData.data() + sizeof(Header) + stateFile.size(), eventLog.data(), eventLog.size() * sizeof(Event));
+	if(IG::FileUtils::writeToUri(ctx, path, fileData) == -1)
+		throw std::runtime_error{fmt::format("Can't write input recording:{}", path)};
+	logMsg("wrote %zu byte input recording:%s", fileData.size(), path.data());
+}
+
+void InputMovie::load(IG::ApplicationContext ctx, IG::CStringView path)
+{
+	auto buff = ctx.openFileUri(path, IOAccessHint::ALL).buffer(IOBufferMode::RELEASE);
+	std::span<const uint8_t> fileData{buff.data(), buff.size()};
+	if(fileData.size() < sizeof(Header))
+		throw std::runtime_error{fmt::format("Invalid input recording:{}", path)};
+	Header header;
+	memcpy(&header, fileData.data(), sizeof(Header));
+	if(header.magic != Header::magicValue || header.headerSize < sizeof(Header) || header.headerSize > fileData.size())
+		throw std::runtime_error{fmt::format("Invalid input recording:{}", path)};
+	auto data = fileData.subspan(header.headerSize);
+	if(header.stateFileSize > data.size() ||
+		header.events > (data.size() - header.stateFileSize) / sizeof(Event))
+		throw std::runtime_error{fmt::format("Input recording is truncated:{}", path)};
+	auto stateFile = data.first(header.stateFileSize);
+	SaveStateFile::readPayload(stateFile, SaveStateFile::readHeader(stateFile), startState);
+	eventLog.resize(header.events);
+	memcpy(eventLog.data(), data.data() + header.stateFileSize, header.events * sizeof(Event));
+	frameCount = header.frames;
+	recording = playing = false;
+	logMsg("read input recording with %u frames & %zu events:%s", frameCount, eventLog.size(), path.data());
+}
+
+}
@@ -0,0 +1,279 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "Rewind"
+#include <emuframework/Rewind.hh>
+#include <emuframework/EmuApp.hh>
+#include <emuframework/EmuSystem.hh>
+#include <imagine/util/math/int.hh>
+#include <imagine/logger/logger.h>
+#include <cstring>
+
+namespace EmuEx
+{
+
+// Delta format: a sequence of [varint unchanged words][varint changed words][changed words...]
+// where each word is 8 bytes of the XOR between the two snapshots
+
+using Word = uint64_t;
+
+static Word loadWord(const uint8_t *p)
+{
+	Word w;
+	memcpy(&w, p, sizeof(w));
+	return w;
+}
+
+static void storeWord(uint8_t *p, Word w)
+{
+	memcpy(p, &w, sizeof(w));
+}
+
+static uint8_t *writeVarint(uint8_t *out, size_t val)
+{
+	while(val >= 0x80)
+	{
+		*out++ = uint8_t(val | 0x80);
+		val >>= 7;
+	}
+	*out++ = uint8_t(val);
+	return out;
+}
+
+static const uint8_t *readVarint(const uint8_t *in, const uint8_t *end, size_t &val)
+{
+	val = 0;
+	for(int shift = 0; in != end; shift += 7)
+	{
+		auto byte = *in++;
+		val |= size_t(byte & 0x7F) << shift;
+		if(!(byte & 0x80))
+			break;
+	}
+	return in;
+}
+
+static size_t stateBufferSize(size_t stateSize)
+{
+	return RewindManager::stateHeaderSize + IG::alignRoundedUp(stateSize, sizeof(Word));
+}
+
+size_t RewindManager::encodeDeltaBound(size_t size)
+{
+	// worst case is alternating changed/unchanged words, needing 2 varints for every 2 words
+	auto words = size / sizeof(Word);
+	return size + (words / 2 + 1) * 2 * 10;
+}
+
+size_t RewindManager::encodeDelta(std::span<const uint8_t> newer, std::span<const uint8_t> older, uint8_t *out)
+{
+	assumeExpr(newer.size() == older.size());
+	assumeExpr(newer.size() % sizeof(Word) == 0);
+	auto outStart = out;
+	auto words = newer.size() / sizeof(Word);
+	auto newPtr = newer.data();
+	auto oldPtr = older.data();
+	size_t i = 0;
+	while(i < words)
+	{
+		size_t sameWords = 0;
+		while(i < words && loadWord(&newPtr[i * sizeof(Word)]) == loadWord(&oldPtr[i * sizeof(Word)]))
+		{
+			sameWords++;
+			i++;
+		}
+		if(i == words)
+			break;
+		auto changedStart = i;
+		while(i < words && loadWord(&newPtr[i * sizeof(Word)]) != loadWord(&oldPtr[i * sizeof(Word)]))
+		{
+			i++;
+		}
+		auto changedWords = i - changedStart;
+		out = writeVarint(out, sameWords);
+		out = writeVarint(out, changedWords);
+		for(auto w : iotaCount(changedWords))
+		{
+			auto offset = (changedStart + w) * sizeof(Word);
+			storeWord(out, loadWord(&newPtr[offset]) ^ loadWord(&oldPtr[offset]));
+			out += sizeof(Word);
+		}
+	}
+	return out - outStart;
+}
+
+void RewindManager::applyDelta(std::span<uint8_t> state, std::span<const uint8_t> delta)
+{
+	auto in = delta.data();
+	auto inEnd = in + delta.size();
+	auto words = state.size() / sizeof(Word);
+	size_t i = 0;
+	while(in < inEnd)
+	{
+		size_t sameWords, changedWords;
+		in = readVarint(in, inEnd, sameWords);
+		in = readVarint(in, inEnd, changedWords);
+		i += sameWords;
+		if(i + changedWords > words || size_t(inEnd - in) < changedWords * sizeof(Word)) [[unlikely]]
+		{
+			logErr("corrupt delta at word:%zu", i);
+			return;
+		}
+		for(auto w : iotaCount(changedWords))
+		{
+			auto p = &state[(i + w) * sizeof(Word)];
+			storeWord(p, loadWord(p) ^ loadWord(in));
+			in += sizeof(Word);
+		}
+		i += changedWords;
+	}
+}
+
+void RewindManager::reset(EmuSystem &sys, size_t bufferBytes)
+{
+	rewinding = false;
+	auto stateSize = bufferBytes ? sys.snapshotSize() : 0;
+	if(!stateSize)
+	{
+		deinit();
+		return;
+	}
+	auto buffSize = stateBufferSize(stateSize);
+	if(encodeDeltaBound(buffSize) + entryOverhead > bufferBytes)
+	{
+		logWarn("buffer size:%zu too small for state size:%zu", bufferBytes, stateSize);
+		deinit();
+		return;
+	}
+	if(bufferBytes != ringBuff.capacity())
+		ringBuff = IG::RingBuffer{bufferBytes};
+	stateBuff.resize(buffSize);
+	tempStateBuff.resize(buffSize);
+	logMsg("using %zu byte buffer for %zu byte states", ringBuff.capacity(), stateSize);
+	clear();
+}
+
+void RewindManager::deinit()
+{
+	ringBuff = {};
+	stateBuff = {};
+	tempStateBuff = {};
+	clear();
+}
+
+void RewindManager::clear()
+{
+	ringBuff.clear();
+	stateCount = 0;
+	framesUntilSave = 0;
+	hasSnapshot = false;
+	rewinding = false;
+}
+
+static size_t writeSnapshot(EmuSystem &sys, IG::VMemArray<uint8_t> &buff)
+{
+	std::span<uint8_t> stateData{buff.data() + RewindManager::stateHeaderSize, buff.size() - RewindManager::stateHeaderSize};
+	uint64_t size = sys.writeSnapshot(stateData);
+	assumeExpr(size <= stateData.size());
+	// keep padding bytes deterministic so they never show up in the delta
+	std::fill(stateData.begin() + size, stateData.end(), 0);
+	memcpy(buff.data(), &size, sizeof(size));
+	return size;
+}
+
+bool RewindManager::saveSnapshot(EmuSystem &sys)
+{
+	if(!hasSnapshot)
+	{
+		writeSnapshot(sys, stateBuff);
+		hasSnapshot = true;
+		return true;
+	}
+	writeSnapshot(sys, tempStateBuff);
+	auto maxEntrySize = encodeDeltaBound(stateBuff.size()) + entryOverhead;
+	while(ringBuff.freeSpace() < maxEntrySize)
+	{
+		dropOldestEntry();
+	}
+	auto entryPtr = (uint8_t*)ringBuff.writeAddr();
+	uint32_t deltaSize = encodeDelta({tempStateBuff.data(), tempStateBuff.size()}, {stateBuff.data(), stateBuff.size()},
+		entryPtr + sizeof(uint32_t));
+	memcpy(entryPtr, &deltaSize, sizeof(deltaSize));
+	memcpy(entryPtr + sizeof(uint32_t) + deltaSize, &deltaSize, sizeof(deltaSize));
+	ringBuff.commitWrite(deltaSize + entryOverhead);
+	std::swap(stateBuff, tempStateBuff);
+	stateCount++;
+	return true;
+}
+
+void RewindManager::dropOldestEntry()
+{
+	assumeExpr(stateCount);
+	uint32_t deltaSize;
+	memcpy(&deltaSize, ringBuff.readAddr(), sizeof(deltaSize));
+	ringBuff.commitRead(deltaSize + entryOverhead);
+	stateCount--;
+}
+
+void RewindManager::onFramesCompleted(EmuSystem &sys, int frames)
+{
+	if(!isEnabled())
+		return;
+	framesUntilSave -= frames;
+	if(framesUntilSave > 0)
+		return;
+	framesUntilSave = frameInterval_;
+	try
+	{
+		saveSnapshot(sys);
+	}
+	catch(std::exception &err)
+	{
+		logErr("error saving snapshot:%s, disabling rewind", err.what());
+		deinit();
+	}
+}
+
+bool RewindManager::rewindState(EmuApp &app)
+{
+	if(!hasSnapshot)
+		return false;
+	if(stateCount)
+	{
+		// ring buffer memory is mirrored so the newest entry is always contiguous from the end of the used space
+		auto entryEnd = (const uint8_t*)ringBuff.readAddr() + ringBuff.size();
+		uint32_t deltaSize;
+		memcpy(&deltaSize, entryEnd - sizeof(uint32_t), sizeof(deltaSize));
+		applyDelta({stateBuff.data(), stateBuff.size()}, {entryEnd - sizeof(uint32_t) - deltaSize, deltaSize});
+		ringBuff.uncommitWrite(deltaSize + entryOverhead);
+		stateCount--;
+	}
+	uint64_t size;
+	memcpy(&size, stateBuff.data(), sizeof(size));
+	try
+	{
+		app.system().readSnapshot(app, {stateBuff.data() + stateHeaderSize, size_t(size)});
+	}
+	catch(std::exception &err)
+	{
+		logErr("error loading snapshot:%s, disabling rewind", err.what());
+		deinit();
+		return false;
+	}
+	framesUntilSave = frameInterval_;
+	return stateCount;
+}
+
+}
@@ -0,0 +1,80 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+
+#define LOGTAG "RunAhead"
+#include <emuframework/RunAhead.hh>
+#include <emuframework/EmuApp.hh>
+#include <emuframework/EmuSystem.hh>
+#include <imagine/logger/logger.h>
+
+namespace EmuEx
+{
+
+void RunAheadManager::reset(EmuSystem &sys, int frames)
+{
+	auto stateSize = frames ? sys.snapshotSize() : 0;
+	if(!stateSize)
+	{
+		deinit();
+		return;
+	}
+	if(stateSize != stateBuff.size())
+		stateBuff.resize(stateSize);
+	frames_ = frames;
+	logMsg("running %d frame(s) ahead with %zu byte states", frames_, stateSize);
+}
+
+void RunAheadManager::deinit()
+{
+	stateBuff = {};
+	frames_ = 0;
+}
+
+void RunAheadManager::runFrame(EmuApp &app, EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *audio)
+{
+	auto &sys = app.system();
+	// the real frame, only this one produces audio
+	sys.runFrame(taskCtx, nullptr, audio);
+	size_t size;
+	try
+	{
+		size = sys.writeSnapshot({stateBuff.data(), stateBuff.size()});
+	}
+	catch(std::exception &err)
+	{
+		logErr("error saving state:%s, disabling run-ahead", err.what());
+		deinit();
+		// still present a frame so the caller isn't left waiting on the video
+		sys.runFrame(taskCtx, video, nullptr);
+		return;
+	}
+	for([[maybe_unused]] auto i : iotaCount(frames_ - 1))
+	{
+		sys.runFrame(taskCtx, nullptr, nullptr);
+	}
+	sys.runFrame(taskCtx, video, nullptr);
+	try
+	{
+		sys.readSnapshot(app, {stateBuff.data(), size});
+	}
+	catch(std::exception &err)
+	{
+		logErr("error restoring state:%s, disabling run-ahead", err.what());
+		deinit();
+	}
+}
+
+}
@@ -0,0 +1,105 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "SaveStateFile"
+#include <emuframework/SaveStateFile.hh>
+#include <imagine/logger/logger.h>
+#include <zlib.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace EmuEx
+{
+
+bool SaveStateFile::isStateFile(std::span<const uint8_t> headerData)
+{
+	return headerData.size() >= sizeof(Header::magicValue) &&
+		std::equal(Header::magicValue.begin(), Header::magicValue.end(), headerData.begin());
+}
+
+SaveStateFile::Header SaveStateFile::readHeader(std::span<const uint8_t> fileData)
+{
+	if(!isStateFile(fileData) || fileData.size() < offsetof(Header, stateSize))
+		throw std::runtime_error{"Invalid state file header"};
+	Header header{};
+	uint32_t headerSize;
+	memcpy(&headerSize, fileData.data() + offsetof(Header, headerSize), sizeof(headerSize));
+	if(headerSize < offsetof(Header, stateSize) || headerSize > fileData.size())
+		throw std::runtime_error{"Invalid state file header"};
+	memcpy(&header, fileData.data(), std::min(size_t(headerSize), sizeof(Header)));
+	if(header.version < 2)
+		header.stateSize = header.payloadSize;
+	if(header.thumbnailBytes() > fileData.size() - headerSize ||
+		header.payloadSize > fileData.size() - headerSize - header.thumbnailBytes())
+		throw std::runtime_error{"State file is truncated"};
+	return header;
+}
+
+IG::PixmapView SaveStateFile::thumbnail(std::span<const uint8_t> fileData, const Header &header)
+{
+	if(!header.thumbnailBytes())
+		return {};
+	return {{{header.thumbnailWidth, header.thumbnailHeight}, IG::PIXEL_RGB565}, fileData.data() + header.headerSize};
+}
+
+void SaveStateFile::readPayload(std::span<const uint8_t> fileData, const Header &header, std::vector<uint8_t> &out)
+{
+	auto payload = fileData.subspan(header.headerSize + header.thumbnailBytes(), header.payloadSize);
+	switch(header.compression)
+	{
+		case Compression::NONE:
+			out.assign(payload.begin(), payload.end());
+			return;
+		case Compression::DEFLATE:
+		{
+			out.resize(header.stateSize);
+			uLongf size = out.size();
+			if(uncompress(out.data(), &size, payload.data(), payload.size()) != Z_OK || size != out.size())
+				throw std::runtime_error{"Error decompressing state data"};
+			return;
+		}
+	}
+	throw std::runtime_error{"Unknown state data compression"};
+}
+
+void SaveStateFile::write(std::vector<uint8_t> &out, Header header, IG::PixmapView thumbnail, std::span<const uint8_t> state)
+{
+	header.stateSize = state.size();
+	header.thumbnailWidth = thumbnail.w();
+	header.thumbnailHeight = thumbnail.h();
+	auto payloadOffset = sizeof(Header) + header.thumbnailBytes();
+	out.resize(payloadOffset + compressBound(state.size()));
+	IG::MutablePixmapView{{thumbnail.size(), IG::PIXEL_RGB565}, out.data() + sizeof(Header)}.write(thumbnail);
+	// fastest level still gets most of the gain since states are mostly RAM contents
+	uLongf size = out.size() - payloadOffset;
+	if(compress2(out.data() + payloadOffset, &size, state.data(), state.size(), Z_BEST_SPEED) == Z_OK &&
+		size < state.size())
+	{
+		header.compression = Compression::DEFLATE;
+		header.payloadSize = size;
+	}
+	else
+	{
+		header.compression = Compression::NONE;
+		header.payloadSize = state.size();
+		std::ranges::copy(state, out.begin() + payloadOffset);
+	}
+	memcpy(out.data(), &header, sizeof(header));
+	out.resize(payloadOffset + header.payloadSize);
+	logMsg("%zu byte state stored as %zu bytes", state.size(), size_t(header.payloadSize));
+}
+
+}
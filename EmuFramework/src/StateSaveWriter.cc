@@ -0,0 +1,190 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "StateSaveWriter"
+#include <emuframework/StateSaveWriter.hh>
+#include <emuframework/EmuApp.hh>
+#include <emuframework/EmuSystem.hh>
+#include <emuframework/EmuVideo.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/fs/FS.hh>
+#include <imagine/thread/Thread.hh>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <chrono>
+
+namespace EmuEx
+{
+
+StateSaveWriter::~StateSaveWriter()
+{
+	if(!ioThread.joinable())
+		return;
+	writePort.send({-1});
+	ioThread.join();
+}
+
+void StateSaveWriter::start(EmuApp &app)
+{
+	if(ioThread.joinable())
+		return;
+	appPtr = &app;
+	ioThread = IG::makeThreadSync(
+		[this](auto &sem)
+		{
+			sem.release();
+			logMsg("starting state writer thread");
+			writePort.run(
+				[this](auto msgs)
+				{
+					for(auto msg : msgs)
+					{
+						if(msg.buffIdx == -1)
+							return false;
+						writeFile(buff[msg.buffIdx]);
+					}
+					return true;
+				});
+			logMsg("exiting state writer thread");
+		});
+}
+
+void StateSaveWriter::save(EmuApp &app, CStringView path)
+{
+	auto &sys = app.system();
+	start(app);
+	freeBuffers.acquire();
+	auto it = std::ranges::find_if(buff, [](auto &b){ return !b.inUse; });
+	assumeExpr(it != buff.end());
+	auto &b = *it;
+	try
+	{
+		b.header = {};
+		writeSystemState(sys, b);
+		auto thumb = app.video().captureThumbnail(sys);
+		b.thumbnailSize = thumb.size();
+		b.thumbnail.resize(thumb.w() * thumb.h());
+		MutablePixmapView{{b.thumbnailSize, PIXEL_RGB565}, b.thumbnail.data()}.write(thumb);
+		b.header.frameCount = sys.frameCount();
+		b.header.timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+			std::chrono::system_clock::now().time_since_epoch()).count();
+		b.path = path;
+	}
+	catch(...)
+	{
+		freeBuffers.release();
+		throw;
+	}
+	b.inUse = true;
+	logMsg("queued %zu byte state for writing", b.state.size());
+	writePort.send({int8_t(std::distance(buff.begin(), it))});
+}
+
+void StateSaveWriter::writeSystemState(EmuSystem &sys, Buffer &b)
+{
+	if(auto stateSize = sys.stateSize();
+		stateSize)
+	{
+		b.state.resize(stateSize);
+		b.state.resize(sys.writeState(b.state));
+	}
+	else
+	{
+		auto tempPath = tempStatePath(sys.appContext());
+		sys.saveState(tempPath);
+		auto fileData = FileUtils::bufferFromPath(tempPath);
+		FS::remove(tempPath);
+		if(!fileData)
+			EmuSystem::throwFileReadError();
+		b.state.assign(fileData.data(), fileData.data() + fileData.size());
+		b.header.flags |= SaveStateFile::SYSTEM_FILE_PAYLOAD;
+	}
+}
+
+void StateSaveWriter::writeFile(Buffer &b)
+{
+	auto ctx = appPtr->appContext();
+	SaveStateFile::write(b.fileData, b.header, {{b.thumbnailSize, PIXEL_RGB565}, b.thumbnail.data()}, b.state);
+	if(FileUtils::writeToUri(ctx, b.path, b.fileData) == -1)
+	{
+		logErr("error writing state:%s", b.path.data());
+		ctx.runOnMainThread(
+			[](ApplicationContext ctx)
+			{
+				EmuApp::get(ctx).postErrorMessage(4, "Can't save state:\nError writing file");
+			});
+	}
+	else
+	{
+		logMsg("wrote state:%s", b.path.data());
+	}
+	b.inUse = false;
+	freeBuffers.release();
+}
+
+void StateSaveWriter::wait()
+{
+	if(!ioThread.joinable())
+		return;
+	for([[maybe_unused]] auto i : iotaCount(buffers)) { freeBuffers.acquire(); }
+	freeBuffers.release(buffers);
+}
+
+void StateSaveWriter::load(EmuApp &app, CStringView path)
+{
+	auto &sys = app.system();
+	auto io = app.appContext().openFileUri(path, IOAccessHint::ALL);
+	if(!SaveStateFile::isStateFile(io.get<std::array<uint8_t, sizeof(SaveStateFile::Header::magicValue)>>()))
+	{
+		// written directly by the system
+		io = {};
+		sys.loadState(app, path);
+		return;
+	}
+	io.seekS(0);
+	auto fileData = io.buffer();
+	std::span<const uint8_t> data{fileData.data(), fileData.size()};
+	auto header = SaveStateFile::readHeader(data);
+	std::vector<uint8_t> state;
+	SaveStateFile::readPayload(data, header, state);
+	if(header.flags & SaveStateFile::SYSTEM_FILE_PAYLOAD)
+	{
+		auto tempPath = tempStatePath(app.appContext());
+		if(FileUtils::writeToPath(tempPath, state) == -1)
+			EmuSystem::throwFileWriteError();
+		try
+		{
+			sys.loadState(app, tempPath);
+		}
+		catch(...)
+		{
+			FS::remove(tempPath);
+			throw;
+		}
+		FS::remove(tempPath);
+	}
+	else
+	{
+		sys.readState(app, state);
+	}
+	sys.setFrameCount(header.frameCount);
+}
+
+FS::PathString StateSaveWriter::tempStatePath(ApplicationContext ctx)
+{
+	return FS::pathString(ctx.cachePath(), "state.tmp");
+}
+
+}
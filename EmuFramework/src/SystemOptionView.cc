@@ -111,6 +111,21 @@ TextMenuItem::SelectDelegate SystemOptionView::setFastSlowModeSpeedDel()
 	return [this](TextMenuItem &item) { app().fastSlowModeSpeedOption() = item.id(); };
 }
 
+TextMenuItem::SelectDelegate SystemOptionView::setRewindBufferSizeDel()
+{
+	return [this](TextMenuItem &item) { app().setRewindBufferSize(item.id()); };
+}
+
+TextMenuItem::SelectDelegate SystemOptionView::setRewindFrameIntervalDel()
+{
+	return [this](TextMenuItem &item) { app().setRewindFrameInterval(item.id()); };
+}
+
+TextMenuItem::SelectDelegate SystemOptionView::setRunAheadFramesDel()
+{
+	return [this](TextMenuItem &item) { app().setRunAheadFrames(item.id()); };
+}
+
 static auto savesMenuEntryStr(IG::ApplicationContext ctx, std::string_view savePath)
 {
 	return fmt::format("Saves: {}", savePathStrToDescStr(ctx, savePath));
@@ -193,6 +208,49 @@ SystemOptionView::SystemOptionView(ViewAttachParams attach, bool customMenu):
 		(MenuItem::Id)app().fastSlowModeSpeedOption().val,
 		fastSlowModeSpeedItem
 	},
+	rewindBufferSizeItem
+	{
+		{"Off",    &defaultFace(), setRewindBufferSizeDel(), 0},
+		{"16MiB",  &defaultFace(), setRewindBufferSizeDel(), 16},
+		{"32MiB",  &defaultFace(), setRewindBufferSizeDel(), 32},
+		{"64MiB",  &defaultFace(), setRewindBufferSizeDel(), 64},
+		{"128MiB", &defaultFace(), setRewindBufferSizeDel(), 128},
+		{"256MiB", &defaultFace(), setRewindBufferSizeDel(), 256},
+	},
+	rewindBufferSize
+	{
+		"Rewind Buffer Size", &defaultFace(),
+		(MenuItem::Id)app().rewindBufferSize(),
+		rewindBufferSizeItem
+	},
+	rewindFrameIntervalItem
+	{
+		{"Every Frame",     &defaultFace(), setRewindFrameIntervalDel(), 1},
+		{"Every 2 Frames",  &defaultFace(), setRewindFrameIntervalDel(), 2},
+		{"Every 4 Frames",  &defaultFace(), setRewindFrameIntervalDel(), 4},
+		{"Every 8 Frames",  &defaultFace(), setRewindFrameIntervalDel(), 8},
+		{"Every 15 Frames", &defaultFace(), setRewindFrameIntervalDel(), 15},
+	},
+	rewindFrameInterval
+	{
+		"Rewind Snapshot Interval", &defaultFace(),
+		(MenuItem::Id)app().rewindFrameInterval(),
+		rewindFrameIntervalItem
+	},
+	runAheadFramesItem
+	{
+		{"Off", &defaultFace(), setRunAheadFramesDel(), 0},
+		{"1",   &defaultFace(), setRunAheadFramesDel(), 1},
+		{"2",   &defaultFace(), setRunAheadFramesDel(), 2},
+		{"3",   &defaultFace(), setRunAheadFramesDel(), 3},
+		{"4",   &defaultFace(), setRunAheadFramesDel(), 4},
+	},
+	runAheadFrames
+	{
+		"Run-ahead Frames", &defaultFace(),
+		(MenuItem::Id)app().runAheadFrames(),
+		runAheadFramesItem
+	},
 	performanceMode
 	{
 		"Performance Mode", &defaultFace(),
@@ -216,6 +274,9 @@ void SystemOptionView::loadStockItems()
 	item.emplace_back(&confirmAutoLoadState);
 	item.emplace_back(&confirmOverwriteState);
 	item.emplace_back(&fastSlowModeSpeed);
+	item.emplace_back(&rewindBufferSize);
+	item.emplace_back(&rewindFrameInterval);
+	item.emplace_back(&runAheadFrames);
 	if(used(performanceMode))
 		item.emplace_back(&performanceMode);
 }
@@ -259,6 +259,11 @@ TextMenuItem::SelectDelegate VideoOptionView::setImageBuffersDel()
 	};
 }
 
+TextMenuItem::SelectDelegate VideoOptionView::setFramePacingStatsDel()
+{
+	return [this](TextMenuItem &item) { app().setFramePacingStatsMode(item.id()); };
+}
+
 static int aspectRatioValueIndex(double val)
 {
 	for(auto i : iotaCount(EmuSystem::aspectRatioInfos().size()))
@@ -600,6 +605,19 @@ VideoOptionView::VideoOptionView(ViewAttachParams attach, bool customMenu):
 			app().setUsePresentationTime(item.flipBoolValue(*this));
 		}
 	},
+	framePacingStatsItem
+	{
+		{"Off",            &defaultFace(), setFramePacingStatsDel(), 0},
+		{"Overlay",        &defaultFace(), setFramePacingStatsDel(), 1},
+		{"Log",            &defaultFace(), setFramePacingStatsDel(), 2},
+		{"Overlay & Log",  &defaultFace(), setFramePacingStatsDel(), 3},
+	},
+	framePacingStats
+	{
+		"Frame Pacing Stats", &defaultFace(),
+		(MenuItem::Id)app().framePacingStatsMode(),
+		framePacingStatsItem
+	},
 	visualsHeading{"Visuals", &defaultBoldFace()},
 	screenShapeHeading{"Screen Shape", &defaultBoldFace()},
 	advancedHeading{"Advanced", &defaultBoldFace()},
@@ -721,6 +739,7 @@ void VideoOptionView::loadStockItems()
 		item.emplace_back(&imageBuffers);
 	if(IG::used(presentationTime) && renderer().supportsPresentationTime())
 		item.emplace_back(&presentationTime);
+	item.emplace_back(&framePacingStats);
 	#if defined CONFIG_BASE_MULTI_WINDOW && defined CONFIG_BASE_X11
 	item.emplace_back(&secondDisplay);
 	#endif
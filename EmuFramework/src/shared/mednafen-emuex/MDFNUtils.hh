@@ -19,6 +19,11 @@
 #include <mednafen/video/surface.h>
 #include <mednafen/hash/md5.h>
 #include <mednafen/git.h>
+#include <mednafen/state.h>
+#include <mednafen/MemoryStream.h>
+#include <cstring>
+#include <span>
+#include <stdexcept>
 #include <string_view>
 
 namespace EmuEx
@@ -57,4 +62,31 @@ inline FS::FileString stateFilenameMDFN(const Mednafen::MDFNGI &gameInfo, int sl
 		name, Mednafen::md5_context::asciistr(gameInfo.MD5, 0), saveSlotChar(slot));
 }
 
+// dataOnly states skip the header & section names, as used by Mednafen's own rewind,
+// so they're only valid for the same emulator build & content they were saved from
+
+inline size_t stateSizeMDFN(bool dataOnly = false)
+{
+	Mednafen::MemoryStream s;
+	Mednafen::MDFNSS_SaveSM(&s, dataOnly);
+	return s.size();
+}
+
+inline void readStateMDFN(std::span<const uint8_t> buff, bool dataOnly = false)
+{
+	Mednafen::MemoryStream s{buff.size(), -1};
+	memcpy(s.map(), buff.data(), buff.size());
+	Mednafen::MDFNSS_LoadSM(&s, dataOnly);
+}
+
+inline size_t writeStateMDFN(std::span<uint8_t> buff, bool dataOnly = false)
+{
+	Mednafen::MemoryStream s{buff.size()};
+	Mednafen::MDFNSS_SaveSM(&s, dataOnly);
+	if(s.size() > buff.size()) [[unlikely]]
+		throw std::runtime_error{"Save state larger than buffer"};
+	memcpy(buff.data(), s.map(), s.size());
+	return s.size();
+}
+
 }
@@ -23,6 +23,7 @@
 #include <mednafen/general.h>
 
 #include <stdio.h>
+#include <algorithm>
 
 #include "CDAccess_CHD.h"
 
@@ -84,8 +85,9 @@ void CDAccess_CHD::Load(const std::string &path, bool image_memcache)
 
   /* allocate storage for sector reads */
   const chd_header *head = chd_get_header(chd);
-  hunkmem = (uint8_t *)malloc(head->hunkbytes);
-  oldhunk = -1;
+  hunkBytes = head->hunkbytes;
+  totalHunks = head->totalhunks;
+  hunkCacheMem.resize(size_t(HunkCacheSize) * hunkBytes);
 
   MDFN_printf("chd_load '%s' hunkbytes=%d\n", path.c_str(), head->hunkbytes);
 
@@ -210,87 +212,179 @@ void CDAccess_CHD::Load(const std::string &path, bool image_memcache)
       assert(Tracks[x].index[i] >= 0);
     }
   }
+
+  readAheadThread = std::thread{[this]{ ReadAheadThread(); }};
 }
 
 CDAccess_CHD::~CDAccess_CHD()
 {
+  if (readAheadThread.joinable())
+  {
+    {
+      std::lock_guard lk{cacheMutex};
+      exitReadAhead = true;
+    }
+    readAheadCond.notify_one();
+    readAheadThread.join();
+  }
+
   if (chd != NULL)
     chd_close(chd);
+}
 
-  if (hunkmem)
-    free(hunkmem);
+CDAccess_CHD::CachedHunk* CDAccess_CHD::FindCachedHunk(int32_t hunknum)
+{
+  for (auto &ch : hunkCache)
+  {
+    if (ch.hunknum == hunknum)
+      return &ch;
+  }
+  return nullptr;
 }
 
-bool CDAccess_CHD::Read_CHD_Hunk_RAW(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track)
+CDAccess_CHD::CachedHunk& CDAccess_CHD::AllocCachedHunk(int32_t hunknum)
 {
-  const chd_header *head = chd_get_header(chd);
-  int cad = lba - track->LBA + track->fileOffset;
-  int sph = head->hunkbytes / (2352 + 96);
-  int hunknum = cad / sph; //(cad * head->unitbytes) / head->hunkbytes;
-  int hunkofs = cad % sph; //(cad * head->unitbytes) % head->hunkbytes;
-  int err = CHDERR_NONE;
+  // evict the least recently used hunk, at most 2 are pending at once (the reader & the worker)
+  CachedHunk *lru = nullptr;
+  for (auto &ch : hunkCache)
+  {
+    if (ch.pending)
+      continue;
+    if (!lru || ch.lastUse < lru->lastUse)
+      lru = &ch;
+  }
+  assert(lru);
+  lru->hunknum = hunknum;
+  lru->lastUse = ++hunkUseCounter;
+  lru->pending = true;
+  return *lru;
+}
 
-  /* each hunk holds ~8 sectors, optimize when reading contiguous sectors */
-  if (hunknum != oldhunk)
+bool CDAccess_CHD::DecodeHunk(CachedHunk& ch)
+{
+  std::lock_guard lk{chdMutex};
+  chd_error err = chd_read(chd, ch.hunknum, CachedHunkData(ch));
+  if (err != CHDERR_NONE)
   {
-    err = chd_read(chd, hunknum, hunkmem);
-    if (err != CHDERR_NONE)
-    	MDFN_printf("chd_read_sector failed lba=%d error=%d\n", lba, err);
-    else
-      oldhunk = hunknum;
+    MDFN_printf("chd_read failed hunk=%d error=%d\n", ch.hunknum, err);
+    return false;
   }
+  return true;
+}
 
-  memcpy(buf, hunkmem + hunkofs * (2352 + 96), 2352);
+void CDAccess_CHD::QueueReadAhead(int32_t firstHunk, unsigned count)
+{
+  bool queued = false;
+  for (int32_t hunknum = firstHunk; hunknum < (int32_t)std::min(uint64_t(firstHunk) + count, uint64_t(totalHunks)); hunknum++)
+  {
+    if (FindCachedHunk(hunknum) || std::find(readAheadQueue.begin(), readAheadQueue.end(), hunknum) != readAheadQueue.end())
+      continue;
+    readAheadQueue.push_back(hunknum);
+    queued = true;
+  }
+  if (queued)
+    readAheadCond.notify_one();
+}
 
-  return err;
+void CDAccess_CHD::ReadAheadThread(void)
+{
+  std::unique_lock lk{cacheMutex};
+  while (1)
+  {
+    readAheadCond.wait(lk, [&]{ return exitReadAhead || readAheadQueue.size(); });
+    if (exitReadAhead)
+      return;
+    int32_t hunknum = readAheadQueue.front();
+    readAheadQueue.erase(readAheadQueue.begin());
+    if (FindCachedHunk(hunknum))
+      continue;
+    CachedHunk &ch = AllocCachedHunk(hunknum);
+    lk.unlock();
+    bool ok = DecodeHunk(ch);
+    lk.lock();
+    ch.pending = false;
+    if (!ok)
+      ch.hunknum = -1;
+    hunkDecodedCond.notify_all();
+  }
 }
 
-bool CDAccess_CHD::Read_CHD_Hunk_M1(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track)
+bool CDAccess_CHD::Read_CHD_Hunk(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track, uint32_t size)
 {
-  const chd_header *head = chd_get_header(chd);
   int cad = lba - track->LBA + track->fileOffset;
-  int sph = head->hunkbytes / (2352 + 96);
-  int hunknum = cad / sph; //(cad * head->unitbytes) / head->hunkbytes;
+  int sph = hunkBytes / (2352 + 96);
+  int32_t hunknum = cad / sph; //(cad * head->unitbytes) / head->hunkbytes;
   int hunkofs = cad % sph; //(cad * head->unitbytes) % head->hunkbytes;
-  int err = CHDERR_NONE;
 
-  /* each hunk holds ~8 sectors, optimize when reading contiguous sectors */
-  if (hunknum != oldhunk)
+  std::unique_lock lk{cacheMutex};
+  while (1)
   {
-    err = chd_read(chd, hunknum, hunkmem);
-    if (err != CHDERR_NONE)
-    	MDFN_printf("chd_read_sector failed lba=%d error=%d\n", lba, err);
-    else
-      oldhunk = hunknum;
+    CachedHunk *ch = FindCachedHunk(hunknum);
+    if (ch && ch->pending)
+    {
+      // already being decompressed by the worker
+      hunkDecodedCond.wait(lk);
+      continue;
+    }
+    if (ch)
+    {
+      ch->lastUse = ++hunkUseCounter;
+      memcpy(buf, CachedHunkData(*ch) + hunkofs * (2352 + 96), size);
+      break;
+    }
+    CachedHunk &newCh = AllocCachedHunk(hunknum);
+    lk.unlock();
+    bool ok = DecodeHunk(newCh);
+    lk.lock();
+    newCh.pending = false;
+    if (!ok)
+      newCh.hunknum = -1;
+    hunkDecodedCond.notify_all();
+    if (!ok)
+    {
+      memset(buf, 0, size);
+      return false;
+    }
   }
 
-  memcpy(buf + 16, hunkmem + hunkofs * (2352 + 96), 2048);
+  /* each hunk holds ~8 sectors, start decompressing the next ones when reading contiguous sectors */
+  if (hunknum == lastReadHunk + 1)
+    QueueReadAhead(hunknum + 1, ReadAheadHunks);
+  lastReadHunk = hunknum;
+  return true;
+}
 
-  return err;
+bool CDAccess_CHD::Read_CHD_Hunk_RAW(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track)
+{
+  return Read_CHD_Hunk(buf, lba, track, 2352);
+}
+
+bool CDAccess_CHD::Read_CHD_Hunk_M1(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track)
+{
+  return Read_CHD_Hunk(buf + 16, lba, track, 2048);
 }
 
 bool CDAccess_CHD::Read_CHD_Hunk_M2(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track)
 {
-  const chd_header *head = chd_get_header(chd);
-  int cad = lba - track->LBA + track->fileOffset;
-  int sph = head->hunkbytes / (2352 + 96);
-  int hunknum = cad / sph; //(cad * head->unitbytes) / head->hunkbytes;
-  int hunkofs = cad % sph; //(cad * head->unitbytes) % head->hunkbytes;
-  int err = CHDERR_NONE;
+  return Read_CHD_Hunk(buf + 16, lba, track, 2336);
+}
 
-  /* each hunk holds ~8 sectors, optimize when reading contiguous sectors */
-  if (hunknum != oldhunk)
+void CDAccess_CHD::HintReadSector(int32 lba, int32 count)
+{
+  for (int32_t track = FirstTrack; track < (FirstTrack + NumTracks); track++)
   {
-    err = chd_read(chd, hunknum, hunkmem);
-    if (err != CHDERR_NONE)
-    	MDFN_printf("chd_read_sector failed lba=%d error=%d\n", lba, err);
-    else
-      oldhunk = hunknum;
+    CHDFILE_TRACK_INFO *ct = &Tracks[track];
+    if (lba < (ct->LBA - ct->pregap_dv) || lba >= (ct->LBA + ct->sectors))
+      continue;
+    int sph = hunkBytes / (2352 + 96);
+    int cad = lba - ct->LBA + ct->fileOffset;
+    int32_t lastLBA = std::min(lba + std::max(count, 1) - 1, ct->LBA + ct->sectors - 1);
+    int32_t firstHunk = cad / sph;
+    int32_t lastHunk = (lastLBA - ct->LBA + ct->fileOffset) / sph;
+    std::lock_guard lk{cacheMutex};
+    QueueReadAhead(firstHunk, std::min(unsigned(lastHunk - firstHunk + 1), ReadAheadHunks));
+    return;
   }
-
-  memcpy(buf + 16, hunkmem + hunkofs * (2352 + 96), 2336);
-
-  return err;
 }
 
 int CDAccess_CHD::Read_Raw_Sector(uint8 *buf, int32 lba)
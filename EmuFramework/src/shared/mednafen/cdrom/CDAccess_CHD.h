@@ -24,6 +24,11 @@
 
 #include "CDAccess.h"
 #include <libchdr/chd.h>
+#include <array>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace Mednafen
 {
@@ -66,7 +71,7 @@ class CDAccess_CHD final : public CDAccess
 
  void Read_TOC(CDUtility::TOC *toc) final;
 
- void HintReadSector(int32 lba, int32 count) final {};
+ void HintReadSector(int32 lba, int32 count) final;
 
  int Read_Sector(uint8 *buf, int32 lba, uint32 size) final;
 
@@ -81,6 +86,27 @@ class CDAccess_CHD final : public CDAccess
   bool Read_CHD_Hunk_RAW(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track);
   bool Read_CHD_Hunk_M1(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track);
   bool Read_CHD_Hunk_M2(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track);
+  bool Read_CHD_Hunk(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track, uint32_t size);
+
+  // Decompressed hunks are kept in a small LRU cache. Reads of the hunk after the previously read one,
+  // and sectors passed to HintReadSector(), queue the following hunks for a worker thread to decompress
+  // ahead of time so streaming audio/video doesn't stall the reader on decompression.
+  static constexpr unsigned HunkCacheSize = 32;
+  static constexpr unsigned ReadAheadHunks = 4;
+
+  struct CachedHunk
+  {
+   int32_t hunknum = -1;
+   uint32_t lastUse = 0;
+   bool pending = false; // being decompressed outside of cacheMutex
+  };
+
+  CachedHunk* FindCachedHunk(int32_t hunknum);
+  CachedHunk& AllocCachedHunk(int32_t hunknum);
+  uint8_t* CachedHunkData(const CachedHunk& ch) { return hunkCacheMem.data() + (&ch - hunkCache.data()) * hunkBytes; }
+  bool DecodeHunk(CachedHunk& ch);
+  void QueueReadAhead(int32_t firstHunk, unsigned count);
+  void ReadAheadThread(void);
 
   int32_t NumTracks;
   int32_t FirstTrack;
@@ -97,10 +123,20 @@ class CDAccess_CHD final : public CDAccess
   int num_tracks;
 
   chd_file *chd;
-  /* hunk data cache */
-  uint8_t *hunkmem;
-  /* last hunknum read */
-  int oldhunk;
+  uint32_t hunkBytes = 0;
+  uint32_t totalHunks = 0;
+
+  std::array<CachedHunk, HunkCacheSize> hunkCache;
+  std::vector<uint8_t> hunkCacheMem;
+  uint32_t hunkUseCounter = 0;
+  int32_t lastReadHunk = -1;
+  std::vector<int32_t> readAheadQueue;
+  bool exitReadAhead = false;
+  std::mutex cacheMutex; // guards everything above except hunkCacheMem contents of pending hunks
+  std::mutex chdMutex; // libchdr isn't thread-safe
+  std::condition_variable hunkDecodedCond;
+  std::condition_variable readAheadCond;
+  std::thread readAheadThread;
 };
 
 }
@@ -17,6 +17,7 @@
 #include "gfx.h"
 #include "interrupt.h"
 #include "dma.h"
+#include <imagine/pixmap/Pixmap.hh>
 
 namespace MDFN_IEN_NGP
 {
@@ -129,6 +130,7 @@ void NGPGFX_CLASS::set_pixel_format(const MDFN_PixelFormat &format)
   int b = ((x >> 8) & 0xF) * 17;
 
   ColorMap[x] = format.MakeColor(r, g, b);
+  ColorMap16[x] = ColorMap[x];
  }
 }
 
@@ -145,14 +147,12 @@ bool NGPGFX_CLASS::draw(MDFN_Surface *surface, bool skip)
 		if(surface->format.opp == 4)
 		{
                  uint32 *dest = surface->pix<uint32>() + surface->pitchinpix * raster_line;
-                 for(int x = 0; x < SCREEN_WIDTH; x++)
-                  dest[x] = ColorMap[cfb_scanline[x] & 4095];
+                 IG::convertRowIndexed16(dest, cfb_scanline, SCREEN_WIDTH, ColorMap);
 		}
 		else
 		{
                  uint16 *dest = surface->pix<uint16>() + surface->pitchinpix * raster_line;
-                 for(int x = 0; x < SCREEN_WIDTH; x++)
-                  dest[x] = ColorMap[cfb_scanline[x] & 4095];
+                 IG::convertRowIndexed16(dest, cfb_scanline, SCREEN_WIDTH, ColorMap16);
 		}
         }
 	raster_line++;
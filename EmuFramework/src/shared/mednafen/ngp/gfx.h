@@ -102,6 +102,7 @@ class NGPGFX_CLASS
  uint8 K2GE_MODE;
 
  uint32 ColorMap[4096];
+ uint16 ColorMap16[4096]; // for 16-bit surfaces
 
  int layer_enable_setting;
 };
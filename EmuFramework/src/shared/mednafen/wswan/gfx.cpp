@@ -27,6 +27,7 @@
 #include "comm.h"
 #include <mednafen/video.h>
 #include <trio/trio.h>
+#include <imagine/pixmap/Pixmap.hh>
 
 namespace MDFN_IEN_WSWAN
 {
@@ -39,6 +40,8 @@ static uint32 wsCols[16][16];
 
 static uint32 ColorMapG[16];
 static uint32 ColorMap[16*16*16];
+static uint16 ColorMapG16[16]; // for 16-bit surfaces
+static uint16 ColorMap16[16*16*16];
 static uint32 LayerEnabled;
 
 static uint8 wsLine;                 /*current scanline*/
@@ -613,6 +616,7 @@ void WSwan_SetPixelFormat(const MDFN_PixelFormat &format)
     neo_b = b * 17;
 
     ColorMap[(r << 8) | (g << 4) | (b << 0)] = format.MakeColor(neo_r, neo_g, neo_b); //(neo_r << rs) | (neo_g << gs) | (neo_b << bs);
+    ColorMap16[(r << 8) | (g << 4) | (b << 0)] = ColorMap[(r << 8) | (g << 4) | (b << 0)];
    }
 
  for(int i = 0; i < 16; i++)
@@ -624,21 +628,25 @@ void WSwan_SetPixelFormat(const MDFN_PixelFormat &format)
   neo_b = (i) * 17;
 
   ColorMapG[i] = format.MakeColor(neo_r, neo_g, neo_b); //(neo_r << rs) | (neo_g << gs) | (neo_b << bs);
+  ColorMapG16[i] = ColorMapG[i];
  }
 }
 
 template<typename T>
 static INLINE void wsBlitScanline(T* MDFN_RESTRICT target, uint8* MDFN_RESTRICT bg, uint8* MDFN_RESTRICT bg_pal)
 {
+	const auto &colorMap = [&]() -> auto& { if constexpr(sizeof(T) == 4) return ColorMap; else return ColorMap16; }();
+	const auto &colorMapG = [&]() -> auto& { if constexpr(sizeof(T) == 4) return ColorMapG; else return ColorMapG16; }();
 	if(wsVMode)
 	{
+	 uint16 line[224];
 	 for(size_t l = 0; l < 224; l++)
-	  target[l] = ColorMap[wsCols[bg_pal[l]][bg[l] & 0xF]];
+	  line[l] = wsCols[bg_pal[l]][bg[l] & 0xF];
+	 IG::convertRowIndexed16(target, line, 224, colorMap);
 	}
 	else
 	{
-	 for(size_t l = 0; l < 224; l++)
-	  target[l] = ColorMapG[bg[l] & 0xF];
+	 IG::convertRowIndexed8(target, bg, 224, colorMapG);
 	}
 }
 
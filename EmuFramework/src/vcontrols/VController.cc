@@ -114,7 +114,7 @@ void VController::inputAction(Input::Action action, unsigned vBtn)
 {
 	if(isInKeyboardMode())
 	{
-		system().handleInputAction(&app(), {kb.translateInput(vBtn), action});
+		app().queueInputAction({kb.translateInput(vBtn), action});
 	}
 	else
 	{
@@ -132,7 +132,7 @@ void VController::inputAction(Input::Action action, unsigned vBtn)
 				app().removeTurboInputEvent(keyCode);
 			}
 		}
-		system().handleInputAction(&app(), {keyCode, action});
+		app().queueInputAction({keyCode, action});
 	}
 }
 
@@ -0,0 +1,102 @@
+#!/bin/sh
+# Runs an emulator's headless benchmark binary (built with linux-x86_64-benchmark.mk, no window or X server needed)
+# over every file in a content directory, several instances at once, and prints a per-content summary from the JSON reports.
+# With --baseline, the video/audio/state hashes are compared against the reports of a previous run.
+# Content with an input script next to it (<content file>.input) replays the script's events during the run.
+# usage: benchmarkContent.sh --exec=<benchmark binary> [--frames=N] [--jobs=N] [--timeout=secs]
+#        [--out=<report dir>] [--baseline=<report dir>] <content dir>
+
+frames=1800
+jobs=`nproc 2>/dev/null || echo 1`
+timeout=300
+out=benchmark-reports
+
+for arg in "$@"
+do
+	case $arg in
+		*=*) optarg=`expr "X$arg" : '[^=]*=\(.*\)'` ;;
+	esac
+
+	case "$arg" in
+		--exec=*)
+			exec=$optarg
+		;;
+		--frames=*)
+			frames=$optarg
+		;;
+		--jobs=*)
+			jobs=$optarg
+		;;
+		--timeout=*)
+			timeout=$optarg
+		;;
+		--out=*)
+			out=$optarg
+		;;
+		--baseline=*)
+			baseline=$optarg
+		;;
+		*)
+			contentDir=$arg
+		;;
+	esac
+done
+
+if [ -z "$exec" ] || [ -z "$contentDir" ]
+then
+	echo "usage: $0 --exec=<benchmark binary> [--frames=N] [--jobs=N] [--timeout=secs] [--out=<report dir>] [--baseline=<report dir>] <content dir>"
+	exit 1
+fi
+
+mkdir -p "$out"
+# reports left from an earlier run would show up in the summary as if they were from this one
+rm -f "$out"/*.json
+export exec frames timeout out
+
+# each emulator instance only runs one system at a time so parallelism is one process per content file
+find "$contentDir" -maxdepth 1 -type f ! -name "*.input" -print0 | xargs -0 -P "$jobs" -I {} sh -c '
+	name=`basename "$1"`
+	inputArg=
+	[ -f "$1.input" ] && inputArg="--benchmark-input=$1.input"
+	if timeout "$timeout" "$exec" --benchmark="$frames" --benchmark-audio --benchmark-hash ${inputArg:+"$inputArg"} \
+		--benchmark-report="$out/$name.json" "$1" >"$out/$name.log" 2>&1
+	then
+		echo "finished: $name"
+	else
+		echo "failed: $name (see $out/$name.log)"
+		rm -f "$out/$name.json"
+	fi' sh {}
+
+jsonField()
+{
+	grep -o "\"$2\":[^,}]*" "$1" | head -n 1 | cut -d : -f 2 | tr -d '"'
+}
+
+echo
+printf '%-48s %10s %10s %10s  %s\n' content fps median_us p99_us hashes
+status=0
+for report in "$out"/*.json
+do
+	[ -f "$report" ] || continue
+	name=`basename "$report" .json`
+	videoHash=`jsonField "$report" videoHash`
+	audioHash=`jsonField "$report" audioHash`
+	stateHash=`jsonField "$report" stateHash`
+	hashes="$videoHash/$audioHash/$stateHash"
+	if [ -n "$baseline" ]
+	then
+		if [ ! -f "$baseline/$name.json" ]
+		then
+			hashes="$hashes (no baseline)"
+		elif [ "$videoHash" != "`jsonField "$baseline/$name.json" videoHash`" ] ||
+			[ "$audioHash" != "`jsonField "$baseline/$name.json" audioHash`" ] ||
+			[ "$stateHash" != "`jsonField "$baseline/$name.json" stateHash`" ]
+		then
+			hashes="$hashes MISMATCH"
+			status=1
+		fi
+	fi
+	printf '%-48s %10s %10s %10s  %s\n' "$name" `jsonField "$report" fps` \
+		`jsonField "$report" median` `jsonField "$report" p99` "$hashes"
+done
+exit $status
@@ -53,6 +53,10 @@ main/VbamApi.cc \
 main/Cheats.cc \
 $(addprefix $(vbamPath)/,$(vbamSrc))
 
+ifdef emuFramework_headlessTest
+ SRC += tests/IdleLoopTest.cc
+endif
+
 include $(EMUFRAMEWORK_PATH)/package/emuframework.mk
 include $(IMAGINE_PATH)/make/package/zlib.mk
 
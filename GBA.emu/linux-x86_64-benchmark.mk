@@ -0,0 +1,9 @@
+include $(IMAGINE_PATH)/make/config.mk
+O_RELEASE := 1
+LTO_MODE ?= lto
+-include $(projectPath)/config.mk
+# command line benchmark runner without a window or renderer, see EmuFramework/tools/benchmarkContent.sh
+CPPFLAGS += -DCONFIG_EMUFRAMEWORK_HEADLESS_BENCHMARK
+target = $(metadata_exec)-benchmark
+include $(IMAGINE_PATH)/make/linux-x86_64-gcc.mk
+include $(projectPath)/build.mk
@@ -194,6 +194,29 @@ public:
 	}
 };
 
+class CustomSystemOptionView : public SystemOptionView, public MainAppHelper<CustomSystemOptionView>
+{
+	using MainAppHelper<CustomSystemOptionView>::app;
+	using MainAppHelper<CustomSystemOptionView>::system;
+
+	BoolMenuItem idleLoopSkip
+	{
+		"Skip Idle Loops", &defaultFace(),
+		cpuIdleLoopSkip,
+		[this](BoolMenuItem &item)
+		{
+			cpuIdleLoopSkip = item.flipBoolValue(*this);
+		}
+	};
+
+public:
+	CustomSystemOptionView(ViewAttachParams attach): SystemOptionView{attach, true}
+	{
+		loadStockItems();
+		item.emplace_back(&idleLoopSkip);
+	}
+};
+
 class CustomAudioOptionView : public AudioOptionView, public MainAppHelper<CustomAudioOptionView>
 {
 	using MainAppHelper<CustomAudioOptionView>::system;
@@ -360,6 +383,7 @@ std::unique_ptr<View> EmuApp::makeCustomView(ViewAttachParams attach, ViewID id)
 	switch(id)
 	{
 		case ViewID::SYSTEM_ACTIONS: return std::make_unique<CustomSystemActionsView>(attach);
+		case ViewID::SYSTEM_OPTIONS: return std::make_unique<CustomSystemOptionView>(attach);
 		case ViewID::AUDIO_OPTIONS: return std::make_unique<CustomAudioOptionView>(attach);
 		case ViewID::EDIT_CHEATS: return std::make_unique<EmuEditCheatListView>(attach);
 		case ViewID::LIST_CHEATS: return std::make_unique<EmuCheatsView>(attach);
@@ -409,6 +409,19 @@ public:
 	unsigned memoryWaitSeq32[16] =
 	  {0, 0, 5, 0, 0, 1, 1, 0, 5, 5, 9, 9, 17, 17, 4, 0};
 	std::array<memoryMap, 256> map{};
+	// incremented by every CPU memory write, used to tell if a loop iteration had side effects
+	uint32_t memWriteCount{};
+
+	// state of the last short backward branch target, see CPUCheckIdleLoop()
+	struct IdleLoop
+	{
+		std::array<uint32_t, 15> regs{};
+		uint32_t address{};
+		uint32_t memWriteCount{};
+		uint8_t flags{};
+		uint8_t matches{};
+	};
+	IdleLoop idleLoop{};
 
 	static constexpr bool calcNFlag(auto result)
 	{
@@ -613,6 +626,7 @@ public:
 
 		holdState = 0;
 		SWITicks = 0;
+		idleLoop = {};
 	}
 
 	void updateCPSR();
@@ -88,6 +88,25 @@ void GbaSystem::loadState(EmuApp &app, IG::CStringView path)
 		return throwFileReadError();
 }
 
+size_t GbaSystem::stateSize()
+{
+	return saveStateSize;
+}
+
+void GbaSystem::readState(EmuApp &, std::span<const uint8_t> buff)
+{
+	if(!CPUReadMemState(gGba, (char*)buff.data(), buff.size()))
+		throw std::runtime_error{"Invalid state data"};
+}
+
+size_t GbaSystem::writeState(std::span<uint8_t> buff)
+{
+	long size{};
+	if(!CPUWriteMemState(gGba, (char*)buff.data(), buff.size(), size))
+		throw std::runtime_error{"State data exceeds buffer size"};
+	return size;
+}
+
 void GbaSystem::onFlushBackupMemory(BackupMemoryDirtyFlags)
 {
 	if(!hasContent() || saveType == GBA_SAVE_NONE)
@@ -114,6 +133,7 @@ void GbaSystem::closeSystem()
 	detectedSensorType = {};
 	sensorListener = {};
 	cheatsList.clear();
+	saveStateSize = 0;
 }
 
 void GbaSystem::applyGamePatches(uint8_t *rom, int &romSize)
@@ -163,6 +183,12 @@ void GbaSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegat
 	auto saveStr = EmuSystem::contentSaveFilePath(".sav");
 	CPUReadBatteryFile(appContext(), gGba, saveStr.data());
 	readCheatFile(*this);
+	// size depends on the cartridge save type so measure it once with a test save
+	constexpr size_t maxStateSize = 1024 * 1024;
+	auto buff = std::make_unique<char[]>(maxStateSize);
+	long writtenSize{};
+	saveStateSize = CPUWriteMemState(gGba, buff.get(), maxStateSize, writtenSize) ? writtenSize : 0;
+	logMsg("state size:%zu", saveStateSize);
 }
 
 bool GbaSystem::onVideoRenderFormatChange(EmuVideo &video, IG::PixelFormat fmt)
@@ -227,12 +253,12 @@ void systemDrawScreen(EmuEx::EmuSystemTaskContext taskCtx, EmuEx::EmuVideo &vide
 	assumeExpr(img.pixmap().size() == framePix.size());
 	if(img.pixmap().format() == IG::PIXEL_FMT_RGB565)
 	{
-		img.pixmap().writeTransformed([](uint16_t p){ return systemColorMap.map16[p]; }, framePix);
+		img.pixmap().writeIndexed<uint16_t>(systemColorMap.map16, framePix);
 	}
 	else
 	{
 		assumeExpr(img.pixmap().format().bytesPerPixel() == 4);
-		img.pixmap().writeTransformed([](uint16_t p){ return systemColorMap.map32[p]; }, framePix);
+		img.pixmap().writeIndexed<uint32_t>(systemColorMap.map32, framePix);
 	}
 	img.endFrame();
 }
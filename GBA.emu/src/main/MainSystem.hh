@@ -23,7 +23,7 @@ enum
 	CFGKEY_RTC_EMULATION = 256, CFGKEY_SAVE_TYPE_OVERRIDE = 257,
 	CFGKEY_PCM_VOLUME = 258, CFGKEY_GB_APU_VOLUME = 259,
 	CFGKEY_SOUND_FILTERING = 260, CFGKEY_SOUND_INTERPOLATION = 261,
-	CFGKEY_SENSOR_TYPE = 262
+	CFGKEY_SENSOR_TYPE = 262, CFGKEY_IDLE_LOOP_SKIP = 263
 };
 
 void readCheatFile(EmuSystem &);
@@ -90,8 +90,13 @@ public:
 	void closeSystem();
 	bool onVideoRenderFormatChange(EmuVideo &, IG::PixelFormat);
 	void renderFramebuffer(EmuVideo &);
+	size_t stateSize();
+	void readState(EmuApp &, std::span<const uint8_t> buff);
+	size_t writeState(std::span<uint8_t> buff);
 
 private:
+	size_t saveStateSize{};
+
 	void applyGamePatches(uint8_t *rom, int &romSize);
 };
 
@@ -39,6 +39,18 @@ constexpr GameSettings settings[]
 #include "gba-over.inc"
 };
 
+struct IdleLoopSettings
+{
+	std::string_view gameName;
+	std::string_view gameId;
+	uint32_t address;
+};
+
+constexpr IdleLoopSettings idleLoopSettings[]
+{
+#include "gba-idle-over.inc"
+};
+
 int systemSaveUpdateCounter = SYSTEM_SAVE_NOT_UPDATED;
 SystemColorMap systemColorMap;
 uint32_t throttle{};
@@ -222,6 +234,13 @@ void GbaSystem::setGameSpecificSettings(GBASys &gba, int romSize)
 	detectedSaveType = foundSettings.saveType;
 	detectedSaveSize = foundSettings.saveSize;
 	detectedSensorType = detectSensorType(gameId);
+	cpuIdleLoopAddress = 0;
+	if(auto it = IG::find_if(idleLoopSettings, [&](const auto &s){return s.gameId == gameId;});
+		it != std::end(idleLoopSettings))
+	{
+		cpuIdleLoopAddress = it->address;
+		logMsg("using idle loop address:0x%X", cpuIdleLoopAddress);
+	}
 	doMirroring(gba, foundSettings.mirroringEnabled);
 	if(detectedSaveType == GBA_SAVE_AUTO)
 	{
@@ -0,0 +1,76 @@
+/*  This file is part of GBA.emu.
+
+	GBA.emu is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	GBA.emu is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with GBA.emu.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "IdleLoopTest"
+#include <main/MainSystem.hh>
+#include <vbam/gba/GBA.h>
+#include <vbam/gba/Globals.h>
+#include <imagine/io/IO.hh>
+#include <imagine/io/MapIO.hh>
+#include <imagine/logger/logger.h>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vbam/gba/GBAcpu.h>
+
+// Runs a ROM polling an IWRAM flag with an ldr/cmp/beq loop, which must be detected as idle
+// and skip straight to the next event
+static bool testIdleLoopDetection(GBASys &gba)
+{
+	static constexpr uint32_t loopAddress = 0x08000004;
+	static constexpr std::array<uint32_t, 5> romWords
+	{
+		0xE3A01403, // mov r1, #0x03000000
+		0xE5910000, // loop: ldr r0, [r1]
+		0xE3500000, // cmp r0, #0
+		0x0AFFFFFC, // beq loop
+		0xEAFFFFFE, // b .
+	};
+	std::array<uint8_t, sizeof(romWords)> romData;
+	memcpy(romData.data(), romWords.data(), sizeof(romWords));
+	IG::IO romIO{IG::MapIO{IG::IOBuffer{romData, 0}}};
+	CPULoadRomWithIO(gba, romIO);
+	CPUInit(gba, 0, false);
+	CPUReset(gba);
+	auto savedIdleLoopSkip = std::exchange(cpuIdleLoopSkip, true);
+	auto savedIdleLoopAddress = std::exchange(cpuIdleLoopAddress, 0);
+	auto &cpu = gba.cpu;
+	cpu.cpuTotalTicks = 0;
+	cpu.cpuNextEvent = 100000;
+	armExecute(cpu);
+	bool detected = cpu.idleLoop.address == loopAddress && cpu.idleLoop.matches &&
+		cpu.cpuTotalTicks == cpu.cpuNextEvent;
+	cpuIdleLoopSkip = savedIdleLoopSkip;
+	cpuIdleLoopAddress = savedIdleLoopAddress;
+	if(!detected)
+	{
+		logErr("idle loop not detected, candidate:0x%X matches:%u ticks:%d",
+			cpu.idleLoop.address, cpu.idleLoop.matches, cpu.cpuTotalTicks);
+	}
+	return detected;
+}
+
+namespace EmuEx
+{
+
+bool runSystemTests(EmuSystem &)
+{
+	bool passed = testIdleLoopDetection(gGba);
+	std::printf("idle loop detection: %s\n", passed ? "passed" : "FAILED");
+	return passed;
+}
+
+}
@@ -146,6 +146,7 @@ local size_t memWrite(const void *buffer, size_t size, size_t count, MEMFILE *fi
 
         if (total > (size_t)file->available) {
                 total = file->available;
+                file->error = 1;
         }
         memcpy(file->next, buffer, total);
         file->available -= (int)total;
@@ -184,8 +185,10 @@ local int memPutc(int c, MEMFILE *file)
         if (file->available >= 1) {
                 *file->next++ = c;
                 file->available--;
-        } else
+        } else {
+                file->error = 1;
                 return -1;
+        }
 
         return c;
 }
@@ -714,6 +717,9 @@ int ZEXPORT memgzclose(file) gzFile file;
 
                 putLong(s->file, s->crc);
                 putLong(s->file, s->stream.total_in);
+                /* report running out of memory, including for the trailer */
+                if (memError(s->file))
+                        s->z_err = Z_ERRNO;
 #endif
         }
         return destroy((mem_stream *)file);
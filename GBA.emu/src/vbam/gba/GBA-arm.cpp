@@ -2316,6 +2316,7 @@ int armExecute(ARM7TDMI &cpu)
 #endif
 
         armNextPC = reg[15].I;
+        uint32_t seqNextPC = armNextPC;
         reg[15].I += 4;
         ARM_PREFETCH_NEXT;
 
@@ -2438,6 +2439,10 @@ int armExecute(ARM7TDMI &cpu)
             clockTicks = 1 + codeTicksAccessSeq32(oldArmNextPC);
         cpuTotalTicks += clockTicks;
 
+        // only taken branches move armNextPC off the next sequential instruction
+        if (cpuIdleLoopSkip && armNextPC != seqNextPC)
+            CPUCheckIdleLoopBranch(cpu, (uint32_t)oldArmNextPC);
+
     } while (cpuTotalTicks < cpuNextEvent &&
     		(!CONFIG_TRIGGER_ARM_STATE_EVENT && armState) && !cpu.SWITicks);
     return 1;
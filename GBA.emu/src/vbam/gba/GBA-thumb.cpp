@@ -1653,6 +1653,7 @@ int thumbExecute(ARM7TDMI &cpu)
 #endif
 
     armNextPC = reg[15].I;
+    uint32_t seqNextPC = armNextPC;
     reg[15].I += 2;
     THUMB_PREFETCH_NEXT;
 
@@ -1713,6 +1714,10 @@ int thumbExecute(ARM7TDMI &cpu)
         clockTicks = codeTicksAccessSeq16(oldArmNextPC) + 1;
     cpuTotalTicks += clockTicks;
 
+    // only taken branches move armNextPC off the next sequential instruction
+    if (cpuIdleLoopSkip && armNextPC != seqNextPC)
+        CPUCheckIdleLoopBranch(cpu, oldArmNextPC);
+
   } while (cpuTotalTicks < cpuNextEvent &&
   		(!CONFIG_TRIGGER_ARM_STATE_EVENT && !armState) && !cpu.SWITicks);
   return 1;
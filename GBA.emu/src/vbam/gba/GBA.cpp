@@ -875,7 +875,8 @@ bool CPUWriteState(IG::ApplicationContext ctx, GBASys &gba, const char* file)
 
 bool CPUWriteMemState(GBASys &gba, char *memory, int available, long& reserved)
 {
-  gzFile gzFile = utilMemGzOpen(memory, available, "w");
+  // store without compression since memory states are used for short-lived snapshots
+  gzFile gzFile = utilMemGzOpen(memory, available, "w0");
 
   if (gzFile == NULL) {
     return false;
@@ -883,12 +884,14 @@ bool CPUWriteMemState(GBASys &gba, char *memory, int available, long& reserved)
 
   bool res = CPUWriteState(gba, gzFile);
 
-  reserved = utilGzMemTell(gzFile)+8;
-
-  if (reserved >= (available))
+  // fails if the buffer filled up before everything was written
+  if (utilGzClose(gzFile) != Z_OK)
     res = false;
 
-  utilGzClose(gzFile);
+  // total size is the 8 byte memory stream header plus the stream size stored in it on close
+  int32_t streamSize;
+  memcpy(&streamSize, memory + 4, sizeof(streamSize));
+  reserved = streamSize + 8;
 
   return res;
 }
@@ -2047,6 +2050,37 @@ void ARM7TDMI::softwareInterrupt()
 #define armMode cpu.armMode
 #define armNextPC cpu.armNextPC
 
+// A loop is treated as idle once it branches back to its start with the same register & flag state and
+// no memory writes for IDLE_LOOP_MATCHES iterations in a row. Since each iteration then only depends on
+// memory that isn't changing, like an IO register or IWRAM flag being polled, it will keep spinning until
+// the next event updates something, so those cycles can be skipped.
+static const uint8_t IDLE_LOOP_MATCHES = 2;
+
+void CPUCheckIdleLoop(ARM7TDMI &cpu)
+{
+  auto &idle = cpu.idleLoop;
+  uint8_t flags = cpu.nFlag() | (cpu.zFlag() << 1) | (cpu.C_FLAG << 2) | (cpu.V_FLAG << 3);
+  bool noWrites = idle.address == armNextPC && idle.memWriteCount == cpu.memWriteCount;
+  bool isIdle = false;
+  if (noWrites && idle.address == cpuIdleLoopAddress) {
+    // known idle loop from the override table, only require it to have no side effects
+    isIdle = true;
+  } else if (noWrites && idle.flags == flags &&
+      std::equal(idle.regs.begin(), idle.regs.end(), &cpu.reg[0], [](uint32_t v, auto r){ return v == r.I; })) {
+    if (idle.matches < IDLE_LOOP_MATCHES)
+      idle.matches++;
+    isIdle = idle.matches == IDLE_LOOP_MATCHES;
+  } else {
+    idle.address = armNextPC;
+    idle.flags = flags;
+    idle.matches = 0;
+    std::transform(&cpu.reg[0], &cpu.reg[idle.regs.size()], idle.regs.begin(), [](auto r){ return r.I; });
+  }
+  idle.memWriteCount = cpu.memWriteCount;
+  if (isIdle && cpuTotalTicks < cpuNextEvent)
+    cpuTotalTicks = cpuNextEvent;
+}
+
 void CPUSoftwareInterrupt(ARM7TDMI &cpu, int comment)
 {
 	auto &gba = *cpu.gba;
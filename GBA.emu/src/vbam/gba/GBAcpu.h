@@ -27,6 +27,18 @@ static void UPDATE_REG(auto *gba, auto address, auto value)
 
 extern uint32_t mastercode;
 extern void CPUSoftwareInterrupt(ARM7TDMI &cpu, int comment);
+extern void CPUCheckIdleLoop(ARM7TDMI &cpu);
+
+static const uint32_t CPU_IDLE_LOOP_MAX_SIZE = 64;
+
+// Called after a taken branch, checks for a short backward branch that may close a polling loop
+static inline void CPUCheckIdleLoopBranch(ARM7TDMI &cpu, uint32_t branchAddress)
+{
+  uint32_t target = cpu.armNextPC;
+  if (target <= branchAddress && branchAddress - target <= CPU_IDLE_LOOP_MAX_SIZE &&
+      target >= 0x02000000 && target < 0x0E000000)
+    CPUCheckIdleLoop(cpu);
+}
 
 #define busPrefetchCount cpu.busPrefetchCount
 #define busPrefetch cpu.busPrefetch
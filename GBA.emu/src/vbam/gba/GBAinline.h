@@ -453,6 +453,7 @@ static inline uint8_t CPUReadByte(ARM7TDMI &cpu, uint32_t address)
 
 static inline void CPUWriteMemory(ARM7TDMI &cpu, uint32_t address, uint32_t value)
 {
+    cpu.memWriteCount++;
     auto &ioMem = cpu.gba->mem.ioMem.b;
 #ifdef GBA_LOGGING
     if (address & 3) {
@@ -558,6 +559,7 @@ static inline void CPUWriteMemory(ARM7TDMI &cpu, uint32_t address, uint32_t valu
 
 static inline void CPUWriteHalfWord(ARM7TDMI &cpu, uint32_t address, uint16_t value)
 {
+    cpu.memWriteCount++;
 #ifdef GBA_LOGGING
     if (address & 1) {
         if (systemVerbose & VERBOSE_UNALIGNED_MEMORY) {
@@ -667,6 +669,7 @@ static inline void CPUWriteHalfWord(ARM7TDMI &cpu, uint32_t address, uint16_t va
 
 static inline void CPUWriteByte(ARM7TDMI &cpu, uint32_t address, uint8_t b)
 {
+    cpu.memWriteCount++;
     auto &ioMem = cpu.gba->mem.ioMem.b;
 #ifdef BKPT_SUPPORT
     memoryMap* m = &map[address >> 24];
@@ -9,6 +9,8 @@ int saveType = 0;
 bool useBios = false;
 bool skipBios = false;
 bool cpuIsMultiBoot = false;
+bool cpuIdleLoopSkip = true;
+uint32_t cpuIdleLoopAddress = 0;
 bool parseDebug = true;
 #ifdef USE_CHEATS
 bool cheatsEnabled = false;
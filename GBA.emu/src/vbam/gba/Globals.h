@@ -68,6 +68,8 @@ extern bool useBios;
 extern bool skipBios;
 static const bool cpuDisableSfx = 0;
 extern bool cpuIsMultiBoot;
+extern bool cpuIdleLoopSkip; // fast-forward to the next event in loops detected as idle
+extern uint32_t cpuIdleLoopAddress; // known idle loop from the per-game override table, 0 if none
 extern bool parseDebug;
 static const bool speedHack = 1;
 constexpr int customBackdropColor = -1;
@@ -19,6 +19,9 @@
 #include <imagine/util/ScopeGuard.hh>
 #include <imagine/util/format.hh>
 #include <imagine/fs/FS.hh>
+#include <imagine/io/MapIO.hh>
+#include <imagine/io/IOStream.hh>
+#include <sstream>
 #include <resample/resampler.h>
 #include <resample/resamplerinfo.h>
 #include <main/Cheats.hh>
@@ -99,6 +102,28 @@ void GbcSystem::loadState(EmuApp &app, IG::CStringView path)
 		throwFileReadError();
 }
 
+size_t GbcSystem::stateSize()
+{
+	std::ostringstream stream;
+	gbEmu.saveState(nullptr, 0, stream);
+	return stream.tellp();
+}
+
+void GbcSystem::readState(EmuApp &, std::span<const uint8_t> buff)
+{
+	IG::IStream<MapIO> stream{MapIO{IOBuffer{{const_cast<uint8_t*>(buff.data()), buff.size()}}}};
+	if(!gbEmu.loadState(stream))
+		throw std::runtime_error{"Invalid state data"};
+}
+
+size_t GbcSystem::writeState(std::span<uint8_t> buff)
+{
+	IG::OStream<MapIO> stream{MapIO{IOBuffer{buff}}};
+	if(!gbEmu.saveState(nullptr, 0, stream))
+		throw std::runtime_error{"State data exceeds buffer size"};
+	return stream.tellp();
+}
+
 void GbcSystem::onFlushBackupMemory(BackupMemoryDirtyFlags)
 {
 	if(!hasContent())
@@ -101,9 +101,6 @@ void state_load(const unsigned char *buffer)
 {
 	auto state = std::make_unique<unsigned char[]>(STATE_SIZE);
 
-  /* buffer size */
-  unsigned bufferptr = 0;
-
   /* uncompress savestate */
   uint32 inbytes32;
   memcpy(&inbytes32, buffer, 4);
@@ -118,6 +115,14 @@ void state_load(const unsigned char *buffer)
 			throw std::runtime_error(fmt::format("Error {} during uncompress", result));
 		}
   }
+  state_load_uncompressed(state.get(), outbytes);
+}
+
+void state_load_uncompressed(unsigned char *state, unsigned long outbytes)
+{
+  /* buffer size */
+  unsigned bufferptr = 0;
+
 
   /* signature check (GENPLUS-GX x.x.x) */
   char version[17];
@@ -298,6 +303,21 @@ int state_save(unsigned char *buffer)
 {
 	auto state = std::make_unique<unsigned char[]>(STATE_SIZE);
 
+  /* compress state file */
+  unsigned long inbytes   = state_save_uncompressed(state.get());
+  unsigned long outbytes  = STATE_SIZE;
+  logMsg("compressing %d bytes to buffer of %d size", (int)inbytes, (int)outbytes);
+  int ret = compress2 ((Bytef *)(buffer + 4), &outbytes, (Bytef *)state.get(), inbytes, 9);
+  logMsg("compress2 returned %d, reduced to %d bytes", ret, (int)outbytes);
+  uint32 outbytes32 = outbytes; // assumes no save states will ever be over 4GB
+  memcpy(buffer, &outbytes32, 4);
+
+  /* return total size */
+  return (outbytes32 + 4);
+}
+
+int state_save_uncompressed(unsigned char *state)
+{
   /* buffer size */
   int bufferptr = 0;
 
@@ -392,15 +412,5 @@ int state_save(unsigned char *buffer)
 	}
 	#endif
 
-  /* compress state file */
-  unsigned long inbytes   = bufferptr;
-  unsigned long outbytes  = STATE_SIZE;
-  logMsg("compressing %d bytes to buffer of %d size", (int)inbytes, (int)outbytes);
-  int ret = compress2 ((Bytef *)(buffer + 4), &outbytes, (Bytef *)state.get(), inbytes, 9);
-  logMsg("compress2 returned %d, reduced to %d bytes", ret, (int)outbytes);
-  uint32 outbytes32 = outbytes; // assumes no save states will ever be over 4GB
-  memcpy(buffer, &outbytes32, 4);
-
-  /* return total size */
-  return (outbytes32 + 4);
+  return bufferptr;
 }
@@ -42,5 +42,7 @@
 /* Function prototypes */
 void state_load(const unsigned char *buffer);
 int state_save(unsigned char *buffer);
+void state_load_uncompressed(unsigned char *state, unsigned long size);
+int state_save_uncompressed(unsigned char *state);
 
 #endif
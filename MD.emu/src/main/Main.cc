@@ -31,7 +31,7 @@
 #ifndef NO_SCD
 #include <scd/scd.h>
 #include <mednafen/mednafen.h>
-#include <mednafen/cdrom/CDAccess.h>
+#include <mednafen/cdrom/CDInterface.h>
 #endif
 #include "Cheats.hh"
 #include <imagine/fs/FS.hh>
@@ -162,6 +162,20 @@ void MdSystem::loadState(EmuApp &app, IG::CStringView path)
 	state_load(FileUtils::bufferFromUri(app.appContext(), path).data());
 }
 
+size_t MdSystem::stateSize() { return STATE_SIZE; }
+
+void MdSystem::readState(EmuApp &, std::span<const uint8_t> buff)
+{
+	// state data is only read from, the context loaders just lack const qualifiers
+	state_load_uncompressed(const_cast<uint8_t*>(buff.data()), buff.size());
+}
+
+size_t MdSystem::writeState(std::span<uint8_t> buff)
+{
+	assumeExpr(buff.size() >= STATE_SIZE);
+	return state_save_uncompressed(buff.data());
+}
+
 static bool sramHasContent(std::span<uint8> sram)
 {
 	for(auto v : sram)
@@ -279,8 +293,8 @@ void MdSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegate
 {
 	#ifndef NO_SCD
 	using namespace Mednafen;
-	CDAccess *cd{};
-	auto deleteCDAccess = IG::scopeGuard([&](){ delete cd; });
+	CDInterface *cd{};
+	auto deleteCDInterface = IG::scopeGuard([&](){ delete cd; });
 	if(hasMDCDExtension(contentFileName()) ||
 		(hasBinExtension(contentFileName()) && io.size() > 1024*1024*10)) // CD
 	{
@@ -288,7 +302,7 @@ void MdSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegate
 		{
 			throwMissingContentDirError();
 		}
-		cd = CDAccess_Open(&NVFS, std::string{contentLocation()}, false);
+		cd = CDInterface::Open(&NVFS, std::string{contentLocation()}, false, 0);
 
 		unsigned region = REGION_USA;
 		if (config.region_detect == 1) region = REGION_USA;
@@ -298,7 +312,7 @@ void MdSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegate
 	  else
 	  {
 	  	uint8 bootSector[2048];
-	  	cd->Read_Sector(bootSector, 0, 2048);
+	  	cd->ReadSectors(bootSector, 0, 1);
 			region = detectISORegion(bootSector);
 	  }
 
@@ -409,7 +423,7 @@ void MdSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegate
 		{
 			throw std::runtime_error("Error loading CD");
 		}
-		deleteCDAccess.cancel();
+		deleteCDInterface.cancel();
 	}
 	#endif
 
@@ -18,7 +18,7 @@
 #include <stdio.h>
 #include <imagine/io/FileIO.hh>
 #include <mednafen/mednafen.h>
-#include <mednafen/cdrom/CDAccess.h>
+#include <mednafen/cdrom/CDInterface.h>
 
 #define cdprintf(x...)
 //#define cdprintf(f,...) printf(f "\n",##__VA_ARGS__) // tmp
@@ -31,14 +31,16 @@ bool MDFN_GetSettingB(const char *name) { return 0; }
 
 }
 
-static Mednafen::CDAccess *cdImage = nullptr;
+// Sectors are read through CDInterface_MT so disc I/O & decompression happen on its read thread,
+// which reads ahead of sequential accesses and is hinted on seeks
+static Mednafen::CDInterface *cdImage = nullptr;
 
-int Load_ISO(Mednafen::CDAccess *cd)
+int Load_ISO(Mednafen::CDInterface *cd)
 {
 	using namespace Mednafen;
 	_scd_track *Tracks = sCD.TOC.Tracks;
 	CDUtility::TOC toc;
-	cd->Read_TOC(&toc);
+	cd->ReadTOC(&toc);
 	unsigned currLBA = 0;
 	sCD.cddaLBA = 0;
 	sCD.cddaDataLeftover = 0;
@@ -82,12 +84,24 @@ void Unload_ISO(void)
 
 static void readLBA(void *dest, int lba)
 {
-	cdImage->Read_Sector((uint8*)dest, lba, 2048);
+	uint8 data[2352 + 96]{};
+	cdImage->ReadRawSector(data, lba);
+	auto mode = data[12 + 3];
+	memcpy(dest, data + (mode == 2 ? 24 : 16), 2048);
 }
 
 static void readCddaLBA(void *dest, int lba)
 {
-	cdImage->Read_Sector((uint8*)dest, lba, 2352);
+	uint8 data[2352 + 96]{};
+	cdImage->ReadRawSector(data, lba);
+	memcpy(dest, data, 2352);
+}
+
+void FILE_Hint_LBA(int lba)
+{
+	if(!cdImage)
+		return;
+	cdImage->HintReadSector(lba);
 }
 
 int readCDDA(void *dest, unsigned size)
@@ -101,7 +115,7 @@ int readCDDA(void *dest, unsigned size)
 		{
 			//logMsg("reading %d frames of left-over CDDA", cddaDataLeftover);
 			int32 cddaSector[588];
-			cdImage->Read_Sector((uint8*)cddaSector, sCD.cddaLBA, 2352);
+			readCddaLBA(cddaSector, sCD.cddaLBA);
 			unsigned copySize = std::min((unsigned)sCD.cddaDataLeftover, sizeToWrite);
 			memcpy(cddaBuffPos, cddaSector + (588-sCD.cddaDataLeftover), copySize*4);
 			sCD.cddaDataLeftover -= copySize;
@@ -113,7 +127,7 @@ int readCDDA(void *dest, unsigned size)
 		while(sizeToWrite >= 588)
 		{
 			//logMsg("reading 588 frames");
-			cdImage->Read_Sector((uint8*)cddaBuffPos, sCD.cddaLBA, 2352);
+			readCddaLBA(cddaBuffPos, sCD.cddaLBA);
 			sCD.cddaLBA++;
 			cddaBuffPos += 588;
 			sizeToWrite -= 588;
@@ -122,7 +136,7 @@ int readCDDA(void *dest, unsigned size)
 		{
 			//logMsg("reading %d frames left", sizeToWrite);
 			int32 cddaSector[588];
-			cdImage->Read_Sector((uint8*)cddaSector, sCD.cddaLBA, 2352);
+			readCddaLBA(cddaSector, sCD.cddaLBA);
 			memcpy(cddaBuffPos, cddaSector, sizeToWrite*4);
 			sCD.cddaDataLeftover = 588 - sizeToWrite;
 		}
@@ -7,11 +7,12 @@
 
 namespace Mednafen
 {
-class CDAccess;
+class CDInterface;
 }
 
-int Load_ISO(Mednafen::CDAccess *cd);
+int Load_ISO(Mednafen::CDInterface *cd);
 //int  Load_ISO(const char *iso_name, int is_bin);
 void Unload_ISO(void);
 int  FILE_Read_One_LBA_CDC(void);
 int  FILE_Play_CD_LBA(void);
+void FILE_Hint_LBA(int lba);
@@ -14,7 +14,7 @@
 #include "cd_sys.h"
 #include "cd_file.h"
 #include <mednafen/mednafen.h>
-#include <mednafen/cdrom/CDAccess.h>
+#include <mednafen/cdrom/CDInterface.h>
 
 #define cdprintf(x...)
 //#define DEBUG_CD
@@ -203,7 +203,7 @@ void Reset_CD(void)
 }
 
 
-int Insert_CD(Mednafen::CDAccess *cd)
+int Insert_CD(Mednafen::CDInterface *cd)
 {
 	int ret = 0;
 
@@ -494,6 +494,7 @@ int Play_CDD_c3(void)
 
 	sCD.Cur_LBA = new_lba;
 	CDC_Update_Header();
+	FILE_Hint_LBA(sCD.Cur_LBA);
 
 	//logMsg("Read : Cur LBA = %d, M=%d, S=%d, F=%d", sCD.Cur_LBA, MSF.M, MSF.S, MSF.F);
 
@@ -547,6 +548,7 @@ int Seek_CDD_c4(void)
 	sCD.Cur_Track = MSF_to_Track(&MSF);
 	sCD.Cur_LBA = MSF_to_LBA(&MSF);
 	CDC_Update_Header();
+	FILE_Hint_LBA(sCD.Cur_LBA);
 
 	sCD.Status_CDC &= ~1;				// Stop CDC read
 
@@ -9,7 +9,7 @@
 
 namespace Mednafen
 {
-class CDAccess;
+class CDInterface;
 }
 
 struct SegaCD
@@ -123,5 +123,5 @@ void scd_updateCddaVol();
 int scd_saveState(uint8_t *state);
 int scd_loadState(uint8_t *state, unsigned exVersion);
 
-int Insert_CD(Mednafen::CDAccess *cd);
+int Insert_CD(Mednafen::CDInterface *cd);
 void Stop_CD();
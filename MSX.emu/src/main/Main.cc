@@ -587,6 +587,29 @@ void MsxSystem::loadState(EmuApp &app, IG::CStringView path)
 	return loadBlueMSXState(app, path);
 }
 
+size_t MsxSystem::stateSize()
+{
+	saveBlueMSXState(memoryStatePath);
+	return zipMemoryWriteData().size();
+}
+
+void MsxSystem::readState(EmuApp &app, std::span<const uint8_t> buff)
+{
+	zipSetMemoryReadData(buff);
+	auto resetReadData = IG::scopeGuard([](){ zipSetMemoryReadData({}); });
+	loadBlueMSXState(app, memoryStatePath);
+}
+
+size_t MsxSystem::writeState(std::span<uint8_t> buff)
+{
+	saveBlueMSXState(memoryStatePath);
+	auto data = zipMemoryWriteData();
+	if(data.size() > buff.size())
+		throw std::runtime_error{"State data exceeds buffer size"};
+	std::ranges::copy(data, buff.begin());
+	return data.size();
+}
+
 void MsxSystem::closeSystem()
 {
 	destroyMachine();
@@ -19,6 +19,10 @@ extern Machine *machine;
 
 bool zipStartWrite(const char *fileName);
 void zipEndWrite();
+// passed in place of a state path to save to or load from memory instead of a zip file
+constexpr const char *memoryStatePath = ":memory:";
+std::span<const uint8_t> zipMemoryWriteData();
+void zipSetMemoryReadData(std::span<const uint8_t>);
 IG::PixmapView frameBufferPixmap();
 HdType boardGetHdType(int hdIndex);
 
@@ -98,6 +102,11 @@ public:
 	void onOptionsLoaded();
 	bool shouldFastForward() const;
 	VController::KbMap vControllerKeyboardMap(VControllerKbMode mode);
+	size_t stateSize();
+	void readState(EmuApp &, std::span<const uint8_t> buff);
+	size_t writeState(std::span<uint8_t> buff);
+	// loading recreates the board & reinserts media, too slow for rewind & run-ahead
+	size_t snapshotSize() { return 0; }
 
 private:
 	void insertMedia(EmuApp &app);
@@ -210,7 +210,10 @@ void MsxSystem::handleInputAction(EmuApp *appPtr, InputAction a)
 	if(event1 == EC_KEYCOUNT)
 	{
 		if(appPtr && isPushed)
-			appPtr->toggleKeyboard();
+		{
+			// may run on the emulation thread
+			appPtr->runOnMainThread([](ApplicationContext ctx){ EmuApp::get(ctx).toggleKeyboard(); });
+		}
 	}
 	else
 	{
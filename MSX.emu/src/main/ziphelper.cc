@@ -24,6 +24,9 @@
 #include "ziphelper.h"
 #include "MainSystem.hh"
 #include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <vector>
 
 namespace EmuEx
 {
@@ -36,9 +39,71 @@ static struct archive *writeArch{};
 static FS::ArchiveIterator cachedZipIt{};
 static FS::PathString cachedZipName{};
 
+// Archive used in place of a zip file named memoryStatePath, stored as a sequence of
+// [name size][name][data size][data] entries with 32-bit sizes
+static std::vector<uint8_t> memWriteData;
+static std::span<const uint8_t> memReadData;
+static bool writingMemArchive{};
+
+static bool isMemoryArchive(const char *zipName)
+{
+	return zipName && std::string_view{zipName} == memoryStatePath;
+}
+
+static void appendMemArchive(const void *data, size_t size)
+{
+	auto bytes = (const uint8_t*)data;
+	memWriteData.insert(memWriteData.end(), bytes, bytes + size);
+}
+
+static void *loadFromMemArchive(const char* fileName, int* size)
+{
+	auto data = memReadData;
+	auto readSize = [&]() -> std::optional<uint32_t>
+	{
+		uint32_t s;
+		if(data.size() < sizeof(s))
+			return {};
+		memcpy(&s, data.data(), sizeof(s));
+		data = data.subspan(sizeof(s));
+		return s;
+	};
+	while(data.size())
+	{
+		auto nameSize = readSize();
+		if(!nameSize || *nameSize > data.size())
+			break;
+		std::string_view name{(const char*)data.data(), *nameSize};
+		data = data.subspan(*nameSize);
+		auto dataSize = readSize();
+		if(!dataSize || *dataSize > data.size())
+			break;
+		if(name == fileName)
+		{
+			void *buff = malloc(*dataSize);
+			memcpy(buff, data.data(), *dataSize);
+			*size = *dataSize;
+			return buff;
+		}
+		data = data.subspan(*dataSize);
+	}
+	logErr("file %s not in memory state", fileName);
+	return nullptr;
+}
+
+std::span<const uint8_t> zipMemoryWriteData()
+{
+	return memWriteData;
+}
+
+void zipSetMemoryReadData(std::span<const uint8_t> data)
+{
+	memReadData = data;
+}
+
 void zipCacheReadOnlyZip(const char* zipName)
 {
-	if(zipName && strlen(zipName))
+	if(zipName && strlen(zipName) && !isMemoryArchive(zipName))
 	{
 		logMsg("setting cached read zip archive:%s", zipName);
 		cachedZipIt = {EmuEx::gAppContext().openFileUri(zipName)};
@@ -79,6 +144,8 @@ static void *loadFromArchiveIt(FS::ArchiveIterator &it, const char* zipName, con
 
 void* zipLoadFile(const char* zipName, const char* fileName, int* size)
 {
+	if(isMemoryArchive(zipName))
+		return loadFromMemArchive(fileName, size);
 	try
 	{
 		if(cachedZipIt.hasEntry() && cachedZipName == zipName)
@@ -101,7 +168,13 @@ void* zipLoadFile(const char* zipName, const char* fileName, int* size)
 
 bool zipStartWrite(const char *fileName)
 {
-	assert(!writeArch);
+	assert(!writeArch && !writingMemArchive);
+	if(isMemoryArchive(fileName))
+	{
+		memWriteData.clear();
+		writingMemArchive = true;
+		return true;
+	}
 	writeArch = archive_write_new();
 	archive_write_set_format_zip(writeArch);
 	int fd = EmuEx::gAppContext().openFileUriFd(fileName, OpenFlagsMask::NEW | OpenFlagsMask::TEST).release();
@@ -118,6 +191,15 @@ bool zipStartWrite(const char *fileName)
 
 int zipSaveFile(const char* zipName, const char* fileName, int append, const void* buffer, int size)
 {
+	if(writingMemArchive)
+	{
+		uint32_t nameSize = strlen(fileName), dataSize = size;
+		appendMemArchive(&nameSize, sizeof(nameSize));
+		appendMemArchive(fileName, nameSize);
+		appendMemArchive(&dataSize, sizeof(dataSize));
+		appendMemArchive(buffer, dataSize);
+		return 1;
+	}
 	assert(writeArch);
 	auto entry = archive_entry_new();
 	auto freeEntry = IG::scopeGuard([&](){ archive_entry_free(entry); });
@@ -140,6 +222,11 @@ int zipSaveFile(const char* zipName, const char* fileName, int append, const voi
 
 void zipEndWrite()
 {
+	if(writingMemArchive)
+	{
+		writingMemArchive = false;
+		return;
+	}
 	assert(writeArch);
 	archive_write_close(writeArch);
 	archive_write_free(writeArch);
@@ -491,7 +491,31 @@ static gzFile open_state(void *contextPtr, const char *st_name, int mode) {
 	return open_stateWithName(st_name, mode);
 }*/
 
+/* When gzf is NULL, state data goes to/from this memory buffer instead */
+static Uint8 *memStatePos, *memStateEnd;
+static int memStateOverflow;
+static int memStateMeasure;
+
+static int mkstate_mem(void *data,int size,int mode) {
+	if (!memStatePos) { /* only measuring the state size */
+		memStateMeasure += size;
+		return size;
+	}
+	if (memStateEnd - memStatePos < size) {
+		memStateOverflow = 1;
+		return 0;
+	}
+	if (mode==STREAD)
+		memcpy(data, memStatePos, size);
+	else
+		memcpy(memStatePos, data, size);
+	memStatePos += size;
+	return size;
+}
+
 int mkstate_data(gzFile gzf,void *data,int size,int mode) {
+	if (!gzf)
+		return mkstate_mem(data,size,mode);
 	if (mode==STREAD)
 		return gzread(gzf,data,size);
 	return gzwrite(gzf,data,size);
@@ -553,8 +577,7 @@ int save_stateWithName(void *contextPtr, const char *name) {
 	return true;
 }
 
-int load_stateWithName(void *contextPtr, const char *name) {
-	gzFile gzf;
+static void neogeo_load_mkstate(gzFile gzf) {
 	/* Save pointers */
 	Uint8 *ng_lo = memory.ng_lo;
 	Uint8 *fix_game_usage=memory.fix_game_usage;
@@ -562,11 +585,6 @@ int load_stateWithName(void *contextPtr, const char *name) {
 	int *bksw_offset=memory.bksw_offset;
 //	GAME_ROMS r;
 //	memcpy(&r,&memory.rom,sizeof(GAME_ROMS));
-	
-	if ((gzf = open_state(contextPtr, name, STREAD))==NULL)
-		return false;
-
-	//gzread(gzf,state_img_tmp->pixels,304*224*2);
 
 	neogeo_mkstate(gzf,STREAD);
 
@@ -599,10 +617,53 @@ int load_stateWithName(void *contextPtr, const char *name) {
 		current_fix = memory.rom.bios_sfix.p;
 		fix_usage = memory.fix_board_usage;
 	}
+}
+
+int load_stateWithName(void *contextPtr, const char *name) {
+	gzFile gzf;
+
+	if ((gzf = open_state(contextPtr, name, STREAD))==NULL)
+		return false;
+
+	//gzread(gzf,state_img_tmp->pixels,304*224*2);
+
+	neogeo_load_mkstate(gzf);
 
 	gzclose(gzf);
 	return true;
 }
+
+/* Memory buffer states skip the file header since they never leave the running process */
+
+int save_stateToMem(Uint8 *buff, int size) {
+	if (!buff)
+		return -1;
+	memStatePos = buff;
+	memStateEnd = buff + size;
+	memStateOverflow = 0;
+	neogeo_mkstate(NULL,STWRITE);
+	if (memStateOverflow)
+		return -1;
+	return memStatePos - buff;
+}
+
+int load_stateFromMem(const Uint8 *buff, int size) {
+	if (!buff)
+		return false;
+	memStatePos = (Uint8*)buff;
+	memStateEnd = memStatePos + size;
+	memStateOverflow = 0;
+	neogeo_load_mkstate(NULL);
+	return !memStateOverflow;
+}
+
+int state_size(void) {
+	memStatePos = memStateEnd = NULL;
+	memStateMeasure = 0;
+	memStateOverflow = 0;
+	neogeo_mkstate(NULL,STWRITE);
+	return memStateMeasure;
+}
 #endif
 
 #if 0
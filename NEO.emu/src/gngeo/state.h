@@ -92,6 +92,9 @@ void set_post_load_function(ST_MODULE_TYPE module,void (*func)(void));
 //SDL_Surface *load_state_img(char *game,int slot);
 int save_stateWithName(void *contextPtr, const char *name);
 int load_stateWithName(void *contextPtr, const char *name);
+int save_stateToMem(Uint8 *buff, int size);
+int load_stateFromMem(const Uint8 *buff, int size);
+int state_size(void);
 Uint32 how_many_slot(char *game);
 int mkstate_data(gzFile gzf,void *data,int size,int mode);
 gzFile gzopenHelper(void *contextPtr, const char *filename, const char *mode);
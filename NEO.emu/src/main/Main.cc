@@ -162,6 +162,22 @@ void NeoSystem::loadState(EmuApp &app, IG::CStringView path)
 		return EmuSystem::throwFileReadError();
 }
 
+size_t NeoSystem::stateSize() { return state_size(); }
+
+void NeoSystem::readState(EmuApp &, std::span<const uint8_t> buff)
+{
+	if(!load_stateFromMem(buff.data(), buff.size()))
+		throw std::runtime_error("Invalid state data");
+}
+
+size_t NeoSystem::writeState(std::span<uint8_t> buff)
+{
+	auto size = save_stateToMem(buff.data(), buff.size());
+	if(size == -1)
+		throw std::runtime_error("State data exceeds buffer size");
+	return size;
+}
+
 static auto nvramPath(EmuSystem &sys)
 {
 	return sys.contentSaveFilePath(".nv");
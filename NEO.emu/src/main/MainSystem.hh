@@ -80,6 +80,9 @@ public:
 	void onOptionsLoaded();
 	bool resetSessionOptions(EmuApp &);
 	void onFlushBackupMemory(BackupMemoryDirtyFlags);
+	size_t stateSize();
+	void readState(EmuApp &, std::span<const uint8_t> buff);
+	size_t writeState(std::span<uint8_t> buff);
 	FS::FileString contentDisplayNameForPath(IG::CStringView path) const;
 };
 
@@ -29,6 +29,15 @@ EmuFileIO::EmuFileIO(IG::IO &srcIO):
 	}
 }
 
+EmuFileIO::EmuFileIO(IG::MapIO io_):
+	io{std::move(io_)}
+{
+	if(!io) [[unlikely]]
+	{
+		failbit = true;
+	}
+}
+
 void EmuFileIO::truncate(s32 length) {}
 
 int EmuFileIO::fgetc()
@@ -36,6 +45,20 @@ int EmuFileIO::fgetc()
 	return IG::fgetc(io);
 }
 
+int EmuFileIO::fputc(int c)
+{
+	uint8_t byte = c;
+	fwrite(&byte, 1);
+	return failbit ? EOF : byte;
+}
+
+void EmuFileIO::fwrite(const void *ptr, size_t bytes)
+{
+	// only writes in-place to the existing buffer
+	if(io.write(ptr, bytes) < (ssize_t)bytes)
+		failbit = true;
+}
+
 size_t EmuFileIO::_fread(const void *ptr, size_t bytes)
 {
 	ssize_t ret = io.read((void*)ptr, bytes);
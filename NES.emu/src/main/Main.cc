@@ -30,6 +30,7 @@
 #include <fceu/video.h>
 #include <fceu/sound.h>
 #include <fceu/x6502.h>
+#include <zlib.h>
 
 void ApplyDeemphasisComplete(pal* pal512);
 void FCEU_setDefaultPalettePtr(pal *ptr);
@@ -53,6 +54,7 @@ bool EmuSystem::hasPALVideoSystem = true;
 double EmuSystem::staticFrameTime = 16777215./ 1008307711.; // ~60.099Hz
 double EmuSystem::staticPalFrameTime = 16777215. / 838977920.; // ~50.00Hz
 bool EmuSystem::hasResetModes = true;
+bool EmuSystem::hasStereoSound = false;
 bool EmuApp::needsGlobalInstance = true;
 unsigned fceuCheats = 0;
 
@@ -125,6 +127,29 @@ void NesSystem::loadState(EmuApp &app, IG::CStringView path)
 		EmuSystem::throwFileReadError();
 }
 
+size_t NesSystem::stateSize()
+{
+	EMUFILE_MEMORY file;
+	if(!FCEUSS_SaveMS(&file, Z_NO_COMPRESSION))
+		return 0;
+	return file.size();
+}
+
+void NesSystem::readState(EmuApp &, std::span<const uint8_t> buff)
+{
+	EmuFileIO file{MapIO{IOBuffer{{const_cast<uint8_t*>(buff.data()), buff.size()}}}};
+	if(!FCEUSS_LoadFP(&file, SSLOADPARAM_NOBACKUP))
+		throw std::runtime_error{"Invalid state data"};
+}
+
+size_t NesSystem::writeState(std::span<uint8_t> buff)
+{
+	EmuFileIO file{MapIO{IOBuffer{buff}}};
+	if(!FCEUSS_SaveMS(&file, Z_NO_COMPRESSION) || file.fail())
+		throw std::runtime_error{"State data exceeds buffer size"};
+	return file.ftell();
+}
+
 void NesSystem::onFlushBackupMemory(BackupMemoryDirtyFlags)
 {
 	if(!hasContent())
@@ -395,12 +420,12 @@ void NesSystem::renderVideo(EmuSystemTaskContext taskCtx, EmuVideo &video, uint8
 	assumeExpr(pix.size() == ppuPixRegion.size());
 	if(pix.format() == IG::PIXEL_RGB565)
 	{
-		pix.writeTransformed([&](uint8 p){ return nativeCol.col16[p]; }, ppuPixRegion);
+		pix.writeIndexed<uint16_t>(nativeCol.col16, ppuPixRegion);
 	}
 	else
 	{
 		assumeExpr(pix.format().bytesPerPixel() == 4);
-		pix.writeTransformed([&](uint8 p){ return nativeCol.col32[p]; }, ppuPixRegion);
+		pix.writeIndexed<uint32_t>(nativeCol.col32, ppuPixRegion);
 	}
 	img.endFrame();
 }
@@ -27,10 +27,7 @@ public:
 	NesSystem nesSystem;
 
 	NesApp(ApplicationInitParams initParams, ApplicationContext &ctx):
-		EmuApp{initParams, ctx}, nesSystem{ctx}
-	{
-		audio().setStereo(false);
-	}
+		EmuApp{initParams, ctx}, nesSystem{ctx} {}
 
 	auto &system() { return nesSystem;  }
 	const auto &system() const { return nesSystem;  }
@@ -75,6 +75,13 @@ void NgpSystem::loadState(EmuApp &, IG::CStringView path)
 		throwFileReadError();
 }
 
+size_t NgpSystem::stateSize() { return stateSizeMDFN(); }
+void NgpSystem::readState(EmuApp &, std::span<const uint8_t> buff) { readStateMDFN(buff); }
+size_t NgpSystem::writeState(std::span<uint8_t> buff) { return writeStateMDFN(buff); }
+size_t NgpSystem::snapshotSize() { return stateSizeMDFN(true); }
+void NgpSystem::readSnapshot(EmuApp &, std::span<const uint8_t> buff) { readStateMDFN(buff, true); }
+size_t NgpSystem::writeSnapshot(std::span<uint8_t> buff) { return writeStateMDFN(buff, true); }
+
 static FS::PathString saveFilename(EmuSystem &sys)
 {
 	return sys.contentSaveFilePath(".ngf");
@@ -118,6 +125,11 @@ bool NgpSystem::onVideoRenderFormatChange(EmuVideo &, IG::PixelFormat fmt)
 	return false;
 }
 
+void NgpSystem::renderFramebuffer(EmuVideo &video)
+{
+	video.startFrameWithFormat({}, mSurfacePix);
+}
+
 void NgpSystem::configAudioRate(IG::FloatSeconds frameTime, int rate)
 {
 	auto soundRate = std::round(rate / staticFrameTime * frameTime.count());
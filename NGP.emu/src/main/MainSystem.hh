@@ -50,6 +50,13 @@ public:
 	void closeSystem();
 	void onFlushBackupMemory(BackupMemoryDirtyFlags);
 	bool onVideoRenderFormatChange(EmuVideo &, IG::PixelFormat);
+	void renderFramebuffer(EmuVideo &);
+	size_t stateSize();
+	void readState(EmuApp &, std::span<const uint8_t> buff);
+	size_t writeState(std::span<uint8_t> buff);
+	size_t snapshotSize();
+	void readSnapshot(EmuApp &, std::span<const uint8_t> buff);
+	size_t writeSnapshot(std::span<uint8_t> buff);
 };
 
 using MainSystem = NgpSystem;
@@ -89,6 +89,7 @@ void PceSystem::closeSystem()
 		delete CDInterfaces[0];
 		CDInterfaces.clear();
 	}
+	displayRect = {};
 }
 
 static void writeCDMD5(MDFNGI &mdfnGameInfo, CDInterface &cdInterface)
@@ -176,6 +177,18 @@ bool PceSystem::onVideoRenderFormatChange(EmuVideo &, IG::PixelFormat fmt)
 	return false;
 }
 
+void PceSystem::renderFramebuffer(EmuVideo &video)
+{
+	if(!displayRect.h)
+		return;
+	EmulateSpecStruct espec{};
+	espec.sys = this;
+	espec.video = &video;
+	espec.DisplayRect = displayRect;
+	espec.LineWidths = lineWidths.data();
+	MDFND_commitVideoFrame(&espec);
+}
+
 void PceSystem::configAudioRate(IG::FloatSeconds frameTime, int rate)
 {
 	const bool using263Lines = vce.CR & 0x04;
@@ -207,8 +220,7 @@ void PceSystem::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio
 	espec.skip = !video;
 	auto mSurface = pixmapToMDFNSurface(mSurfacePix);
 	espec.surface = &mSurface;
-	int32 lineWidth[242];
-	espec.LineWidths = lineWidth;
+	espec.LineWidths = lineWidths.data();
 	mdfnGameInfo.Emulate(&espec);
 	if(audio)
 	{
@@ -235,6 +247,13 @@ void PceSystem::loadState(EmuApp &, CStringView path)
 		throwFileReadError();
 }
 
+size_t PceSystem::stateSize() { return stateSizeMDFN(); }
+void PceSystem::readState(EmuApp &, std::span<const uint8_t> buff) { readStateMDFN(buff); }
+size_t PceSystem::writeState(std::span<uint8_t> buff) { return writeStateMDFN(buff); }
+size_t PceSystem::snapshotSize() { return stateSizeMDFN(true); }
+void PceSystem::readSnapshot(EmuApp &, std::span<const uint8_t> buff) { readStateMDFN(buff, true); }
+size_t PceSystem::writeSnapshot(std::span<uint8_t> buff) { return writeStateMDFN(buff, true); }
+
 double PceSystem::videoAspectRatioScale() const
 {
 	double baseLines = 224.;
@@ -348,6 +367,7 @@ static void renderMultiresOutput(EmulateSpecStruct spec, IG::PixmapView srcPix,
 void MDFND_commitVideoFrame(EmulateSpecStruct *espec)
 {
 	const auto spec = *espec;
+	static_cast<EmuEx::PceSystem&>(*spec.sys).displayRect = spec.DisplayRect;
 	int pixHeight = spec.DisplayRect.h;
 	bool uses256 = false;
 	bool uses341 = false;
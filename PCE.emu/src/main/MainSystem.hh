@@ -54,6 +54,8 @@ public:
 	static constexpr int vidBufferX = 512, vidBufferY = 242;
 	alignas(8) uint32_t pixBuff[vidBufferX*vidBufferY]{};
 	IG::MutablePixmapView mSurfacePix{};
+	std::array<int32, vidBufferY> lineWidths{};
+	Mednafen::MDFN_Rect displayRect{}; // of the last rendered frame
 	bool prevUsing263Lines{};
 	std::vector<CDInterface *> CDInterfaces;
 	FS::PathString sysCardPath{};
@@ -100,10 +102,17 @@ public:
 	void closeSystem();
 	void onFlushBackupMemory(BackupMemoryDirtyFlags);
 	bool onVideoRenderFormatChange(EmuVideo &, IG::PixelFormat);
+	void renderFramebuffer(EmuVideo &);
 	WP multiresVideoBaseSize() const;
 	void onSessionOptionsLoaded(EmuApp &);
 	bool resetSessionOptions(EmuApp &);
 	double videoAspectRatioScale() const;
+	size_t stateSize();
+	void readState(EmuApp &, std::span<const uint8_t> buff);
+	size_t writeState(std::span<uint8_t> buff);
+	size_t snapshotSize();
+	void readSnapshot(EmuApp &, std::span<const uint8_t> buff);
+	size_t writeSnapshot(std::span<uint8_t> buff);
 
 private:
 	void updateCdSettings();
@@ -25,7 +25,12 @@ SRC += main/Main.cc \
 main/input.cc \
 main/options.cc \
 main/EmuMenuViews.cc \
-main/EmuControls.cc
+main/EmuControls.cc \
+main/MDFNCD.cc
+
+ifdef emuFramework_headlessTest
+ SRC += tests/SH2LockstepTest.cc
+endif
 
 CPPFLAGS += -I$(projectPath)/src \
 -DHAVE_SYS_TIME_H=1 \
@@ -42,9 +47,16 @@ ifeq ($(ARCH), arm)
   yabause/sh2_dynarec/sh2_dynarec.c
  endif
 else ifeq ($(ARCH), x86_64)
- # TODO: x86_64 dynarec has 64/32-bit pointer conversion issues
- #CPPFLAGS += -DCPU_X64=1 -DUSE_DYNAREC=1 -DSH2_DYNAREC=1
- #SRC += yabause/sh2_dynarec/linkage_x64.s yabause/sh2_dynarec/sh2_dynarec.c
+ ifeq ($(ENV), linux)
+  # generated code references dynarec state with 32-bit operands so the
+  # executable must be linked below 2GB, falls back to the interpreter otherwise
+  CPPFLAGS += -DCPU_X64=1 \
+  -DUSE_DYNAREC=1 \
+  -DSH2_DYNAREC=1
+  LDFLAGS += -no-pie
+  SRC += yabause/sh2_dynarec/linkage_x64.s \
+  yabause/sh2_dynarec/sh2_dynarec.c
+ endif
 else ifeq ($(ARCH), x86)
  CPPFLAGS += -DCPU_X86=1 \
  -DUSE_DYNAREC=1 \
@@ -95,6 +107,16 @@ yabause/m68kq68.c
 CPPFLAGS += -DHAVE_Q68=1
 # TODO: -DQ68_USE_JIT=1
 
+# disc images are read through Mednafen's CD layer
+include $(EMUFRAMEWORK_PATH)/make/mednafenCommon.mk
+SRC += $(MDFN_CDROM_STANDALONE_SRC)
+VPATH += $(EMUFRAMEWORK_PATH)/src/shared
+CPPFLAGS += $(MDFN_COMMON_CPPFLAGS) \
+ $(MDFN_CDROM_CPPFLAGS) \
+ -DMDFN_CD_NO_CCD
+include $(IMAGINE_PATH)/make/package/libvorbis.mk
+include $(IMAGINE_PATH)/make/package/flac.mk
+
 include $(EMUFRAMEWORK_PATH)/package/emuframework.mk
 
 include $(IMAGINE_PATH)/make/imagineAppTarget.mk
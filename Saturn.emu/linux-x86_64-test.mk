@@ -0,0 +1,8 @@
+include $(IMAGINE_PATH)/make/config.mk
+-include $(projectPath)/config.mk
+# runs the system's tests instead of the app, exiting with a non-zero status on failure
+emuFramework_headlessTest := 1
+CPPFLAGS += -DCONFIG_EMUFRAMEWORK_HEADLESS_TEST
+target = $(metadata_exec)-test
+include $(IMAGINE_PATH)/make/linux-x86_64-gcc.mk
+include $(projectPath)/build.mk
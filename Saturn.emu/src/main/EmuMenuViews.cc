@@ -67,6 +67,32 @@ class CustomSystemOptionView : public SystemOptionView
 		sh2CoreItem
 	};
 
+	TextMenuItem renderThreadsItem[5]
+	{
+		{"Auto", &defaultFace(), setRenderThreadsDel(), 0},
+		{"1",    &defaultFace(), setRenderThreadsDel(), 1},
+		{"2",    &defaultFace(), setRenderThreadsDel(), 2},
+		{"3",    &defaultFace(), setRenderThreadsDel(), 3},
+		{"4",    &defaultFace(), setRenderThreadsDel(), 4},
+	};
+
+	MultiChoiceMenuItem renderThreads
+	{
+		"Render Threads", &defaultFace(),
+		(MenuItem::Id)optionRenderThreads.val,
+		renderThreadsItem
+	};
+
+	TextMenuItem::SelectDelegate setRenderThreadsDel()
+	{
+		return [this](TextMenuItem &item)
+		{
+			optionRenderThreads = item.id();
+			app().syncEmulationThread();
+			setRenderThreads(item.id());
+		};
+	}
+
 public:
 	CustomSystemOptionView(ViewAttachParams attach): SystemOptionView{attach, true}
 	{
@@ -87,6 +113,7 @@ public:
 		}
 		biosPath.setName(biosMenuEntryStr(appContext().fileUriDisplayName(EmuEx::biosPath)));
 		item.emplace_back(&biosPath);
+		item.emplace_back(&renderThreads);
 	}
 };
 
@@ -0,0 +1,120 @@
+/*  This file is part of Saturn.emu.
+
+	Saturn.emu is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Saturn.emu is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Saturn.emu.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "MDFNCD"
+#include "MainSystem.hh"
+#include <mednafen/mednafen.h>
+#include <mednafen/cdrom/CDInterface.h>
+#include <imagine/logger/logger.h>
+#include <cstring>
+
+// Yabause CD core reading disc images through Mednafen's CD layer, supporting the same
+// CUE/TOC/CHD/ISO/BIN images as the other CD systems. Sectors are read on the
+// CDInterface_MT thread, which reads ahead of sequential accesses & is hinted by ReadAheadFAD().
+
+namespace Mednafen
+{
+
+bool MDFN_GetSettingB(const char *name) { return 0; }
+
+}
+
+static int MDFNCDInit(const char *);
+static void MDFNCDDeInit();
+static int MDFNCDGetStatus();
+static s32 MDFNCDReadTOC(u32 *);
+static int MDFNCDReadSectorFAD(u32, void *);
+static void MDFNCDReadAheadFAD(u32);
+
+CDInterface MDFNCD
+{
+	CDCORE_MDFN,
+	"Mednafen CD Image",
+	MDFNCDInit,
+	MDFNCDDeInit,
+	MDFNCDGetStatus,
+	MDFNCDReadTOC,
+	MDFNCDReadSectorFAD,
+	MDFNCDReadAheadFAD,
+};
+
+static Mednafen::CDInterface *cdImage{};
+
+static constexpr int32 fadToLBA(u32 fad) { return int32(fad) - 150; }
+static constexpr u32 lbaToFAD(int32 lba) { return lba + 150; }
+
+static int MDFNCDInit(const char *path)
+{
+	try
+	{
+		cdImage = Mednafen::CDInterface::Open(&Mednafen::NVFS, path, false, 0);
+	}
+	catch(std::exception &err)
+	{
+		logErr("error opening %s:%s", path, err.what());
+		return -1;
+	}
+	return 0;
+}
+
+static void MDFNCDDeInit()
+{
+	delete cdImage;
+	cdImage = {};
+}
+
+static int MDFNCDGetStatus()
+{
+	return cdImage ? 0 : 2;
+}
+
+static s32 MDFNCDReadTOC(u32 *TOC)
+{
+	memset(TOC, 0xFF, 0xCC * 2);
+	if(!cdImage)
+		return 0xCC * 2;
+	Mednafen::CDUtility::TOC toc;
+	cdImage->ReadTOC(&toc);
+	auto ctlAddr = [&](int track) -> u32 { return (toc.tracks[track].control << 4) | toc.tracks[track].adr; };
+	for(int track = toc.first_track; track <= toc.last_track; track++)
+	{
+		TOC[track - 1] = (ctlAddr(track) << 24) | lbaToFAD(toc.tracks[track].lba);
+	}
+	TOC[99] = (ctlAddr(toc.first_track) << 24) | (toc.first_track << 16);
+	TOC[100] = (ctlAddr(toc.last_track) << 24) | (toc.last_track << 16);
+	TOC[101] = (ctlAddr(toc.last_track) << 24) | lbaToFAD(toc.tracks[100].lba);
+	return 0xCC * 2;
+}
+
+static int MDFNCDReadSectorFAD(u32 FAD, void *buffer)
+{
+	auto buff = (uint8*)buffer;
+	if(!cdImage || !cdImage->ReadRawSector(buff, fadToLBA(FAD)))
+	{
+		memset(buffer, 0, 2448);
+		return 0;
+	}
+	// Mednafen returns interleaved P-W subchannel data, the CD block expects R-W packs so leave it
+	// empty like the ISO core does for images without subchannel data
+	memset(buff + 2352, 0, 96);
+	return 1;
+}
+
+static void MDFNCDReadAheadFAD(u32 FAD)
+{
+	if(!cdImage)
+		return;
+	cdImage->HintReadSector(fadToLBA(FAD));
+}
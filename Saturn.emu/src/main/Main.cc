@@ -17,8 +17,12 @@
 #include <emuframework/EmuSystemInlines.hh>
 #include <emuframework/EmuAppInlines.hh>
 #include <imagine/fs/FS.hh>
+#include <imagine/io/MapIO.hh>
+#include <imagine/util/memory/UniqueFileStream.hh>
 #include <imagine/util/format.hh>
 #include <imagine/util/string.h>
+#include <imagine/thread/Semaphore.hh>
+#include <thread>
 
 extern "C"
 {
@@ -53,6 +57,7 @@ CDInterface *CDCoreList[] =
 {
 	&DummyCD,
 	&ISOCD,
+	&MDFNCD,
 	nullptr
 };
 
@@ -149,7 +154,7 @@ PerPad_struct *pad[2];
 
 static bool hasCDExtension(std::string_view name)
 {
-	return IG::stringEndsWithAny(name, ".cue", ".iso", ".bin", ".CUE", ".ISO", ".BIN");
+	return IG::stringEndsWithAny(name, ".cue", ".chd", ".toc", ".iso", ".bin", ".CUE", ".CHD", ".TOC", ".ISO", ".BIN");
 }
 
 bool hasBIOSExtension(std::string_view name)
@@ -174,7 +179,7 @@ yabauseinit_struct yinit
 	#else
 	M68KCORE_C68K,
 	#endif
-	CDCORE_ISO,
+	CDCORE_MDFN,
 	CART_NONE,
 	REGION_AUTODETECT,
 	biosPath.data(),
@@ -224,6 +229,99 @@ CLINK void YuiSwapBuffers()
 	}
 }
 
+void SaturnSystem::renderFramebuffer(EmuVideo &video)
+{
+	int height, width;
+	VIDCore->GetGlSize(&width, &height);
+	video.startFrameWithAltFormat({}, {{{width, height}, pixFmt}, dispbuffer});
+}
+
+// Splits the software renderer's VDP2 line drawing between the emulation thread & a set of workers
+class LineRenderPool
+{
+public:
+	~LineRenderPool() { stop(); }
+
+	void setThreads(int threads)
+	{
+		stop();
+		quit = false;
+		for(auto i : iotaCount(std::max(threads - 1, 0)))
+		{
+			auto &w = *workers.emplace_back(std::make_unique<Worker>());
+			w.thread = std::thread{[this, &w]()
+			{
+				while(true)
+				{
+					w.start.acquire();
+					if(quit)
+						return;
+					func(w.startLine, w.endLine);
+					done.release();
+				}
+			}};
+		}
+		VIDSoftSetLineRunner(workers.size() ? runLines : nullptr);
+		logMsg("using %d render thread(s)", int(workers.size() + 1));
+	}
+
+	void run(VIDSoftLineFunc f, int lines)
+	{
+		func = f;
+		int bands = workers.size() + 1;
+		for(auto i : iotaCount(workers.size()))
+		{
+			auto &w = *workers[i];
+			w.startLine = lines * int(i + 1) / bands;
+			w.endLine = lines * int(i + 2) / bands;
+			w.start.release();
+		}
+		f(0, lines / bands);
+		for([[maybe_unused]] auto &w : workers)
+		{
+			done.acquire();
+		}
+	}
+
+private:
+	struct Worker
+	{
+		std::thread thread;
+		std::binary_semaphore start{0};
+		int startLine{}, endLine{};
+	};
+
+	std::vector<std::unique_ptr<Worker>> workers;
+	std::counting_semaphore<> done{0};
+	VIDSoftLineFunc func{};
+	std::atomic_bool quit{};
+
+	void stop()
+	{
+		VIDSoftSetLineRunner(nullptr);
+		quit = true;
+		for(auto &w : workers)
+		{
+			w->start.release();
+			w->thread.join();
+		}
+		workers.clear();
+	}
+
+	static void runLines(VIDSoftLineFunc f, int lines);
+};
+
+static LineRenderPool renderPool;
+
+void LineRenderPool::runLines(VIDSoftLineFunc f, int lines) { renderPool.run(f, lines); }
+
+void setRenderThreads(int threads)
+{
+	if(!threads)
+		threads = std::clamp(int(std::thread::hardware_concurrency()) - 1, 1, maxRenderThreads);
+	renderPool.setThreads(threads);
+}
+
 CLINK void YuiSetVideoAttribute(int type, int val) { }
 CLINK int YuiSetVideoMode(int width, int height, int bpp, int fullscreen) { return 0; }
 
@@ -267,6 +365,37 @@ void SaturnSystem::loadState(EmuApp &, IG::CStringView path)
 		throwFileReadError();
 }
 
+size_t SaturnSystem::stateSize()
+{
+	return saveStateSize;
+}
+
+void SaturnSystem::readState(EmuApp &, std::span<const uint8_t> buff)
+{
+	MapIO io{IOBuffer{{const_cast<uint8_t*>(buff.data()), buff.size()}}};
+	UniqueFileStream f{io.toFileStream("rb")};
+	if(YabLoadStateStream(f.get()) != 0)
+		throw std::runtime_error{"Invalid state data"};
+}
+
+size_t SaturnSystem::writeState(std::span<uint8_t> buff)
+{
+	auto size = writeStateStream(buff);
+	if(!size)
+		throw std::runtime_error{"State data exceeds buffer size"};
+	return size;
+}
+
+// Returns 0 if the state doesn't fit in the buffer
+size_t SaturnSystem::writeStateStream(std::span<uint8_t> buff)
+{
+	MapIO io{IOBuffer{buff}};
+	UniqueFileStream f{io.toFileStream("wb")};
+	if(YabSaveStateStream(f.get()) != 0 || fflush(f.get()) != 0)
+		return 0;
+	return ftell(f.get());
+}
+
 void SaturnSystem::onFlushBackupMemory(BackupMemoryDirtyFlags)
 {
 	if(hasContent())
@@ -285,6 +414,7 @@ void SaturnSystem::closeSystem()
 		YabauseDeInit();
 		yabauseIsInit = 0;
 	}
+	saveStateSize = 0;
 }
 
 void SaturnSystem::loadContent(IO &, EmuSystemCreateParams, OnLoadProgressDelegate)
@@ -297,11 +427,22 @@ void SaturnSystem::loadContent(IO &, EmuSystemCreateParams, OnLoadProgressDelega
 	}
 	logMsg("YabauseInit done");
 	yabauseIsInit = 1;
+	if(optionSH2Core != yinit.sh2coretype)
+	{
+		// core init fell back to another core, keep the option & menu in sync with it
+		logWarn("using SH2 core:%s instead of requested ID:%d", SH2Core->Name, int(optionSH2Core));
+		optionSH2Core = yinit.sh2coretype;
+	}
 
 	PerPortReset();
 	pad[0] = PerPadAdd(&PORTDATA1);
 	pad[1] = PerPadAdd(&PORTDATA2);
 	ScspSetFrameAccurate(1);
+	// size depends on the cartridge type so measure it once with a test save
+	constexpr size_t maxStateSize = 16 * 1024 * 1024;
+	auto buff = std::make_unique<uint8_t[]>(maxStateSize);
+	saveStateSize = writeStateStream({buff.get(), maxStateSize});
+	logMsg("state size:%zu", saveStateSize);
 }
 
 void SaturnSystem::configAudioRate(IG::FloatSeconds frameTime, int rate)
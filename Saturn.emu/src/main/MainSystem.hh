@@ -8,6 +8,7 @@ extern "C"
 	#include <yabause/yabause.h>
 	#include <yabause/sh2core.h>
 	#include <yabause/peripheral.h>
+	#include <yabause/cdbase.h>
 }
 
 namespace EmuEx::Controls
@@ -16,12 +17,14 @@ static const unsigned gamepadKeys = 23;
 }
 
 extern const int defaultSH2CoreID;
+extern CDInterface MDFNCD;
 extern SH2Interface_struct *SH2CoreList[];
 
 namespace EmuEx
 {
 
 extern Byte1Option optionSH2Core;
+extern Byte1Option optionRenderThreads;
 extern FS::PathString biosPath;
 extern unsigned SH2Cores;
 extern yabauseinit_struct yinit;
@@ -56,10 +59,22 @@ public:
 	void closeSystem();
 	void onFlushBackupMemory(BackupMemoryDirtyFlags);
 	void onOptionsLoaded();
+	void renderFramebuffer(EmuVideo &);
+	size_t stateSize();
+	void readState(EmuApp &, std::span<const uint8_t> buff);
+	size_t writeState(std::span<uint8_t> buff);
+
+private:
+	size_t saveStateSize{};
+
+	static size_t writeStateStream(std::span<uint8_t> buff);
 };
 
 using MainSystem = SaturnSystem;
 
 bool hasBIOSExtension(std::string_view name);
 
+constexpr int maxRenderThreads = 4;
+void setRenderThreads(int threads); // 0 picks a count based on the CPU
+
 }
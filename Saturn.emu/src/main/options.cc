@@ -36,7 +36,8 @@ namespace EmuEx
 
 enum
 {
-	CFGKEY_BIOS_PATH = 279, CFGKEY_SH2_CORE = 280
+	CFGKEY_BIOS_PATH = 279, CFGKEY_SH2_CORE = 280,
+	CFGKEY_RENDER_THREADS = 281
 };
 
 static bool OptionSH2CoreIsValid(uint8_t val)
@@ -55,6 +56,7 @@ static bool OptionSH2CoreIsValid(uint8_t val)
 
 const char *EmuSystem::configFilename = "SaturnEmu.config";
 Byte1Option optionSH2Core{CFGKEY_SH2_CORE, (uint8_t)defaultSH2CoreID, false, OptionSH2CoreIsValid};
+Byte1Option optionRenderThreads{CFGKEY_RENDER_THREADS, 0, false, optionIsValidWithMax<maxRenderThreads>};
 unsigned SH2Cores = std::size(SH2CoreList) - 1;
 bool EmuApp::hasIcon = false;
 bool EmuApp::autoSaveStateDefault = false;
@@ -75,6 +77,7 @@ std::span<const AspectRatioInfo> SaturnSystem::aspectRatioInfos()
 void SaturnSystem::onOptionsLoaded()
 {
 	yinit.sh2coretype = optionSH2Core;
+	setRenderThreads(optionRenderThreads);
 }
 
 bool SaturnSystem::readConfig(ConfigType type, MapIO &io, unsigned key, size_t readSize)
@@ -86,6 +89,7 @@ bool SaturnSystem::readConfig(ConfigType type, MapIO &io, unsigned key, size_t r
 			case CFGKEY_BIOS_PATH:
 				return readStringOptionValue(io, readSize, biosPath);
 			case CFGKEY_SH2_CORE: return optionSH2Core.readFromIO(io, readSize);
+			case CFGKEY_RENDER_THREADS: return optionRenderThreads.readFromIO(io, readSize);
 		}
 	}
 	return false;
@@ -97,6 +101,7 @@ void SaturnSystem::writeConfig(ConfigType type, FileIO &io)
 	{
 		writeStringOptionValue(io, CFGKEY_BIOS_PATH, biosPath);
 		optionSH2Core.writeWithKeyIfNotDefault(io);
+		optionRenderThreads.writeWithKeyIfNotDefault(io);
 	}
 }
 
@@ -0,0 +1,306 @@
+/*  This file is part of Saturn.emu.
+
+	Saturn.emu is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Saturn.emu is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Saturn.emu.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "SH2LockstepTest"
+#include <main/MainSystem.hh>
+#include <imagine/logger/logger.h>
+#include <imagine/util/ranges.hh>
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+extern "C"
+{
+	#include <yabause/memory.h>
+	#include <yabause/sh2int.h>
+	#include <yabause/sh2_dynarec/sh2_dynarec.h>
+}
+
+// Runs randomly generated SH2 programs on the interpreter & the dynarec from the same starting
+// state and compares the results. The dynarec only executes whole frames so each generated
+// block ends by pushing its registers to a log in work RAM, giving a per-block trace to diff.
+
+using namespace IG;
+
+namespace
+{
+
+constexpr uint32_t programAddress = 0x06004000;
+constexpr uint32_t scratchAddress = 0x06070000; // r9, target of generated loads & stores
+constexpr uint32_t logEndAddress = 0x06080000; // r8, pre-decremented by each register dump
+constexpr int blocks = 48;
+constexpr int opsPerBlock = 12;
+constexpr int loggedRegs = 8; // r0-r7 are the only registers the generated ops touch
+constexpr int logWordsPerBlock = loggedRegs + 2; // plus SR & MACL
+constexpr int seeds = 16;
+
+struct ProgramBuilder
+{
+	std::vector<uint16_t> code;
+	std::minstd_rand rng;
+
+	ProgramBuilder(unsigned seed): rng{seed} {}
+
+	int reg() { return rng() % loggedRegs; }
+
+	void op(uint16_t o) { code.push_back(o); }
+	void opNM(uint16_t base, int n, int m) { op(base | (n << 8) | (m << 4)); }
+	void opN(uint16_t base, int n) { op(base | (n << 8)); }
+
+	// single instruction that's valid in a delay slot
+	void aluOp()
+	{
+		int n = reg(), m = reg();
+		switch(rng() % 24)
+		{
+			case 0: return opNM(0x6003, n, m); // mov Rm,Rn
+			case 1: return op(0xE000 | (n << 8) | (rng() & 0xFF)); // mov #imm,Rn
+			case 2: return opNM(0x300C, n, m); // add Rm,Rn
+			case 3: return op(0x7000 | (n << 8) | (rng() & 0xFF)); // add #imm,Rn
+			case 4: return opNM(0x300E, n, m); // addc Rm,Rn
+			case 5: return opNM(0x3008, n, m); // sub Rm,Rn
+			case 6: return opNM(0x300A, n, m); // subc Rm,Rn
+			case 7: return opNM(0x2009, n, m); // and Rm,Rn
+			case 8: return opNM(0x200B, n, m); // or Rm,Rn
+			case 9: return opNM(0x200A, n, m); // xor Rm,Rn
+			case 10: return opNM(0x6007, n, m); // not Rm,Rn
+			case 11: return opNM(0x600B, n, m); // neg Rm,Rn
+			case 12: return opNM(0x600C, n, m); // extu.b Rm,Rn
+			case 13: return opNM(0x600F, n, m); // exts.w Rm,Rn
+			case 14: return opNM(0x6009, n, m); // swap.w Rm,Rn
+			case 15: return opN(0x4000, n); // shll Rn
+			case 16: return opN(0x4021, n); // shar Rn
+			case 17: return opN(0x4025, n); // rotcr Rn
+			case 18: return opN(0x4019, n); // shlr8 Rn
+			case 19: return opN(0x4010, n); // dt Rn
+			case 20: return opNM(0x3007, n, m); // cmp/gt Rm,Rn
+			case 21: return opNM(0x3006, n, m); // cmp/hi Rm,Rn
+			case 22: return opNM(0x2008, n, m); // tst Rm,Rn
+			case 23: return opN(0x0029, n); // movt Rn
+		}
+	}
+
+	void anyOp()
+	{
+		switch(rng() % 8)
+		{
+			case 0: // mov.l Rm,@(disp,r9)
+				return op(0x1900 | (reg() << 4) | (rng() & 0xF));
+			case 1: // mov.l @(disp,r9),Rn
+				return op(0x5090 | (reg() << 8) | (rng() & 0xF));
+			case 2: // mov.b @(disp,r9),r0
+				return op(0x8490 | (rng() & 0xF));
+			case 3: // mul.l Rm,Rn, sts macl,Rn
+				opNM(0x0007, reg(), reg());
+				return opN(0x001A, reg());
+			case 4: // cmp/eq Rm,Rn, bt/bf over the next op
+				opNM(0x3000, reg(), reg());
+				op(rng() & 1 ? 0x8900 : 0x8B00);
+				return aluOp();
+			default:
+				return aluOp();
+		}
+	}
+
+	void registerDump()
+	{
+		for(auto r : iotaCount(loggedRegs))
+		{
+			opNM(0x2006, 8, r); // mov.l Rn,@-r8
+		}
+		opN(0x0002, 10); // stc sr,r10
+		opNM(0x2006, 8, 10);
+		opN(0x001A, 10); // sts macl,r10
+		opNM(0x2006, 8, 10);
+	}
+
+	// loads (addr >> 16) into the upper half of Rn
+	void loadHighAddress(int n, uint32_t addr)
+	{
+		opN(0xE000 | ((addr >> 24) & 0xFF), n); // mov #imm,Rn
+		opN(0x4018, n); // shll8 Rn
+		opN(0x7000 | ((addr >> 16) & 0xFF), n); // add #imm,Rn
+		opN(0x4028, n); // shll16 Rn
+	}
+
+	void build()
+	{
+		loadHighAddress(8, logEndAddress);
+		loadHighAddress(9, scratchAddress);
+		for([[maybe_unused]] auto b : iotaCount(blocks))
+		{
+			for([[maybe_unused]] auto i : iotaCount(opsPerBlock))
+			{
+				anyOp();
+			}
+			registerDump();
+			if(rng() & 1)
+			{
+				op(0xA000); // bra to the next block
+				aluOp(); // delay slot
+			}
+			else
+			{
+				op(rng() & 1 ? 0x8D00 : 0x8F00); // bt/s or bf/s to the next block
+				aluOp(); // delay slot, both paths fall into the next block
+			}
+		}
+		op(0xAFFE); // bra to self
+		op(0x0009); // nop
+	}
+};
+
+struct RunResult
+{
+	sh2regs_struct regs{};
+	std::vector<uint8_t> highWram;
+};
+
+sh2regs_struct initialRegs(unsigned seed)
+{
+	std::minstd_rand rng{seed * 7919u + 1};
+	sh2regs_struct regs{};
+	for(auto &r : regs.R)
+	{
+		r = rng() * 2654435761u;
+	}
+	regs.R[15] = 0x06002000;
+	regs.SR.all = 0xF0; // mask all interrupts
+	regs.MACH = rng();
+	regs.MACL = rng();
+	regs.PC = programAddress;
+	return regs;
+}
+
+RunResult runProgram(SH2Interface_struct &core, std::span<const uint16_t> code, const sh2regs_struct &regs)
+{
+	SH2Core = &core;
+	YabauseResetNoLoad();
+	for(auto i : iotaCount(code.size()))
+	{
+		MappedMemoryWriteWord(programAddress + i * 2, code[i]);
+	}
+	#ifdef SH2_DYNAREC
+	if(&core == &SH2Dynarec)
+		invalidate_all_pages(); // drop blocks compiled from the previous program
+	#endif
+	SH2Core->SetRegisters(MSH2, &regs);
+	YabauseEmulate();
+	RunResult res;
+	SH2Core->GetRegisters(MSH2, &res.regs);
+	res.highWram.assign(HighWram, HighWram + 0x100000);
+	return res;
+}
+
+bool compareRuns(unsigned seed, RunResult &interp, RunResult &dynarec)
+{
+	// the log is written downwards so block N's dump precedes block N-1's
+	auto readLog = [](RunResult &res, uint32_t addr) { return T2ReadLong(res.highWram.data(), addr & 0xFFFFF); };
+	static constexpr const char *slotNames[logWordsPerBlock]{"MACL", "SR", "r7", "r6", "r5", "r4", "r3", "r2", "r1", "r0"};
+	for(auto b : iotaCount(blocks))
+	{
+		uint32_t blockLog = logEndAddress - (b + 1) * logWordsPerBlock * 4;
+		for(auto w : iotaCount(logWordsPerBlock))
+		{
+			auto addr = blockLog + w * 4;
+			auto iVal = readLog(interp, addr), dVal = readLog(dynarec, addr);
+			if(iVal != dVal)
+			{
+				std::printf("seed %u: block %d %s differs, interpreter:0x%08X dynarec:0x%08X\n",
+					seed, int(b), slotNames[w], iVal, dVal);
+				return false;
+			}
+		}
+	}
+	auto &iR = interp.regs, &dR = dynarec.regs;
+	for(auto i : iotaCount(16))
+	{
+		if(iR.R[i] != dR.R[i])
+		{
+			std::printf("seed %u: final r%d differs, interpreter:0x%08X dynarec:0x%08X\n", seed, int(i), iR.R[i], dR.R[i]);
+			return false;
+		}
+	}
+	if(iR.SR.all != dR.SR.all || iR.GBR != dR.GBR || iR.VBR != dR.VBR ||
+		iR.MACH != dR.MACH || iR.MACL != dR.MACL || iR.PR != dR.PR)
+	{
+		std::printf("seed %u: final control registers differ, SR:0x%X/0x%X MACH:0x%X/0x%X MACL:0x%X/0x%X PR:0x%X/0x%X\n",
+			seed, iR.SR.all, dR.SR.all, iR.MACH, dR.MACH, iR.MACL, dR.MACL, iR.PR, dR.PR);
+		return false;
+	}
+	if(interp.highWram != dynarec.highWram)
+	{
+		auto diffIt = std::ranges::mismatch(interp.highWram, dynarec.highWram).in1;
+		std::printf("seed %u: work RAM differs at 0x%08X\n", seed,
+			unsigned(0x06000000 + (diffIt - interp.highWram.begin())));
+		return false;
+	}
+	return true;
+}
+
+}
+
+namespace EmuEx
+{
+
+bool runSystemTests(EmuSystem &)
+{
+	#ifdef SH2_DYNAREC
+	auto init = yinit;
+	init.sh2coretype = SH2Dynarec.id;
+	init.cdcoretype = CDCORE_DUMMY;
+	init.biospath = nullptr; // emulated BIOS
+	init.buppath = nullptr;
+	init.cdpath = nullptr;
+	// with the emulated BIOS & no disc, -2 only reports there's no game to boot
+	if(auto err = YabauseInit(&init); err != 0 && err != -2)
+	{
+		std::printf("SH2 interpreter/dynarec lockstep: FAILED, YabauseInit failed\n");
+		return false;
+	}
+	if(SH2Core != &SH2Dynarec)
+	{
+		std::printf("SH2 interpreter/dynarec lockstep: skipped, dynarec code cache unavailable\n");
+		YabauseDeInit();
+		return true;
+	}
+	SH2Interpreter.Init();
+	bool passed = true;
+	for(auto seed : iotaCount(seeds))
+	{
+		ProgramBuilder prog{unsigned(seed + 1)};
+		prog.build();
+		auto regs = initialRegs(seed);
+		auto interpRes = runProgram(SH2Interpreter, prog.code, regs);
+		auto dynarecRes = runProgram(SH2Dynarec, prog.code, regs);
+		if(!compareRuns(seed, interpRes, dynarecRes))
+		{
+			passed = false;
+			break;
+		}
+	}
+	SH2Core = &SH2Dynarec;
+	YabauseDeInit();
+	std::printf("SH2 interpreter/dynarec lockstep (%d programs, %d blocks each): %s\n",
+		seeds, blocks, passed ? "passed" : "FAILED");
+	return passed;
+	#else
+	std::printf("SH2 interpreter/dynarec lockstep: skipped, no dynarec in this build\n");
+	return true;
+	#endif
+}
+
+}
@@ -29,6 +29,7 @@
 #define CDCORE_DUMMY    0
 #define CDCORE_ISO      1
 #define CDCORE_ARCH     2
+#define CDCORE_MDFN     3
 
 typedef struct
 {
@@ -162,12 +162,13 @@ static INLINE int StateWriteHeader(FILE *fp, const char *name, int version) {
 static INLINE int StateFinishHeader(FILE *fp, int offset) {
    IOCheck_struct check;
    int size = 0;
-   size = ftell(fp) - offset;
+   int endpos = ftell(fp);
+   size = endpos - offset;
    fseek(fp, offset - 4, SEEK_SET);
    check.done = 0;
    check.size = 0;
    ywrite(&check, (void *)&size, sizeof(size), 1, fp); // write true size
-   fseek(fp, 0, SEEK_END);
+   fseek(fp, endpos, SEEK_SET); // stream may be a fixed size memory buffer so don't seek to its end
    return (check.done == check.size) ? (size + 12) : -1;
 }
 
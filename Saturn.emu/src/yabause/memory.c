@@ -992,10 +992,9 @@ void FormatBackupRam(void *mem, u32 size)
 //    [sh2core.c] frc.div changed to frc.shift
 //    [sh2core.c] wdt probably needs to be written as well
 
-int YabSaveState(const char *filename)
+int YabSaveStateStream(FILE *fp)
 {
    u32 i;
-   FILE *fp;
    int offset;
    IOCheck_struct check;
    u8 *buf;
@@ -1003,20 +1002,13 @@ int YabSaveState(const char *filename)
    int outputwidth;
    int outputheight;
    int movieposition;
+   int endposition;
    int temp;
    u32 temp32;
 
    check.done = 0;
    check.size = 0;
 
-   //use a second set of savestates for movies
-   filename = MakeMovieStateName(filename);
-   if (!filename)
-      return -1;
-
-   if ((fp = fopen(filename, "wb")) == NULL)
-      return -1;
-
    // Write signature
    fprintf(fp, "YSS");
 
@@ -1076,7 +1068,8 @@ int YabSaveState(const char *filename)
 
    totalsize=outputwidth * outputheight * sizeof(u32);
 
-   if ((buf = (u8 *)malloc(totalsize)) == NULL)
+   // zero-fill so the state data is deterministic without a readback from OpenGL
+   if ((buf = (u8 *)calloc(1, totalsize)) == NULL)
    {
       return -2;
    }
@@ -1100,25 +1093,44 @@ int YabSaveState(const char *filename)
    SaveMovieInState(fp, check);
 
    i += StateFinishHeader(fp, offset);
+   endposition = ftell(fp);
 
    // Go back and update size
    fseek(fp, 8, SEEK_SET);
    ywrite(&check, (void *)&i, sizeof(i), 1, fp);
    fseek(fp, 16, SEEK_SET);
    ywrite(&check, (void *)&movieposition, sizeof(movieposition), 1, fp);
+   fseek(fp, endposition, SEEK_SET);
+
+   return 0;
+}
+
+int YabSaveState(const char *filename)
+{
+   FILE *fp;
+   int ret;
+
+   //use a second set of savestates for movies
+   filename = MakeMovieStateName(filename);
+   if (!filename)
+      return -1;
+
+   if ((fp = fopen(filename, "wb")) == NULL)
+      return -1;
 
+   ret = YabSaveStateStream(fp);
    fclose(fp);
 
-   OSDPushMessage(OSDMSG_STATUS, 150, "STATE SAVED");
+   if (ret == 0)
+      OSDPushMessage(OSDMSG_STATUS, 150, "STATE SAVED");
 
-   return 0;
+   return ret;
 }
 
 //////////////////////////////////////////////////////////////////////////////
 
-int YabLoadState(const char *filename)
+int YabLoadStateStream(FILE *fp)
 {
-   FILE *fp;
    char id[3];
    u8 endian;
    int headerversion, version, size, chunksize, headersize;
@@ -1133,13 +1145,6 @@ int YabLoadState(const char *filename)
    int temp;
    u32 temp32;
 
-   filename = MakeMovieStateName(filename);
-   if (!filename)
-      return -1;
-
-   if ((fp = fopen(filename, "rb")) == NULL)
-      return -1;
-
    headersize = 0xC;
 
    // Read signature
@@ -1147,7 +1152,6 @@ int YabLoadState(const char *filename)
 
    if (strncmp(id, "YSS", 3) != 0)
    {
-      fclose(fp);
       return -2;
    }
 
@@ -1170,7 +1174,6 @@ int YabLoadState(const char *filename)
       default:
          /* we're trying to open a save state using a future version
           * of the YSS format, that won't work, sorry :) */
-         fclose(fp);
          return -3;
          break;
    }
@@ -1183,7 +1186,6 @@ int YabLoadState(const char *filename)
    {
       // should setup reading so it's byte-swapped
       YabSetError(YAB_ERR_OTHER, (void *)"Load State byteswapping not supported");
-      fclose(fp);
       return -3;
    }
 
@@ -1192,7 +1194,6 @@ int YabLoadState(const char *filename)
 
    if (size != (ftell(fp) - headersize))
    {
-      fclose(fp);
       return -2;
    }
    fseek(fp, headersize, SEEK_SET);
@@ -1203,7 +1204,6 @@ int YabLoadState(const char *filename)
    
    if (StateCheckRetrieveHeader(fp, "CART", &version, &chunksize) != 0)
    {
-      fclose(fp);
       // Revert back to old state here
       ScspUnMuteAudio(SCSP_MUTE_SYSTEM);
       return -3;
@@ -1212,7 +1212,6 @@ int YabLoadState(const char *filename)
 
    if (StateCheckRetrieveHeader(fp, "CS2 ", &version, &chunksize) != 0)
    {
-      fclose(fp);
       // Revert back to old state here
       ScspUnMuteAudio(SCSP_MUTE_SYSTEM);
       return -3;
@@ -1221,7 +1220,6 @@ int YabLoadState(const char *filename)
 
    if (StateCheckRetrieveHeader(fp, "MSH2", &version, &chunksize) != 0)
    {
-      fclose(fp);
       // Revert back to old state here
       ScspUnMuteAudio(SCSP_MUTE_SYSTEM);
       return -3;
@@ -1230,7 +1228,6 @@ int YabLoadState(const char *filename)
 
    if (StateCheckRetrieveHeader(fp, "SSH2", &version, &chunksize) != 0)
    {
-      fclose(fp);
       // Revert back to old state here
       ScspUnMuteAudio(SCSP_MUTE_SYSTEM);
       return -3;
@@ -1239,7 +1236,6 @@ int YabLoadState(const char *filename)
 
    if (StateCheckRetrieveHeader(fp, "SCSP", &version, &chunksize) != 0)
    {
-      fclose(fp);
       // Revert back to old state here
       ScspUnMuteAudio(SCSP_MUTE_SYSTEM);
       return -3;
@@ -1248,7 +1244,6 @@ int YabLoadState(const char *filename)
 
    if (StateCheckRetrieveHeader(fp, "SCU ", &version, &chunksize) != 0)
    {
-      fclose(fp);
       // Revert back to old state here
       ScspUnMuteAudio(SCSP_MUTE_SYSTEM);
       return -3;
@@ -1257,7 +1252,6 @@ int YabLoadState(const char *filename)
 
    if (StateCheckRetrieveHeader(fp, "SMPC", &version, &chunksize) != 0)
    {
-      fclose(fp);
       // Revert back to old state here
       ScspUnMuteAudio(SCSP_MUTE_SYSTEM);
       return -3;
@@ -1266,7 +1260,6 @@ int YabLoadState(const char *filename)
 
    if (StateCheckRetrieveHeader(fp, "VDP1", &version, &chunksize) != 0)
    {
-      fclose(fp);
       // Revert back to old state here
       ScspUnMuteAudio(SCSP_MUTE_SYSTEM);
       return -3;
@@ -1275,7 +1268,6 @@ int YabLoadState(const char *filename)
 
    if (StateCheckRetrieveHeader(fp, "VDP2", &version, &chunksize) != 0)
    {
-      fclose(fp);
       // Revert back to old state here
       ScspUnMuteAudio(SCSP_MUTE_SYSTEM);
       return -3;
@@ -1284,7 +1276,6 @@ int YabLoadState(const char *filename)
 
    if (StateCheckRetrieveHeader(fp, "OTHR", &version, &chunksize) != 0)
    {
-      fclose(fp);
       // Revert back to old state here
       ScspUnMuteAudio(SCSP_MUTE_SYSTEM);
       return -3;
@@ -1338,18 +1329,35 @@ int YabLoadState(const char *filename)
    YuiSwapBuffers();
 
    fseek(fp, movieposition, SEEK_SET);
-   MovieReadState(fp, filename);
+   MovieReadState(fp, NULL);
    }
-   
-   fclose(fp);
 
    ScspUnMuteAudio(SCSP_MUTE_SYSTEM);
 
-   OSDPushMessage(OSDMSG_STATUS, 150, "STATE LOADED");
-
    return 0;
 }
 
+int YabLoadState(const char *filename)
+{
+   FILE *fp;
+   int ret;
+
+   filename = MakeMovieStateName(filename);
+   if (!filename)
+      return -1;
+
+   if ((fp = fopen(filename, "rb")) == NULL)
+      return -1;
+
+   ret = YabLoadStateStream(fp);
+   fclose(fp);
+
+   if (ret == 0)
+      OSDPushMessage(OSDMSG_STATUS, 150, "STATE LOADED");
+
+   return ret;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
 int YabSaveStateSlot(const char *dirpath, u8 slot)
@@ -344,9 +344,8 @@ void SaveMovieInState(FILE* fp, IOCheck_struct check) {
 
 	struct MovieBufferStruct tempbuffer;
 
-	fseek(fp, 0, SEEK_END);
-
 	if(Movie.Status == Recording || Movie.Status == Playback) {
+		fseek(fp, 0, SEEK_END);
 		tempbuffer=ReadMovieIntoABuffer(Movie.fp);
 
 		fwrite(&tempbuffer.size, 4, 1, fp);
@@ -252,7 +252,7 @@ int isclean(pointer addr)
   return 1;
 }
 
-void get_bounds(pointer addr,u32 *start,u32 *end)
+void get_bounds(pointer addr,pointer *start,pointer *end)
 {
   u32 *ptr=(u32 *)addr;
   #ifndef HAVE_ARMv7
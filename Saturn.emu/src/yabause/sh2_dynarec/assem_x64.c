@@ -174,7 +174,7 @@ int isclean(pointer addr)
   return 0;
 }
 
-void get_bounds(pointer addr,u32 *start,u32 *end)
+void get_bounds(pointer addr,pointer *start,pointer *end)
 {
   u8 *ptr=(u8 *)addr;
   if(ptr[0]==0xB8) {
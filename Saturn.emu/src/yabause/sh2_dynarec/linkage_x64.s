@@ -22,6 +22,17 @@
 	.align 4
 	.section	.rodata
 	.text
+
+/* Calls into C from a stub jumped to by generated code. The master's code runs with
+   %rsp 8 bytes off the ABI alignment (the slave's doesn't) so realign around the call. */
+.macro	call_aligned func
+	push	%rsp
+	pushq	(%rsp)
+	and	$-16, %rsp
+	call	\func
+	mov	8(%rsp), %rsp
+.endm
+
 .globl YabauseDynarecOneFrameExec
 	.type	YabauseDynarecOneFrameExec, @function
 YabauseDynarecOneFrameExec:
@@ -322,7 +333,7 @@ dyna_linker:
 	mov	%esi, %ebp
 	lea	4(%ebx,%edi,1), %esi
 	mov	%eax, %edi
-	call	add_link
+	call_aligned	add_link
 	mov	8(%r12), %edi
 	mov	%ebp, %esi
 	lea	-4(%edi), %edx
@@ -369,7 +380,7 @@ dyna_linker:
 	mov	%eax, %edi
 	mov	%eax, %ebp /* Note: assumes %rbx and %rbp are callee-saved */
 	mov	%esi, %r12d
-	call	sh2_recompile_block
+	call_aligned	sh2_recompile_block
 	test	%eax, %eax
 	mov	%ebp, %eax
 	mov	%r12d, %esi
@@ -467,7 +478,7 @@ jump_vaddr:
 	je	.C1
   /* No hit on hash table, call compiler */
 	mov	%esi, %ebx /* CCREG */
-	call	get_addr
+	call_aligned	get_addr
 	mov	%ebx, %esi
 	jmp	*%rax
 	.size	jump_vaddr, .-jump_vaddr
@@ -499,7 +510,7 @@ verify_code:
 	add	$8, %rsp /* pop return address, we're not returning */
 	mov	%r12d, %edi
 	mov	%esi, %ebx
-	call	get_addr
+	call_aligned	get_addr
 	mov	%ebx, %esi
 	jmp	*%rax
 	.size	verify_code, .-verify_code
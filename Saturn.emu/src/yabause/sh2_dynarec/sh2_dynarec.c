@@ -221,7 +221,7 @@ struct ll_entry
 // asm linkage
 int sh2_recompile_block(int addr);
 void *get_addr_ht(u32 vaddr);
-void get_bounds(pointer addr,u32 *start,u32 *end);
+void get_bounds(pointer addr,pointer *start,pointer *end);
 void invalidate_addr(u32 addr);
 void remove_hash(int vaddr);
 void dyna_linker();
@@ -286,8 +286,8 @@ void *get_addr(u32 vaddr)
       //printf("TRACE: count=%d next=%d (get_addr match dirty %x: %x)\n",Count,next_interupt,vaddr,(int)head->addr);
       // Don't restore blocks which are about to expire from the cache
       if((((u32)head->addr-(u32)out)<<(32-TARGET_SIZE_2))>0x60000000+(MAX_OUTPUT_BLOCK_SIZE<<(32-TARGET_SIZE_2)))
-      if(verify_dirty(head->addr)) {
-        u32 start,end;
+      if(verify_dirty((pointer)head->addr)) {
+        pointer start,end;
         int *ht_bin;
         //printf("restore candidate: %x (%d) d=%d\n",vaddr,page,(cached_code[vaddr>>15]>>((vaddr>>12)&7))&1);
         //invalid_code[vaddr>>12]=0;
@@ -302,18 +302,18 @@ void *get_addr(u32 vaddr)
         #endif
         restore_candidate[page>>3]|=1<<(page&7);
         get_bounds((pointer)head->addr,&start,&end);
-        if(start-(u32)HighWram<0x100000) {
-          u32 vstart=start-(u32)HighWram+0x6000000;
-          u32 vend=end-(u32)HighWram+0x6000000;
+        if(start-(pointer)HighWram<0x100000) {
+          u32 vstart=start-(pointer)HighWram+0x6000000;
+          u32 vend=end-(pointer)HighWram+0x6000000;
           int i;
           //printf("write protect: start=%x, end=%x\n",vstart,vend);
           for(i=0;i<vend-vstart;i+=4) {
             cached_code_words[((vstart<4194304?vstart:((vstart|0x400000)&0x7fffff))+i)>>5]|=1<<(((vstart+i)>>2)&7);
           }
         }
-        if(start-(u32)LowWram<0x100000) {
-          u32 vstart=start-(u32)LowWram+0x200000;
-          u32 vend=end-(u32)LowWram+0x200000;
+        if(start-(pointer)LowWram<0x100000) {
+          u32 vstart=start-(pointer)LowWram+0x200000;
+          u32 vend=end-(pointer)LowWram+0x200000;
           int i;
           //printf("write protect: start=%x, end=%x\n",vstart,vend);
           for(i=0;i<vend-vstart;i+=4) {
@@ -909,21 +909,21 @@ void invalidate_blocks(u32 firstblock,u32 lastblock)
     head=jump_dirty[page];
     //printf("page=%d vpage=%d\n",page,vpage);
     while(head!=NULL) {
-      u32 start,end;
+      pointer start,end;
       if((head->vaddr>>12)==block) { // Ignore vaddr hash collision
         get_bounds((pointer)head->addr,&start,&end);
         //printf("start: %x end: %x\n",start,end);
-        if(start>=(u32)LowWram&&end<(u32)LowWram+1048576) {
-          if(((start-(u32)LowWram)>>12)<=page&&((end-1-(u32)LowWram)>>12)>=page) {
-            if((((start-(u32)LowWram)>>12)+512)<first) first=((start-(u32)LowWram)>>12)&1023;
-            if((((end-1-(u32)LowWram)>>12)+512)>last) last=((end-1-(u32)LowWram)>>12)&1023;
+        if(start>=(pointer)LowWram&&end<(pointer)LowWram+1048576) {
+          if(((start-(pointer)LowWram)>>12)<=page&&((end-1-(pointer)LowWram)>>12)>=page) {
+            if((((start-(pointer)LowWram)>>12)+512)<first) first=((start-(pointer)LowWram)>>12)&1023;
+            if((((end-1-(pointer)LowWram)>>12)+512)>last) last=((end-1-(pointer)LowWram)>>12)&1023;
           }
         }
         // FIXME: Aliasing/mirroring is wrong here
-        if(start>=(u32)HighWram&&end<(u32)HighWram+1048576) {
-          if(((start-(u32)HighWram)>>12)<=page-1024&&((end-1-(u32)HighWram)>>12)>=page-1024) {
-            if((((start-(u32)HighWram)>>12)&255)<first-1024) first=(((start-(u32)HighWram)>>12)&255)+1024;
-            if((((end-1-(u32)HighWram)>>12)&255)>last-1024) last=(((end-1-(u32)HighWram)>>12)&255)+1024;
+        if(start>=(pointer)HighWram&&end<(pointer)HighWram+1048576) {
+          if(((start-(pointer)HighWram)>>12)<=page-1024&&((end-1-(pointer)HighWram)>>12)>=page-1024) {
+            if((((start-(pointer)HighWram)>>12)&255)<first-1024) first=(((start-(pointer)HighWram)>>12)&255)+1024;
+            if((((end-1-(pointer)HighWram)>>12)&255)>last-1024) last=(((end-1-(pointer)HighWram)>>12)&255)+1024;
           }
         }
       }
@@ -1047,24 +1047,25 @@ void clean_blocks(u32 page)
     if((cached_code[head->vaddr>>15]>>((head->vaddr>>12)&7))&1) {;
       // Don't restore blocks which are about to expire from the cache
       if((((u32)head->addr-(u32)out)<<(32-TARGET_SIZE_2))>0x60000000+(MAX_OUTPUT_BLOCK_SIZE<<(32-TARGET_SIZE_2))) {
-        u32 start,end,vstart=0,vend;
-        if(verify_dirty((int)head->addr)) {
+        pointer start,end;
+        u32 vstart=0,vend;
+        if(verify_dirty((pointer)head->addr)) {
           //printf("Possibly Restore %x (%x)\n",head->vaddr, (int)head->addr);
           u32 i;
           u32 inv=0;
           get_bounds((pointer)head->addr,&start,&end);
-          if(start-(u32)HighWram<0x100000) {
-            vstart=start-(u32)HighWram+0x6000000;
-            vend=end-(u32)HighWram+0x6000000;
-            for(i=(start-(u32)HighWram+0x6000000)>>12;i<=(end-1-(u32)HighWram+0x6000000)>>12;i++) {
+          if(start-(pointer)HighWram<0x100000) {
+            vstart=start-(pointer)HighWram+0x6000000;
+            vend=end-(pointer)HighWram+0x6000000;
+            for(i=(start-(pointer)HighWram+0x6000000)>>12;i<=(end-1-(pointer)HighWram+0x6000000)>>12;i++) {
               // Check that all the pages are write-protected
               if(!((cached_code[i>>3]>>(i&7))&1)) inv=1;
             }
           }
-          if(start-(u32)LowWram<0x100000) {
-            vstart=start-(u32)LowWram+0x200000;
-            vend=end-(u32)LowWram+0x200000;
-            for(i=(start-(u32)LowWram+0x200000)>>12;i<=(end-1-(u32)LowWram+0x200000)>>12;i++) {
+          if(start-(pointer)LowWram<0x100000) {
+            vstart=start-(pointer)LowWram+0x200000;
+            vend=end-(pointer)LowWram+0x200000;
+            for(i=(start-(pointer)LowWram+0x200000)>>12;i<=(end-1-(pointer)LowWram+0x200000)>>12;i++) {
               // Check that all the pages are write-protected
               if(!((cached_code[i>>3]>>(i&7))&1)) inv=1;
             }
@@ -1445,8 +1446,9 @@ void load_alloc(struct regstat *current,int i)
 
   // Need a register to load from memory_map
   alloc_reg(current,i,MOREG);
-  if(rt1[i]==TBIT||get_reg(current->regmap,rt1[i])<0) {
-    // dummy load, but we still need a register to calculate the address
+  if(rt1[i]==TBIT||get_reg(current->regmap,rt1[i])<0||((current->u>>rt1[i])&1)) {
+    // dummy load, but we still need a register to calculate the address,
+    // an unneeded target may still be mapped here but is dropped before assembly
     alloc_reg_temp(current,i,-1);
     minimum_free_regs[i]=1;
   }
@@ -1985,7 +1987,7 @@ void alu_assemble(int i,struct regstat *i_regs)
   if(opcode[i]==6) { // NOT/SWAP/NEG
     int s=get_reg(i_regs->regmap,rs1[i]);
     int t=get_reg(i_regs->regmap,rt1[i]);
-    if(s<0) {
+    if(s<0&&t>=0) {
       // FIXME: Preload?
       emit_loadreg(rs1[i],t);
       s=t;
@@ -5231,13 +5233,35 @@ void disassemble_inst(int i)
     }
 }
 
-void sh2_dynarec_init()
+int sh2_dynarec_init()
 {
   int n;
   //printf("Init new dynarec\n");
   out=(u8 *)BASE_ADDR;
   #ifdef __arm__
   mprotect(out, 1<<TARGET_SIZE_2, PROT_READ | PROT_WRITE | PROT_EXEC);
+  #elif defined(CPU_X64)
+  // Dynarec state & helper functions are referenced with 32-bit absolute or
+  // rip-relative operands, which only works in a non-PIE executable
+  if((pointer)&memory_map[1048576]>0x7FFFFFFF||(pointer)shadow+sizeof(shadow)>0x7FFFFFFF||
+     (pointer)&verify_code>0x7FFFFFFF) {
+    printf("dynarec state at %p not addressable with 32-bit operands\n",(void *)memory_map);
+    return -1;
+  }
+  // Generated code and the linker tables hold 32-bit host addresses, so the
+  // cache must land exactly at BASE_ADDR. Don't use MAP_FIXED since it would
+  // silently replace anything already mapped there.
+  {
+    void *cache=mmap (out, 1<<TARGET_SIZE_2,
+                      PROT_READ | PROT_WRITE | PROT_EXEC,
+                      MAP_PRIVATE | MAP_ANONYMOUS,
+                      -1, 0);
+    if (cache != out) {
+      if (cache != MAP_FAILED) munmap (cache, 1<<TARGET_SIZE_2);
+      printf("mmap() of dynarec cache at %p failed\n",out);
+      return -1;
+    }
+  }
   #else
   if (mmap (out, 1<<TARGET_SIZE_2,
             PROT_READ | PROT_WRITE | PROT_EXEC,
@@ -5259,10 +5283,12 @@ void sh2_dynarec_init()
   expirep=16384; // Expiry pointer, +2 blocks
   literalcount=0;
   stop_after_jal=0;
+  #ifndef CPU_X64
   if (mmap ((void *)0x80000000, 4194304,
             PROT_READ | PROT_WRITE,
             MAP_FIXED | MAP_PRIVATE | MAP_ANONYMOUS,
             -1, 0) == MAP_FAILED) {printf("mmap() failed\n");}
+  #endif
 
   // This has to be done after BiosRom etc are allocated
   for(n=0;n<1048576;n++) {
@@ -5308,6 +5334,7 @@ void sh2_dynarec_init()
   slave_ip=(void *)0; // Slave not running, go directly to interrupt handler
 
   arch_init();
+  return 0;
 }
 
 void SH2DynarecReset(SH2_struct *context) {
@@ -5323,7 +5350,9 @@ void sh2_dynarec_cleanup()
   #ifndef __arm__
   if (munmap ((void *)BASE_ADDR, 1<<TARGET_SIZE_2) < 0) {printf("munmap() failed\n");}
   #endif
+  #ifndef CPU_X64
   munmap ((void *)0x80000000, 4194304);
+  #endif
   for(n=0;n<2048;n++) ll_clear(jump_in+n);
   for(n=0;n<2048;n++) ll_clear(jump_out+n);
   for(n=0;n<2048;n++) ll_clear(jump_dirty+n);
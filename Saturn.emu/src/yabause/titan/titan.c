@@ -294,11 +294,16 @@ void TitanPutShadow(int priority, s32 x, s32 y)
 }
 
 void TitanRender(pixel_t * dispbuffer)
+{
+   TitanRenderLines(dispbuffer, 0, tt_context.vdp2height);
+}
+
+void TitanRenderLines(pixel_t * dispbuffer, int start, int end)
 {
    u32 dot;
    int i;
 
-   for (i = 0; i < (tt_context.vdp2width * tt_context.vdp2height); i++)
+   for (i = start * tt_context.vdp2width; i < (end * tt_context.vdp2width); i++)
    {
       dot = TitanDigPixel(7, i);
       if (dot)
@@ -163,6 +163,44 @@ static int outputheight;
 static int resxratio;
 static int resyratio;
 
+// VDP2 layers & sprite compositing are drawn in bands of lines, which may run on several threads
+// at once. Each TitanPutPixel() only touches its own line, so bands never write to the same
+// memory. Lines outside the current band still advance the per-line state (scroll tables,
+// rotation & coefficient accumulators, line windows) so every band draws identical pixels
+// to a serial pass.
+static void VIDSoftRunLinesSerial(VIDSoftLineFunc func, int lines)
+{
+   func(0, lines);
+}
+
+static VIDSoftLineRunner vidsoftlinerunner = VIDSoftRunLinesSerial;
+static __thread int vdp2linestart = 0;
+static __thread int vdp2lineend = 512;
+
+static INLINE void SetLineBand(int start, int end)
+{
+   vdp2linestart = start;
+   vdp2lineend = end;
+}
+
+static INLINE int IsLineInBand(int line)
+{
+   return line >= vdp2linestart && line < vdp2lineend;
+}
+
+static int mosaic_table[16][1024];
+
+static void InitMosaicTable(void)
+{
+   int i, j;
+   for(i=0;i<16;i++)
+   {
+      int m = i+1;
+      for(j=0;j<1024;j++)
+         mosaic_table[i][j] = j/m*m;
+   }
+}
+
 typedef struct { s16 x; s16 y; } vdp1vertex;
 
 typedef struct
@@ -667,22 +705,8 @@ static void FASTCALL Vdp2DrawScroll(vdp2draw_struct *info)
    ReadLineWindowData(&info->islinewindow, info->wctl, &linewnd0addr, &linewnd1addr);
    /* color calculation window: in => no color calc, out => color calc */
    ReadWindowData(Vdp2Regs->WCTLD >> 8, colorcalcwindow);
-   {
-	   static int tables_initialized = 0;
-	   static int mosaic_table[16][1024];
-	   if(!tables_initialized)
-	   {
-		   tables_initialized = 1;
-			for(i=0;i<16;i++)
-			{
-				int m = i+1;
-				for(j=0;j<1024;j++)
-					mosaic_table[i][j] = j/m*m;
-			}
-	   }
-	   mosaic_x = mosaic_table[info->mosaicxmask-1];
-	   mosaic_y = mosaic_table[info->mosaicymask-1];
-   }
+   mosaic_x = mosaic_table[info->mosaicxmask-1];
+   mosaic_y = mosaic_table[info->mosaicymask-1];
 
    for (j = 0; j < vdp2height; j++)
    {
@@ -735,6 +759,9 @@ static void FASTCALL Vdp2DrawScroll(vdp2draw_struct *info)
 
       info->LoadLineParams(info, j);
 
+      if (!IsLineInBand(j))
+         continue;
+
       for (i = 0; i < vdp2width; i++)
       {
          u32 color;
@@ -798,6 +825,7 @@ static void FASTCALL Vdp2DrawRotationFP(vdp2draw_struct *info, vdp2rotationparam
 {
    int i, j;
    int x, y;
+   int linewidth;
    screeninfo_struct sinfo;
    vdp2rotationparameterfp_struct *p=&parameter[info->rotatenum];
    clipping_struct clip[2];
@@ -838,7 +866,8 @@ static void FASTCALL Vdp2DrawRotationFP(vdp2draw_struct *info, vdp2rotationparam
             info->LoadLineParams(info, j);
             ReadLineWindowClip(info->islinewindow, clip, &linewnd0addr, &linewnd1addr);
 
-            for (i = 0; i < vdp2width; i++)
+            linewidth = IsLineInBand(j) ? vdp2width : 0;
+            for (i = 0; i < linewidth; i++)
             {
                u32 color;
 
@@ -956,7 +985,8 @@ static void FASTCALL Vdp2DrawRotationFP(vdp2draw_struct *info, vdp2rotationparam
             lineColorAddr = (T1ReadWord(Vdp2Ram, lineAddr) & 0x780) | p->linescreen;
             lineColor = Vdp2ColorRamGetColor(lineColorAddr);
             lineAddr += lineInc;
-            TitanPutLineHLine(info->linescreen, j, COLSAT2YAB32(0x3F, lineColor));
+            if (IsLineInBand(j))
+               TitanPutLineHLine(info->linescreen, j, COLSAT2YAB32(0x3F, lineColor));
          }
 
          info->LoadLineParams(info, j);
@@ -965,7 +995,13 @@ static void FASTCALL Vdp2DrawRotationFP(vdp2draw_struct *info, vdp2rotationparam
          if (userpwindow)
             ReadLineWindowClip(isrplinewindow, rpwindow, &rplinewnd0addr, &rplinewnd1addr);
 
-         for (i = 0; i < vdp2width; i++)
+         // per-pixel coefficient reads still need to run outside the band since the last one
+         // sets the line color screen address used by the next line
+         if (IsLineInBand(j) || (p->deltaKAx != 0) || ((p2 != NULL) && p2->coefenab && (p2->deltaKAx != 0)))
+            linewidth = vdp2width;
+         else
+            linewidth = 0;
+         for (i = 0; i < linewidth; i++)
          {
             u32 color;
 
@@ -988,7 +1024,7 @@ static void FASTCALL Vdp2DrawRotationFP(vdp2draw_struct *info, vdp2rotationparam
                rcoefx2 += decipart(p2->deltaKAx);
             }
 
-            if (!TestBothWindow(info->wctl, clip, i, j))
+            if (!IsLineInBand(j) || !TestBothWindow(info->wctl, clip, i, j))
                continue;
 
             if (((! userpwindow) && p->msb) || (userpwindow && (! TestBothWindow(Vdp2Regs->WCTLD, rpwindow, i, j))))
@@ -1697,6 +1733,8 @@ int VIDSoftInit(void)
    if (TitanInit() == -1)
       return -1;
 
+   InitMosaicTable();
+
    if ((dispbuffer = (pixel_t *)memalign(8, sizeof(pixel_t) * 704 * 512)) == NULL)
       return -1;
 
@@ -2832,7 +2870,7 @@ void VIDSoftVdp2DrawStart(void)
 
 //////////////////////////////////////////////////////////////////////////////
 
-void VIDSoftVdp2DrawEnd(void)
+static void Vdp2DrawSprites(void)
 {
    int i, i2;
    u16 pixel;
@@ -2874,7 +2912,6 @@ void VIDSoftVdp2DrawEnd(void)
       colorcalctable[7] = ((~Vdp2Regs->CCRSD >> 7) & 0x3E) + 1;
 
       vdp1coloroffset = (Vdp2Regs->CRAOFB & 0x70) << 4;
-      vdp1spritetype = Vdp2Regs->SPCTL & 0xF;
 
       ReadVdp2ColorOffset(Vdp2Regs, &info, 0x40, 0x40);
 
@@ -2897,6 +2934,9 @@ void VIDSoftVdp2DrawEnd(void)
 
          LoadLineParamsSprite(&info, i2);
 
+         if (!IsLineInBand(i2))
+            continue;
+
          for (i = 0; i < vdp2width; i++)
          {
             // See if screen position is clipped, if it isn't, continue
@@ -3075,7 +3115,26 @@ void VIDSoftVdp2DrawEnd(void)
          }
       }
    }
-   TitanRender(dispbuffer);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+static void Vdp2DrawEndLines(int start, int end)
+{
+   SetLineBand(start, end);
+   Vdp2DrawSprites();
+   TitanRenderLines(dispbuffer, start, end);
+   SetLineBand(0, 512);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void VIDSoftVdp2DrawEnd(void)
+{
+   int i;
+
+   vdp1spritetype = Vdp2Regs->SPCTL & 0xF;
+   vidsoftlinerunner(Vdp2DrawEndLines, vdp2height);
 
    VIDSoftVdp1SwapFrameBuffer();
 
@@ -3101,17 +3160,11 @@ void VIDSoftVdp2DrawEnd(void)
 
 //////////////////////////////////////////////////////////////////////////////
 
-void VIDSoftVdp2DrawScreens(void)
+static void Vdp2DrawScreenLines(int start, int end)
 {
    int i;
 
-   VIDSoftVdp2SetResolution(Vdp2Regs->TVMD);
-   VIDSoftVdp2SetPriorityNBG0(Vdp2Regs->PRINA & 0x7);
-   VIDSoftVdp2SetPriorityNBG1((Vdp2Regs->PRINA >> 8) & 0x7);
-   VIDSoftVdp2SetPriorityNBG2(Vdp2Regs->PRINB & 0x7);
-   VIDSoftVdp2SetPriorityNBG3((Vdp2Regs->PRINB >> 8) & 0x7);
-   VIDSoftVdp2SetPriorityRBG0(Vdp2Regs->PRIR & 0x7);
-
+   SetLineBand(start, end);
    for (i = 7; i > 0; i--)
    {   
       if (nbg3priority == i)
@@ -3125,6 +3178,21 @@ void VIDSoftVdp2DrawScreens(void)
       if (rbg0priority == i)
          Vdp2DrawRBG0();
    }
+   SetLineBand(0, 512);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void VIDSoftVdp2DrawScreens(void)
+{
+   VIDSoftVdp2SetResolution(Vdp2Regs->TVMD);
+   VIDSoftVdp2SetPriorityNBG0(Vdp2Regs->PRINA & 0x7);
+   VIDSoftVdp2SetPriorityNBG1((Vdp2Regs->PRINA >> 8) & 0x7);
+   VIDSoftVdp2SetPriorityNBG2(Vdp2Regs->PRINB & 0x7);
+   VIDSoftVdp2SetPriorityNBG3((Vdp2Regs->PRINB >> 8) & 0x7);
+   VIDSoftVdp2SetPriorityRBG0(Vdp2Regs->PRIR & 0x7);
+
+   vidsoftlinerunner(Vdp2DrawScreenLines, vdp2height);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -3325,3 +3393,10 @@ void VIDSoftGetGlSize(int *width, int *height)
    *height = vdp2height;
 #endif
 }
+
+//////////////////////////////////////////////////////////////////////////////
+
+void VIDSoftSetLineRunner(VIDSoftLineRunner runner)
+{
+   vidsoftlinerunner = runner ? runner : VIDSoftRunLinesSerial;
+}
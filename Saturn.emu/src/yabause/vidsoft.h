@@ -30,4 +30,11 @@ extern VideoInterface_struct VIDSoft;
 
 void VIDSoftVdp2DrawScreen(int screen);
 
+typedef void (*VIDSoftLineFunc)(int start, int end);
+typedef void (*VIDSoftLineRunner)(VIDSoftLineFunc func, int lines);
+
+/* The line runner splits [0, lines) into bands, calls func on each (possibly in
+   parallel) and returns once they're all done. NULL restores the serial default. */
+void VIDSoftSetLineRunner(VIDSoftLineRunner runner);
+
 #endif
@@ -12,6 +12,7 @@
 #include <cheats.h>
 #ifndef SNES9X_VERSION_1_4
 #include <apu/bapu/snes/snes.hpp>
+#include <stream.h>
 #else
 #include <soundux.h>
 #endif
@@ -121,6 +122,25 @@ void Snes9xSystem::loadState(EmuApp &, IG::CStringView path)
 		return throwFileReadError();
 }
 
+#ifndef SNES9X_VERSION_1_4
+size_t Snes9xSystem::stateSize() { return S9xFreezeSize(); }
+
+void Snes9xSystem::readState(EmuApp &, std::span<const uint8_t> buff)
+{
+	if(S9xUnfreezeGameMem(buff.data(), buff.size()) != SUCCESS)
+		throw std::runtime_error{"Invalid state data"};
+	IPPU.RenderThisFrame = TRUE;
+}
+
+size_t Snes9xSystem::writeState(std::span<uint8_t> buff)
+{
+	// snapshot size is fixed once a game is loaded so a buffer of stateSize() always fits
+	memStream stream{buff.data(), buff.size()};
+	S9xFreezeToStream(&stream);
+	return stream.pos();
+}
+#endif
+
 void Snes9xSystem::onFlushBackupMemory(BackupMemoryDirtyFlags)
 {
 	if(!hasContent())
@@ -73,6 +73,13 @@ void WsSystem::loadState(EmuApp &, IG::CStringView path)
 		throwFileReadError();
 }
 
+size_t WsSystem::stateSize() { return stateSizeMDFN(); }
+void WsSystem::readState(EmuApp &, std::span<const uint8_t> buff) { readStateMDFN(buff); }
+size_t WsSystem::writeState(std::span<uint8_t> buff) { return writeStateMDFN(buff); }
+size_t WsSystem::snapshotSize() { return stateSizeMDFN(true); }
+void WsSystem::readSnapshot(EmuApp &, std::span<const uint8_t> buff) { readStateMDFN(buff, true); }
+size_t WsSystem::writeSnapshot(std::span<uint8_t> buff) { return writeStateMDFN(buff, true); }
+
 static FS::PathString saveFilename(EmuSystem &sys)
 {
 	return sys.contentSaveFilePath(".sav");
@@ -116,6 +123,11 @@ bool WsSystem::onVideoRenderFormatChange(EmuVideo &, IG::PixelFormat fmt)
 	return false;
 }
 
+void WsSystem::renderFramebuffer(EmuVideo &video)
+{
+	video.startFrameWithFormat({}, mSurfacePix);
+}
+
 void WsSystem::configAudioRate(IG::FloatSeconds frameTime, int rate)
 {
 	if(!hasContent())
@@ -104,8 +104,15 @@ public:
 	void closeSystem();
 	void onFlushBackupMemory(BackupMemoryDirtyFlags);
 	bool onVideoRenderFormatChange(EmuVideo &, IG::PixelFormat);
+	void renderFramebuffer(EmuVideo &);
 	IG::Rotation contentRotation() const;
 	bool resetSessionOptions(EmuApp &app);
+	size_t stateSize();
+	void readState(EmuApp &, std::span<const uint8_t> buff);
+	size_t writeState(std::span<uint8_t> buff);
+	size_t snapshotSize();
+	void readSnapshot(EmuApp &, std::span<const uint8_t> buff);
+	size_t writeSnapshot(std::span<uint8_t> buff);
 
 private:
 	void setupInput(EmuApp &app);
@@ -77,4 +77,14 @@ struct Format
 	void *copyFrames(void *dest, const void *src, size_t frames, Format srcFormat, float volume = 1.f) const;
 };
 
+enum class SampleKernels : uint8_t
+{
+	SCALAR, SSE2, AVX2, NEON
+};
+
+// Selects the instruction set copyFrames() uses, returns false if the build or CPU doesn't support it.
+// The widest supported one is used by default, this is mainly for testing the vector kernels.
+bool setSampleKernels(SampleKernels);
+SampleKernels sampleKernels();
+
 }
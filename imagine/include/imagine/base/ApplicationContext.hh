@@ -33,6 +33,7 @@
 #include <imagine/util/memory/UniqueFileDescriptor.hh>
 #include <vector>
 #include <optional>
+#include <ctime>
 
 namespace IG::Input
 {
@@ -42,6 +43,7 @@ class Device;
 
 namespace IG::FS
 {
+using file_time_type = std::time_t;
 class PathString;
 class FileString;
 struct PathLocation;
@@ -180,6 +182,7 @@ public:
 	UniqueFileDescriptor openFileUriFd(CStringView uri, OpenFlagsMask oFlags = {}) const;
 	bool fileUriExists(IG::CStringView uri) const;
 	std::string fileUriFormatLastWriteTimeLocal(IG::CStringView uri) const;
+	FS::file_time_type fileUriLastWriteTime(IG::CStringView uri) const;
 	FS::FileString fileUriDisplayName(IG::CStringView uri) const;
 	bool removeFileUri(IG::CStringView uri) const;
 	bool renameFileUri(IG::CStringView oldUri, IG::CStringView newUri) const;
@@ -0,0 +1,225 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/config/defs.hh>
+#include <imagine/base/MessagePort.hh>
+#include <imagine/thread/Semaphore.hh>
+#include <imagine/util/concepts.hh>
+#include <imagine/util/utility.h>
+#include <imagine/util/used.hh>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <type_traits>
+
+namespace IG
+{
+
+// Message port backed by a fixed-size shared memory ring for exactly one sending and one receiving
+// thread. Unlike PipeMessagePort, sending doesn't need a syscall unless the other side is asleep
+// waiting on the port. It isn't attached to an EventLoop, the receiving thread drives it directly
+// with run().
+
+template<class MsgType, size_t capacity = 8>
+class SPSCMessagePort
+{
+public:
+	static_assert(std::has_single_bit(capacity), "capacity must be a power of 2");
+	static_assert(std::is_trivially_copyable_v<MsgType>);
+
+	class Messages
+	{
+	public:
+		class Iterator
+		{
+		public:
+			constexpr Iterator(SPSCMessagePort *port): port{port}
+			{
+				this->operator++();
+			}
+
+			Iterator operator++()
+			{
+				if(!port) [[unlikely]]
+					return *this;
+				if(!port->pop(msg))
+				{
+					// end of messages
+					port = nullptr;
+				}
+				return *this;
+			}
+
+			bool operator!=(const Iterator &rhs) const
+			{
+				return port != rhs.port;
+			}
+
+			const MsgType &operator*() const
+			{
+				return msg;
+			}
+
+		private:
+			SPSCMessagePort *port{};
+			MsgType msg{};
+		};
+
+		constexpr Messages(SPSCMessagePort &port): port{port} {}
+
+		Iterator begin() { return Iterator{&port}; }
+		Iterator end() { return Iterator{nullptr}; }
+
+	protected:
+		SPSCMessagePort &port;
+	};
+
+	SPSCMessagePort(const char *debugLabel = nullptr):
+		debugLabel{debugLabel ? debugLabel : "unnamed"} {}
+
+	// Blocks the receiving thread until messages arrive, passing them to the callback until it returns false
+	void run(IG::Callable<bool, Messages> auto &&f)
+	{
+		while(true)
+		{
+			waitForMessages();
+			if(!f(Messages{*this}))
+				return;
+		}
+	}
+
+	void waitForMessages()
+	{
+		auto readIdx = readPos.load(std::memory_order::relaxed);
+		waitWhileEqual(writePos, readIdx, receiverWaiting, receiverSem);
+	}
+
+	Messages messages() { return {*this}; }
+
+	bool send(MsgType msg)
+	{
+		auto writeIdx = writePos.load(std::memory_order::relaxed);
+		waitWhileEqual(readPos, writeIdx - capacity, senderWaiting, senderSem);
+		buff[writeIdx & indexMask] = msg;
+		writePos.store(writeIdx + 1, std::memory_order::seq_cst);
+		wake(receiverWaiting, receiverSem);
+		return true;
+	}
+
+	// Returns false instead of waiting if the port is full
+	bool trySend(MsgType msg)
+	{
+		auto writeIdx = writePos.load(std::memory_order::relaxed);
+		if(readPos.load(std::memory_order::acquire) == writeIdx - capacity)
+			return false;
+		buff[writeIdx & indexMask] = msg;
+		writePos.store(writeIdx + 1, std::memory_order::seq_cst);
+		wake(receiverWaiting, receiverSem);
+		return true;
+	}
+
+	// Returns false instead of waiting if the port is empty
+	bool tryReceive(MsgType &msg)
+	{
+		return pop(msg);
+	}
+
+	bool send(MsgType msg, bool awaitReply)
+	{
+		if(awaitReply)
+		{
+			std::binary_semaphore replySemaphore{0};
+			return send(msg, &replySemaphore);
+		}
+		else
+		{
+			return send(msg);
+		}
+	}
+
+	bool send(ReplySemaphoreSettableMessage auto msg, std::binary_semaphore *semPtr)
+	{
+		if(semPtr)
+		{
+			msg.setReplySemaphore(semPtr);
+			send(msg);
+			semPtr->acquire();
+			return true;
+		}
+		else
+		{
+			return send(msg);
+		}
+	}
+
+	void clear()
+	{
+		MsgType msg;
+		while(pop(msg)) {}
+	}
+
+	explicit constexpr operator bool() const { return true; }
+	const char *label() const { return debugLabel; }
+
+protected:
+	static constexpr uint32_t indexMask = capacity - 1;
+
+	IG_UseMemberIf(Config::DEBUG_BUILD, const char *, debugLabel){};
+
+	// read & write positions increase monotonically and wrap naturally at 2^32,
+	// keep them on separate cache lines so the threads don't contend for them
+	alignas(64) std::atomic_uint32_t writePos{};
+	std::atomic_bool receiverWaiting{};
+	std::binary_semaphore receiverSem{0};
+	alignas(64) std::atomic_uint32_t readPos{};
+	std::atomic_bool senderWaiting{};
+	std::binary_semaphore senderSem{0};
+	alignas(64) std::array<MsgType, capacity> buff{};
+
+	bool pop(MsgType &msg)
+	{
+		auto readIdx = readPos.load(std::memory_order::relaxed);
+		if(readIdx == writePos.load(std::memory_order::acquire))
+			return false;
+		msg = buff[readIdx & indexMask];
+		readPos.store(readIdx + 1, std::memory_order::seq_cst);
+		wake(senderWaiting, senderSem);
+		return true;
+	}
+
+	// The waiting flag & position are accessed with sequentially consistent ordering on both sides so either
+	// the waiter sees the updated position or the other side sees the flag and posts the semaphore
+	static void waitWhileEqual(std::atomic_uint32_t &pos, uint32_t oldPos, std::atomic_bool &waiting, std::binary_semaphore &sem)
+	{
+		while(pos.load(std::memory_order::acquire) == oldPos)
+		{
+			waiting.store(true, std::memory_order::seq_cst);
+			if(pos.load(std::memory_order::seq_cst) != oldPos && waiting.exchange(false, std::memory_order::seq_cst))
+				return;
+			// either still empty/full or the other side already cleared the flag and is about to post
+			sem.acquire();
+		}
+	}
+
+	static void wake(std::atomic_bool &waiting, std::binary_semaphore &sem)
+	{
+		if(waiting.load(std::memory_order::seq_cst) && waiting.exchange(false, std::memory_order::seq_cst)) [[unlikely]]
+			sem.release();
+	}
+};
+
+}
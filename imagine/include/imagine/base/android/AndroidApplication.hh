@@ -89,6 +89,7 @@ public:
 	UniqueFileDescriptor openFileUriFd(JNIEnv *, jobject baseActivity, CStringView uri, OpenFlagsMask oFlags = {}) const;
 	bool fileUriExists(JNIEnv *, jobject baseActivity, IG::CStringView uri) const;
 	std::string fileUriFormatLastWriteTimeLocal(JNIEnv *, jobject baseActivity, IG::CStringView uri) const;
+	FS::file_time_type fileUriLastWriteTime(JNIEnv *, jobject baseActivity, IG::CStringView uri) const;
 	FS::FileString fileUriDisplayName(JNIEnv *, jobject baseActivity, IG::CStringView uri) const;
 	bool removeFileUri(JNIEnv *, jobject baseActivity, IG::CStringView uri, bool isDir) const;
 	bool renameFileUri(JNIEnv *, jobject baseActivity, IG::CStringView oldUri, IG::CStringView newUri) const;
@@ -132,6 +133,7 @@ private:
 	JNI::InstMethod<jint(jstring, jint)> openUriFd{};
 	JNI::InstMethod<jboolean(jstring)> uriExists{};
 	JNI::InstMethod<jstring(jstring)> uriLastModified{};
+	JNI::InstMethod<jlong(jstring)> uriLastModifiedTime{};
 	JNI::InstMethod<jstring(jstring)> uriDisplayName{};
 	JNI::InstMethod<jboolean(jstring, jboolean)> deleteUri{};
 	JNI::InstMethod<jboolean(jlong, jstring)> listUriFiles{};
@@ -76,6 +76,7 @@ protected:
 	float yLineStart = 0;
 	float xSize = 0;
 	float ySize = 0;
+	uint32_t glyphGeneration{}; // face's glyph generation when all glyphs were last made resident
 	uint16_t lines = 0;
 
 	bool hasText() const;
@@ -19,7 +19,10 @@
 #include <imagine/font/Font.hh>
 #include <imagine/gfx/Texture.hh>
 #include <imagine/util/container/VMemArray.hh>
+#include <array>
+#include <cstdint>
 #include <system_error>
+#include <vector>
 
 namespace IG::Gfx
 {
@@ -28,10 +31,16 @@ constexpr auto glyphSamplerConfig = SamplerConfigs::noMipClamp;
 
 struct GlyphEntry
 {
-	Texture glyph_{};
+	static constexpr uint8_t emptyPage = 0xFF; // glyph has no pixels & needs no atlas space
+
 	GlyphMetrics metrics{};
+	uint16_t shelf{};
+	uint8_t page{}; // atlas page + 1, 0 if not currently in the atlas
+	FRect uv{};
 
-	constexpr const Texture &glyph() const { return glyph_; }
+	constexpr bool isResident() const { return page; }
+	constexpr bool hasPixels() const { return page != emptyPage; }
+	constexpr int pageIndex() const { return page - 1; }
 };
 
 struct GlyphSetMetrics
@@ -41,10 +50,17 @@ struct GlyphSetMetrics
 	int yLineStart{};
 };
 
+// Glyphs are packed into shelves of a few shared atlas textures so drawing a string only needs one
+// texture bind per page. When all pages are full, the least recently used shelf of a tall enough
+// height is evicted & its glyphs are re-rendered the next time a string using them is compiled or
+// has makeGlyphs() called. Any change to which glyphs are resident bumps glyphGeneration() so Text
+// knows when its glyphs need to be looked up again.
+
 class GlyphTextureSet
 {
 public:
 	static constexpr bool supportsUnicode = Config::UNICODE_CHARS;
+	static constexpr int maxAtlasPages = 4;
 
 	constexpr GlyphTextureSet() = default;
 	GlyphTextureSet(Renderer &, Font, FontSettings settings = {});
@@ -56,22 +72,47 @@ public:
 		return precache(r, "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789");
 	}
 	GlyphEntry *glyphEntry(Renderer &r, int c, bool allowCache = true);
+	const Texture &atlasTexture(int page) const { return atlasPages[page].texture; }
 	GlyphSetMetrics metrics() const { return metrics_; }
 	int nominalHeight() const { return metrics().nominalHeight; }
+	uint32_t glyphGeneration() const { return glyphGeneration_; }
 	void freeCaches(uint32_t rangeToFreeBits);
 	void freeCaches() { freeCaches(~0); }
 
 private:
+	struct AtlasShelf
+	{
+		std::vector<int> tableIdxs{}; // glyphs stored in this shelf
+		uint64_t lastUse{};
+		int16_t y{};
+		int16_t height{};
+		int16_t xUsed{};
+	};
+
+	struct AtlasPage
+	{
+		Texture texture{};
+		std::vector<AtlasShelf> shelves{};
+		int yUsed{};
+	};
+
 	Font font{};
 	VMemArray<GlyphEntry> glyphTable{};
+	std::array<AtlasPage, maxAtlasPages> atlasPages{};
 	FontSettings settings{};
 	FontSize faceSize{};
 	GlyphSetMetrics metrics_{};
+	uint64_t useCount{};
+	uint32_t glyphGeneration_{1};
+	int atlasPageSize{};
 	uint32_t usedGlyphTableBits = 0;
 
 	void calcMetrics(Renderer &r);
 	void resetGlyphTable();
+	void resetAtlas(bool freeTextures);
 	std::errc cacheChar(Renderer &r, int c, int tableIdx);
+	std::pair<int, int> allocAtlasSlot(Renderer &r, WP size);
+	void evictShelf(int page, int shelf);
 };
 
 }
@@ -25,6 +25,8 @@
 #include <imagine/thread/WorkThread.hh>
 #include <imagine/util/DelegateFunc.hh>
 #include <imagine/util/string/CStringView.hh>
+#include <mutex>
+#include <string>
 #include <vector>
 
 namespace IG::FS
@@ -70,12 +72,24 @@ public:
 	void setShowHiddenFiles(bool);
 
 protected:
+	// defers text layout until the item is first drawn so only visible cells of large directories get compiled
+	class FileMenuItem : public TextMenuItem
+	{
+	public:
+		using TextMenuItem::TextMenuItem;
+		void compile(Gfx::Renderer &, const Gfx::ProjectionPlane &) override;
+		void prepareDraw(Gfx::Renderer &) override;
+
+	protected:
+		const Gfx::ProjectionPlane *layoutProjP{};
+	};
+
 	struct FileEntry
 	{
 		static constexpr auto IS_DIR_FLAG = MenuItem::USER_FLAG_START;
 
 		std::string path{};
-		TextMenuItem text{};
+		FileMenuItem text{};
 
 		bool isDir() const { return text.flags() & IS_DIR_FLAG; }
 	};
@@ -85,6 +99,8 @@ protected:
 	OnChangePathDelegate onChangePath_{};
 	OnSelectPathDelegate onSelectPath_{};
 	std::vector<FileEntry> dir{};
+	std::vector<FileEntry> pendingDir{}; // sorted entries from the list thread not yet merged into dir
+	std::mutex pendingDirMutex{};
 	FS::RootedPath root{};
 	Gfx::Text msgText{};
 	CustomEvent dirListEvent{"FSPicker::dirListEvent", {}};
@@ -99,6 +115,9 @@ protected:
 	TableView &fileTableView();
 	void startDirectoryListThread(CStringView path);
 	void listDirectory(CStringView path, ThreadStop &stop);
+	void sendDirEntries(std::vector<FileEntry> &);
+	void addPendingDirEntries();
+	void selectDirEntry(size_t idx, const Input::Event &);
 	void setEmptyPath(std::string_view message);
 };
 
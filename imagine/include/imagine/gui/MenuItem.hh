@@ -118,6 +118,10 @@ public:
 	MenuItem(IG::utf16String name, Gfx::GlyphTextureSet *face, IdInt id = {}):
 		id_{id},
 		t{std::move(name), face} {}
+	MenuItem(const MenuItem &) = default;
+	MenuItem(MenuItem &&) = default;
+	MenuItem &operator=(const MenuItem &) = default;
+	MenuItem &operator=(MenuItem &&) = default;
 	virtual ~MenuItem() = default;
 	virtual void prepareDraw(Gfx::Renderer &r);
 	virtual void draw(Gfx::RendererCommands &__restrict__, float xPos, float yPos, float xSize, float ySize,
@@ -72,6 +72,7 @@ public:
 	size_t cells() const;
 	IG::WP cellSize() const;
 	void highlightCell(int idx);
+	int highlightedCell() const { return selected; }
 	void setAlign(_2DOrigin align);
 	std::u16string_view name() const override;
 	void setName(IG::utf16String name) { nameStr = std::move(name); }
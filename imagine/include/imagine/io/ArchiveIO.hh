@@ -49,6 +49,7 @@ public:
 	FS::file_type type() const;
 	size_t size() const;
 	uint32_t crc32() const;
+	bool canBeSolid() const;
 	ArchiveIO moveIO();
 	void moveIO(ArchiveIO io);
 	bool readNextEntry();
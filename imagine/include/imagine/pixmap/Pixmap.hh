@@ -23,6 +23,7 @@
 #include <imagine/util/container/array.hh>
 #include <imagine/util/concepts.hh>
 #include <cstring>
+#include <span>
 
 namespace IG
 {
@@ -39,6 +40,25 @@ uint32_t transformRGB565ToBGRX8888(uint16_t p);
 uint32_t transformRGB888ToRGBX8888(ByteArray<3> p);
 uint32_t transformRGB888ToBGRX8888(ByteArray<3> p);
 
+// Bulk versions of the above, vectorized where the CPU supports it
+void convertRowRGB565ToRGBX8888(uint32_t *dest, const uint16_t *src, size_t pixels);
+void convertRowRGB565ToBGRX8888(uint32_t *dest, const uint16_t *src, size_t pixels);
+void convertRowRGBX8888ToRGB565(uint16_t *dest, const uint32_t *src, size_t pixels);
+void convertRowBGRX8888ToRGB565(uint16_t *dest, const uint32_t *src, size_t pixels);
+void convertRowRGBA8888ToBGRA8888(uint32_t *dest, const uint32_t *src, size_t pixels);
+void convertRowRGBX8888ToRGB888(ByteArray<3> *dest, const uint32_t *src, size_t pixels);
+void convertRowBGRX8888ToRGB888(ByteArray<3> *dest, const uint32_t *src, size_t pixels);
+void convertRowRGB888ToRGBX8888(uint32_t *dest, const ByteArray<3> *src, size_t pixels);
+void convertRowRGB888ToBGRX8888(uint32_t *dest, const ByteArray<3> *src, size_t pixels);
+void convertRowRGB565ToRGB888(ByteArray<3> *dest, const uint16_t *src, size_t pixels);
+void convertRowRGB888ToRGB565(uint16_t *dest, const ByteArray<3> *src, size_t pixels);
+
+// Palette lookups of 8/16-bit indexed pixels, the palette size must be a power of 2 and indexes are masked to fit
+void convertRowIndexed8(uint16_t *dest, const uint8_t *src, size_t pixels, std::span<const uint16_t> palette);
+void convertRowIndexed8(uint32_t *dest, const uint8_t *src, size_t pixels, std::span<const uint32_t> palette);
+void convertRowIndexed16(uint16_t *dest, const uint16_t *src, size_t pixels, std::span<const uint16_t> palette);
+void convertRowIndexed16(uint32_t *dest, const uint16_t *src, size_t pixels, std::span<const uint32_t> palette);
+
 template <class Func>
 concept PixmapTransformFunc =
 		requires (Func &&f, unsigned data){ f(data); } ||
@@ -307,6 +327,42 @@ public:
 		writeTransformed2<Src, Dest>(func, pixmap);
 	}
 
+	template <class Src, class Dest>
+	void writeConvertedRows(void(*convertRow)(Dest *, const Src *, size_t), auto pixmap) requires(dataIsMutable)
+	{
+		writeConvertedRows<Src, Dest>(pixmap, convertRow);
+	}
+
+	// writes the palette entries of an indexed pixmap, 1 or 2 bytes per index
+	template <class Dest>
+	void writeIndexed(std::span<const Dest> palette, auto pixmap) requires(dataIsMutable)
+	{
+		if(pixmap.format().bytesPerPixel() == 1)
+			writeConvertedRows<uint8_t, Dest>(pixmap, [&](Dest *d, const uint8_t *s, size_t n){ convertRowIndexed8(d, s, n, palette); });
+		else
+			writeConvertedRows<uint16_t, Dest>(pixmap, [&](Dest *d, const uint16_t *s, size_t n){ convertRowIndexed16(d, s, n, palette); });
+	}
+
+	template <class Src, class Dest>
+	void writeConvertedRows(auto pixmap, auto &&convertRow) requires(dataIsMutable)
+	{
+		auto srcData = (const char*)pixmap.data();
+		auto destData = data_;
+		if(w() == pixmap.w() && !isPadded() && !pixmap.isPadded())
+		{
+			convertRow((Dest*)destData, (const Src*)srcData, pixmap.w() * pixmap.h());
+		}
+		else
+		{
+			for(auto h : iotaCount(pixmap.h()))
+			{
+				convertRow((Dest*)destData, (const Src*)srcData, pixmap.w());
+				srcData += pixmap.pitchBytes();
+				destData += pitchBytes();
+			}
+		}
+	}
+
 protected:
 	PixData *data_{};
 	int pitch{}; // in bytes
@@ -361,57 +417,57 @@ protected:
 
 	static void convertRGB888ToRGBX8888(auto dest, auto src)
 	{
-		dest.template writeTransformedDirect<ByteArray<3>, uint32_t>(transformRGB888ToRGBX8888, src);
+		dest.writeConvertedRows(convertRowRGB888ToRGBX8888, src);
 	}
 
 	static void convertRGB888ToBGRX8888(auto dest, auto src)
 	{
-		dest.template writeTransformedDirect<ByteArray<3>, uint32_t>(transformRGB888ToBGRX8888, src);
+		dest.writeConvertedRows(convertRowRGB888ToBGRX8888, src);
 	}
 
 	static void convertRGB565ToRGBX8888(auto dest, auto src)
 	{
-		dest.writeTransformed(transformRGB565ToRGBX8888, src);
+		dest.writeConvertedRows(convertRowRGB565ToRGBX8888, src);
 	}
 
 	static void convertRGB565ToBGRX8888(auto dest, auto src)
 	{
-		dest.writeTransformed(transformRGB565ToBGRX8888, src);
+		dest.writeConvertedRows(convertRowRGB565ToBGRX8888, src);
 	}
 
 	static void convertRGBX8888ToRGB888(auto dest, auto src)
 	{
-		dest.template writeTransformedDirect<uint32_t, ByteArray<3>>(transformRGBX8888ToRGB888, src);
+		dest.writeConvertedRows(convertRowRGBX8888ToRGB888, src);
 	}
 
 	static void convertBGRX8888ToRGB888(auto dest, auto src)
 	{
-		dest.template writeTransformedDirect<uint32_t, ByteArray<3>>(transformBGRX8888ToRGB888, src);
+		dest.writeConvertedRows(convertRowBGRX8888ToRGB888, src);
 	}
 
 	static void convertRGB565ToRGB888(auto dest, auto src)
 	{
-		dest.template writeTransformedDirect<uint16_t, ByteArray<3>>(transformRGB565ToRGB888, src);
+		dest.writeConvertedRows(convertRowRGB565ToRGB888, src);
 	}
 
 	static void convertRGB888ToRGB565(auto dest, auto src)
 	{
-		dest.template writeTransformedDirect<ByteArray<3>, uint16_t>(transformRGB888ToRGB565, src);
+		dest.writeConvertedRows(convertRowRGB888ToRGB565, src);
 	}
 
 	static void convertRGBX8888ToRGB565(auto dest, auto src)
 	{
-		dest.writeTransformed(transformRGBX8888ToRGB565, src);
+		dest.writeConvertedRows(convertRowRGBX8888ToRGB565, src);
 	}
 
 	static void convertRGBA8888ToBGRA8888(auto dest, auto src)
 	{
-		dest.writeTransformed(transformRGBA8888ToBGRA8888, src);
+		dest.writeConvertedRows(convertRowRGBA8888ToBGRA8888, src);
 	}
 
 	static void convertBGRX8888ToRGB565(auto dest, auto src)
 	{
-		dest.template writeTransformed(transformBGRX8888ToRGB565, src);
+		dest.writeConvertedRows(convertRowBGRX8888ToRGB565, src);
 	}
 };
 
@@ -63,5 +63,6 @@ constexpr auto stringWithoutDotExtension(auto &&str)
 }
 
 bool stringNoCaseLexCompare(std::string_view s1, std::string_view s2);
+bool stringNaturalNoCaseLexCompare(std::u16string_view s1, std::u16string_view s2);
 
 }
@@ -40,6 +40,7 @@ public:
 	SizeType writeUnchecked(const void *buff, SizeType size);
 	char *writeAddr() const;
 	void commitWrite(SizeType size);
+	void uncommitWrite(SizeType size);
 	SizeType read(void *buff, SizeType size);
 	char *readAddr() const;
 	void commitRead(SizeType size);
@@ -54,6 +55,7 @@ protected:
 	void init(SizeType size);
 	void deinit();
 	char *advanceAddr(char *ptr, SizeType size) const;
+	char *rewindAddr(char *ptr, SizeType size) const;
 	char *wrapPtr(char *ptr) const;
 };
 
@@ -17,7 +17,17 @@
 #include <imagine/util/utility.h>
 #include <imagine/util/algorithm.h>
 #include <imagine/util/math/math.hh>
+#include <algorithm>
 #include <cmath>
+#if defined __SSE2__
+#include <emmintrin.h>
+#if defined __x86_64__ && defined __GNUC__
+#include <immintrin.h>
+#define IG_AUDIO_HAS_AVX2_KERNELS
+#endif
+#elif defined __ARM_NEON
+#include <arm_neon.h>
+#endif
 
 namespace IG::Audio
 {
@@ -28,8 +38,299 @@ static int16_t clamp16FromFloat(float x)
 	return remap(x, -1.f, 1.f, std::numeric_limits<int16_t>{});
 }
 
+// Vector kernels process the bulk of the buffer and return the number of samples handled,
+// leaving the remainder for the scalar code. Float to int16 conversion clamps to [-1, 1]
+// and uses the same remap & truncation as clamp16FromFloat() so results are bit-exact.
+
+#if defined __SSE2__
+
+static __m128i floatToI16x8(__m128 a, __m128 b)
+{
+	const auto min = _mm_set1_ps(-1.f), max = _mm_set1_ps(1.f);
+	const auto one = _mm_set1_ps(1.f), scale = _mm_set1_ps(65535.f), half = _mm_set1_ps(.5f), offset = _mm_set1_ps(-32768.f);
+	a = _mm_min_ps(_mm_max_ps(a, min), max);
+	b = _mm_min_ps(_mm_max_ps(b, min), max);
+	a = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_add_ps(a, one), scale), half), offset);
+	b = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_add_ps(b, one), scale), half), offset);
+	return _mm_packs_epi32(_mm_cvttps_epi32(a), _mm_cvttps_epi32(b));
+}
+
+static void i16x8ToFloat(__m128i s, __m128 &lo, __m128 &hi)
+{
+	// sign extend by unpacking into the high halves and shifting down
+	lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16));
+	hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16));
+}
+
+static size_t convertI16SamplesToFloatSSE2(float * __restrict__ dest, size_t samples, const int16_t * __restrict__ src, float volume)
+{
+	const auto scale = _mm_set1_ps(1.f / 32768.f), vol = _mm_set1_ps(volume);
+	size_t i = 0;
+	for(; i + 8 <= samples; i += 8)
+	{
+		__m128 lo, hi;
+		i16x8ToFloat(_mm_loadu_si128((const __m128i*)&src[i]), lo, hi);
+		_mm_storeu_ps(&dest[i], _mm_mul_ps(_mm_mul_ps(lo, scale), vol));
+		_mm_storeu_ps(&dest[i + 4], _mm_mul_ps(_mm_mul_ps(hi, scale), vol));
+	}
+	return i;
+}
+
+static size_t convertFloatSamplesToI16SSE2(int16_t * __restrict__ dest, size_t samples, const float * __restrict__ src, float volume)
+{
+	const auto vol = _mm_set1_ps(volume);
+	size_t i = 0;
+	for(; i + 8 <= samples; i += 8)
+	{
+		auto a = _mm_mul_ps(_mm_loadu_ps(&src[i]), vol);
+		auto b = _mm_mul_ps(_mm_loadu_ps(&src[i + 4]), vol);
+		_mm_storeu_si128((__m128i*)&dest[i], floatToI16x8(a, b));
+	}
+	return i;
+}
+
+static size_t scaleI16SamplesSSE2(int16_t * __restrict__ dest, size_t samples, const int16_t * __restrict__ src, float volume)
+{
+	const auto scale = _mm_set1_ps(1.f / 32768.f), vol = _mm_set1_ps(volume);
+	size_t i = 0;
+	for(; i + 8 <= samples; i += 8)
+	{
+		__m128 lo, hi;
+		i16x8ToFloat(_mm_loadu_si128((const __m128i*)&src[i]), lo, hi);
+		_mm_storeu_si128((__m128i*)&dest[i],
+			floatToI16x8(_mm_mul_ps(_mm_mul_ps(lo, scale), vol), _mm_mul_ps(_mm_mul_ps(hi, scale), vol)));
+	}
+	return i;
+}
+
+static size_t scaleFloatSamplesSSE2(float * __restrict__ dest, size_t samples, const float * __restrict__ src, float volume)
+{
+	const auto vol = _mm_set1_ps(volume);
+	size_t i = 0;
+	for(; i + 8 <= samples; i += 8)
+	{
+		_mm_storeu_ps(&dest[i], _mm_mul_ps(_mm_loadu_ps(&src[i]), vol));
+		_mm_storeu_ps(&dest[i + 4], _mm_mul_ps(_mm_loadu_ps(&src[i + 4]), vol));
+	}
+	return i;
+}
+
+#endif
+
+#if defined IG_AUDIO_HAS_AVX2_KERNELS
+
+[[gnu::target("avx2")]]
+static __m256i floatToI16x16AVX2(__m256 a, __m256 b)
+{
+	const auto min = _mm256_set1_ps(-1.f), max = _mm256_set1_ps(1.f);
+	const auto one = _mm256_set1_ps(1.f), scale = _mm256_set1_ps(65535.f), half = _mm256_set1_ps(.5f), offset = _mm256_set1_ps(-32768.f);
+	a = _mm256_min_ps(_mm256_max_ps(a, min), max);
+	b = _mm256_min_ps(_mm256_max_ps(b, min), max);
+	a = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_add_ps(a, one), scale), half), offset);
+	b = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_add_ps(b, one), scale), half), offset);
+	// packs works per 128-bit lane, restore sample order afterwards
+	auto packed = _mm256_packs_epi32(_mm256_cvttps_epi32(a), _mm256_cvttps_epi32(b));
+	return _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+[[gnu::target("avx2")]]
+static void i16x16ToFloatAVX2(const int16_t *src, __m256 &lo, __m256 &hi)
+{
+	lo = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)src)));
+	hi = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(src + 8))));
+}
+
+[[gnu::target("avx2")]]
+static size_t convertI16SamplesToFloatAVX2(float * __restrict__ dest, size_t samples, const int16_t * __restrict__ src, float volume)
+{
+	const auto scale = _mm256_set1_ps(1.f / 32768.f), vol = _mm256_set1_ps(volume);
+	size_t i = 0;
+	for(; i + 16 <= samples; i += 16)
+	{
+		__m256 lo, hi;
+		i16x16ToFloatAVX2(&src[i], lo, hi);
+		_mm256_storeu_ps(&dest[i], _mm256_mul_ps(_mm256_mul_ps(lo, scale), vol));
+		_mm256_storeu_ps(&dest[i + 8], _mm256_mul_ps(_mm256_mul_ps(hi, scale), vol));
+	}
+	return i;
+}
+
+[[gnu::target("avx2")]]
+static size_t convertFloatSamplesToI16AVX2(int16_t * __restrict__ dest, size_t samples, const float * __restrict__ src, float volume)
+{
+	const auto vol = _mm256_set1_ps(volume);
+	size_t i = 0;
+	for(; i + 16 <= samples; i += 16)
+	{
+		auto a = _mm256_mul_ps(_mm256_loadu_ps(&src[i]), vol);
+		auto b = _mm256_mul_ps(_mm256_loadu_ps(&src[i + 8]), vol);
+		_mm256_storeu_si256((__m256i*)&dest[i], floatToI16x16AVX2(a, b));
+	}
+	return i;
+}
+
+[[gnu::target("avx2")]]
+static size_t scaleI16SamplesAVX2(int16_t * __restrict__ dest, size_t samples, const int16_t * __restrict__ src, float volume)
+{
+	const auto scale = _mm256_set1_ps(1.f / 32768.f), vol = _mm256_set1_ps(volume);
+	size_t i = 0;
+	for(; i + 16 <= samples; i += 16)
+	{
+		__m256 lo, hi;
+		i16x16ToFloatAVX2(&src[i], lo, hi);
+		_mm256_storeu_si256((__m256i*)&dest[i],
+			floatToI16x16AVX2(_mm256_mul_ps(_mm256_mul_ps(lo, scale), vol), _mm256_mul_ps(_mm256_mul_ps(hi, scale), vol)));
+	}
+	return i;
+}
+
+[[gnu::target("avx2")]]
+static size_t scaleFloatSamplesAVX2(float * __restrict__ dest, size_t samples, const float * __restrict__ src, float volume)
+{
+	const auto vol = _mm256_set1_ps(volume);
+	size_t i = 0;
+	for(; i + 16 <= samples; i += 16)
+	{
+		_mm256_storeu_ps(&dest[i], _mm256_mul_ps(_mm256_loadu_ps(&src[i]), vol));
+		_mm256_storeu_ps(&dest[i + 8], _mm256_mul_ps(_mm256_loadu_ps(&src[i + 8]), vol));
+	}
+	return i;
+}
+
+static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+
+#endif
+
+#if defined __ARM_NEON
+
+static int16x8_t floatToI16x8(float32x4_t a, float32x4_t b)
+{
+	const auto min = vdupq_n_f32(-1.f), max = vdupq_n_f32(1.f);
+	const auto one = vdupq_n_f32(1.f), scale = vdupq_n_f32(65535.f), half = vdupq_n_f32(.5f), offset = vdupq_n_f32(-32768.f);
+	a = vminq_f32(vmaxq_f32(a, min), max);
+	b = vminq_f32(vmaxq_f32(b, min), max);
+	// separate multiply & add to match the scalar rounding instead of a fused vmlaq
+	a = vaddq_f32(vmulq_f32(vmulq_f32(vaddq_f32(a, one), scale), half), offset);
+	b = vaddq_f32(vmulq_f32(vmulq_f32(vaddq_f32(b, one), scale), half), offset);
+	return vcombine_s16(vqmovn_s32(vcvtq_s32_f32(a)), vqmovn_s32(vcvtq_s32_f32(b)));
+}
+
+static void i16x8ToFloat(int16x8_t s, float32x4_t &lo, float32x4_t &hi)
+{
+	lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(s)));
+	hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(s)));
+}
+
+static size_t convertI16SamplesToFloatNEON(float * __restrict__ dest, size_t samples, const int16_t * __restrict__ src, float volume)
+{
+	const auto scale = vdupq_n_f32(1.f / 32768.f), vol = vdupq_n_f32(volume);
+	size_t i = 0;
+	for(; i + 8 <= samples; i += 8)
+	{
+		float32x4_t lo, hi;
+		i16x8ToFloat(vld1q_s16(&src[i]), lo, hi);
+		vst1q_f32(&dest[i], vmulq_f32(vmulq_f32(lo, scale), vol));
+		vst1q_f32(&dest[i + 4], vmulq_f32(vmulq_f32(hi, scale), vol));
+	}
+	return i;
+}
+
+static size_t convertFloatSamplesToI16NEON(int16_t * __restrict__ dest, size_t samples, const float * __restrict__ src, float volume)
+{
+	const auto vol = vdupq_n_f32(volume);
+	size_t i = 0;
+	for(; i + 8 <= samples; i += 8)
+	{
+		auto a = vmulq_f32(vld1q_f32(&src[i]), vol);
+		auto b = vmulq_f32(vld1q_f32(&src[i + 4]), vol);
+		vst1q_s16(&dest[i], floatToI16x8(a, b));
+	}
+	return i;
+}
+
+static size_t scaleI16SamplesNEON(int16_t * __restrict__ dest, size_t samples, const int16_t * __restrict__ src, float volume)
+{
+	const auto scale = vdupq_n_f32(1.f / 32768.f), vol = vdupq_n_f32(volume);
+	size_t i = 0;
+	for(; i + 8 <= samples; i += 8)
+	{
+		float32x4_t lo, hi;
+		i16x8ToFloat(vld1q_s16(&src[i]), lo, hi);
+		vst1q_s16(&dest[i], floatToI16x8(vmulq_f32(vmulq_f32(lo, scale), vol), vmulq_f32(vmulq_f32(hi, scale), vol)));
+	}
+	return i;
+}
+
+static size_t scaleFloatSamplesNEON(float * __restrict__ dest, size_t samples, const float * __restrict__ src, float volume)
+{
+	const auto vol = vdupq_n_f32(volume);
+	size_t i = 0;
+	for(; i + 8 <= samples; i += 8)
+	{
+		vst1q_f32(&dest[i], vmulq_f32(vld1q_f32(&src[i]), vol));
+		vst1q_f32(&dest[i + 4], vmulq_f32(vld1q_f32(&src[i + 4]), vol));
+	}
+	return i;
+}
+
+#endif
+
+static bool sampleKernelsSupported(SampleKernels kernels)
+{
+	switch(kernels)
+	{
+		case SampleKernels::SCALAR: return true;
+		#if defined __SSE2__
+		case SampleKernels::SSE2: return true;
+		#endif
+		#if defined IG_AUDIO_HAS_AVX2_KERNELS
+		case SampleKernels::AVX2: return hasAVX2;
+		#endif
+		#if defined __ARM_NEON
+		case SampleKernels::NEON: return true;
+		#endif
+		default: return false;
+	}
+}
+
+static SampleKernels widestSampleKernels()
+{
+	for(auto k : {SampleKernels::AVX2, SampleKernels::SSE2, SampleKernels::NEON})
+	{
+		if(sampleKernelsSupported(k))
+			return k;
+	}
+	return SampleKernels::SCALAR;
+}
+
+static SampleKernels activeKernels = widestSampleKernels();
+
+bool setSampleKernels(SampleKernels kernels)
+{
+	if(!sampleKernelsSupported(kernels))
+		return false;
+	activeKernels = kernels;
+	return true;
+}
+
+SampleKernels sampleKernels() { return activeKernels; }
+
+// Runs the active kernel, if any
+#if defined IG_AUDIO_HAS_AVX2_KERNELS
+#define IG_AUDIO_VECTOR_KERNEL(name, ...) (activeKernels == SampleKernels::AVX2 ? name##AVX2(__VA_ARGS__) : \
+	activeKernels == SampleKernels::SSE2 ? name##SSE2(__VA_ARGS__) : size_t{})
+#elif defined __SSE2__
+#define IG_AUDIO_VECTOR_KERNEL(name, ...) (activeKernels == SampleKernels::SSE2 ? name##SSE2(__VA_ARGS__) : size_t{})
+#elif defined __ARM_NEON
+#define IG_AUDIO_VECTOR_KERNEL(name, ...) (activeKernels == SampleKernels::NEON ? name##NEON(__VA_ARGS__) : size_t{})
+#else
+#define IG_AUDIO_VECTOR_KERNEL(name, ...) size_t{}
+#endif
+
 static float *convertI16SamplesToFloat(float * __restrict__ dest, size_t samples, const int16_t * __restrict__ src, float volume)
 {
+	auto vecSamples = IG_AUDIO_VECTOR_KERNEL(convertI16SamplesToFloat, dest, samples, src, volume);
+	dest += vecSamples; src += vecSamples; samples -= vecSamples;
 	return transformN(src, samples, dest,
 		[=](int16_t s)
 		{
@@ -39,10 +340,12 @@ static float *convertI16SamplesToFloat(float * __restrict__ dest, size_t samples
 
 static int16_t *convertFloatSamplesToI16(int16_t * __restrict__ dest, size_t samples, const float * __restrict__ src, float volume)
 {
+	auto vecSamples = IG_AUDIO_VECTOR_KERNEL(convertFloatSamplesToI16, dest, samples, src, volume);
+	dest += vecSamples; src += vecSamples; samples -= vecSamples;
 	return transformN(src, samples, dest,
 		[=](float s)
 		{
-			return clamp16FromFloat(s * volume);
+			return clamp16FromFloat(std::clamp(s * volume, -1.f, 1.f));
 		});
 }
 
@@ -54,10 +357,12 @@ static int16_t *copyI16Samples(int16_t * __restrict__ dest, size_t samples, cons
 	}
 	else
 	{
+		auto vecSamples = IG_AUDIO_VECTOR_KERNEL(scaleI16Samples, dest, samples, src, volume);
+		dest += vecSamples; src += vecSamples; samples -= vecSamples;
 		return transformN(src, samples, dest,
 			[=](int16_t s)
 			{
-				return clamp16FromFloat(((float)s / 32768.f) * volume);
+				return clamp16FromFloat(std::clamp(((float)s / 32768.f) * volume, -1.f, 1.f));
 			});
 	}
 }
@@ -70,6 +375,8 @@ static float *copyFloatSamples(float * __restrict__ dest, size_t samples, const
 	}
 	else
 	{
+		auto vecSamples = IG_AUDIO_VECTOR_KERNEL(scaleFloatSamples, dest, samples, src, volume);
+		dest += vecSamples; src += vecSamples; samples -= vecSamples;
 		return transformN(src, samples, dest,
 			[=](float s)
 			{
@@ -313,6 +313,19 @@ std::string ApplicationContext::fileUriFormatLastWriteTimeLocal(IG::CStringView
 	return application().fileUriFormatLastWriteTimeLocal(thisThreadJniEnv(), baseActivityObject(), uri);
 }
 
+FS::file_time_type AndroidApplication::fileUriLastWriteTime(JNIEnv *env, jobject baseActivity, IG::CStringView uri) const
+{
+	// milliseconds since the epoch, 0 if unknown
+	return uriLastModifiedTime(env, baseActivity, env->NewStringUTF(uri)) / 1000;
+}
+
+FS::file_time_type ApplicationContext::fileUriLastWriteTime(IG::CStringView uri) const
+{
+	if(androidSDK() < 19 || !IG::isUri(uri))
+		return FS::status(uri).lastWriteTime();
+	return application().fileUriLastWriteTime(thisThreadJniEnv(), baseActivityObject(), uri);
+}
+
 FS::FileString AndroidApplication::fileUriDisplayName(JNIEnv *env, jobject baseActivity, IG::CStringView uri) const
 {
 	//logMsg("getting display name for URI:%s", uri.data());
@@ -690,6 +703,7 @@ void AndroidApplication::initActivity(JNIEnv *env, jobject baseActivity, jclass
 		openUriFd = {env, baseActivity, "openUriFd", "(Ljava/lang/String;I)I"};
 		uriExists = {env, baseActivity, "uriExists", "(Ljava/lang/String;)Z"};
 		uriLastModified = {env, baseActivity, "uriLastModified", "(Ljava/lang/String;)Ljava/lang/String;"};
+		uriLastModifiedTime = {env, baseActivity, "uriLastModifiedTime", "(Ljava/lang/String;)J"};
 		uriDisplayName = {env, baseActivity, "uriDisplayName", "(Ljava/lang/String;)Ljava/lang/String;"};
 		deleteUri = {env, baseActivity, "deleteUri", "(Ljava/lang/String;Z)Z"};
 		if(androidSDK >= 21)
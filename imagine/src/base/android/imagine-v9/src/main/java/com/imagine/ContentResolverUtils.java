@@ -129,6 +129,11 @@ final class ContentResolverUtils
 		return DateFormat.getDateTimeInstance(DateFormat.SHORT, DateFormat.SHORT).format(new Date(mTime));
 	}
 
+	static long uriLastModifiedTime(ContentResolver resolver, String uriStr)
+	{
+		return queryLong(resolver, Uri.parse(uriStr), DocumentsContract.Document.COLUMN_LAST_MODIFIED, 0);
+	}
+
 	static String uriDisplayName(ContentResolver resolver, Uri uri)
 	{
 		return queryString(resolver, uri, DocumentsContract.Document.COLUMN_DISPLAY_NAME);
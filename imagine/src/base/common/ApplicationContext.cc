@@ -304,6 +304,11 @@ FileIO ApplicationContext::openFileUri(CStringView uri, OpenFlagsMask openFlags)
 	return FS::formatLastWriteTimeLocal(uri);
 }
 
+[[gnu::weak]] FS::file_time_type ApplicationContext::fileUriLastWriteTime(IG::CStringView uri) const
+{
+	return FS::status(uri).lastWriteTime();
+}
+
 [[gnu::weak]] FS::FileString ApplicationContext::fileUriDisplayName(IG::CStringView uri) const
 {
 	return FS::displayName(uri);
@@ -20,16 +20,57 @@
 #include <imagine/gfx/Renderer.hh>
 #include <imagine/gfx/RendererCommands.hh>
 #include <imagine/gfx/GeomQuad.hh>
+#include <imagine/util/container/ArrayList.hh>
 #include <imagine/util/math/int.hh>
 #include <imagine/util/ctype.hh>
 #include <imagine/logger/logger.h>
 #include <algorithm>
+#include <limits>
 
 namespace IG::Gfx
 {
 
+// Collects glyph quads sharing an atlas page so they're drawn with a single texture bind,
+// batches are limited by the range of VertexIndex
+class GlyphQuadBatch
+{
+public:
+	static constexpr size_t maxQuads = (std::numeric_limits<VertexIndex>::max() + 1) / 4;
+
+	GlyphQuadBatch(RendererCommands &cmds, const GlyphTextureSet &face):
+		cmds{cmds}, face{face} {}
+
+	void add(int page, TexQuad quad)
+	{
+		if(page != currPage || quads.isFull())
+		{
+			flush();
+			currPage = page;
+		}
+		quadIdxs.emplace_back(makeRectIndexArray(quads.size()));
+		quads.emplace_back(quad);
+	}
+
+	void flush()
+	{
+		if(quads.empty())
+			return;
+		cmds.setTexture(face.atlasTexture(currPage));
+		drawQuads(cmds, quads, quadIdxs);
+		quads.clear();
+		quadIdxs.clear();
+	}
+
+protected:
+	RendererCommands &cmds;
+	const GlyphTextureSet &face;
+	StaticArrayList<TexQuad, maxQuads> quads;
+	StaticArrayList<std::array<VertexIndex, 6>, maxQuads> quadIdxs;
+	int currPage{-1};
+};
+
 static void drawSpan(RendererCommands &cmds, float xPos, float yPos, ProjectionPlane projP,
-	std::u16string_view strView, TexQuad &vArr, GlyphTextureSet *face_, float spaceSize);
+	std::u16string_view strView, GlyphQuadBatch &batch, GlyphTextureSet *face_, float spaceSize);
 
 Text::Text(GlyphTextureSet *face): Text{{}, face}
 {}
@@ -41,12 +82,14 @@ Text::Text(IG::utf16String str, GlyphTextureSet *face):
 void Text::setString(IG::utf16String str)
 {
 	textStr = std::move(str);
+	glyphGeneration = 0;
 }
 
 void Text::setFace(GlyphTextureSet *face_)
 {
 	assert(face_);
 	this->face_ = face_;
+	glyphGeneration = 0;
 }
 
 static float xSizeOfChar(Renderer &r, GlyphTextureSet *face_, int c, float spaceX, const ProjectionPlane &projP)
@@ -68,9 +111,15 @@ void Text::makeGlyphs(Renderer &r)
 {
 	if(!hasText()) [[unlikely]]
 		return;
-	for(auto c : textStr)
+	// look up the glyphs again if any were evicted since, which can take a second pass if
+	// making one of them evicts another
+	for(int pass = 0; pass < 2 && glyphGeneration != face_->glyphGeneration(); pass++)
 	{
-		face_->glyphEntry(r, c);
+		glyphGeneration = face_->glyphGeneration();
+		for(auto c : textStr)
+		{
+			face_->glyphEntry(r, c);
+		}
 	}
 }
 
@@ -90,6 +139,7 @@ bool Text::compile(Renderer &r, ProjectionPlane projP, TextLayoutConfig conf)
 	float textBlockSize = 0;
 	int textBlockIdx = 0, currLineIdx = 0;
 	int charIdx = 0, charsInLine = 0;
+	glyphGeneration = face_->glyphGeneration();
 	for(auto c : textStr)
 	{
 		auto cSize = xSizeOfChar(r, face_, c, spaceSize, projP);
@@ -158,9 +208,7 @@ void Text::draw(RendererCommands &cmds, float xPos, float yPos, _2DOrigin o, Pro
 		return;
 	//logMsg("drawing with origin: %s,%s", o.toString(o.x), o.toString(o.y));
 	cmds.set(BlendMode::ALPHA);
-	TexQuad vArr;
-	cmds.bindTempVertexBuffer();
-	cmds.setVertexAttribs(vArr.data());
+	GlyphQuadBatch batch{cmds, *face_};
 	_2DOrigin align = o;
 	xPos = o.adjustX(xPos, xSize, LT2DO);
 	//logMsg("aligned to %f, converted to %d", Gfx::alignYToPixel(yPos), toIYPos(Gfx::alignYToPixel(yPos)));
@@ -185,7 +233,7 @@ void Text::draw(RendererCommands &cmds, float xPos, float yPos, _2DOrigin o, Pro
 			auto charsToDraw = span.chars;
 			xPos = startingXPos(xLineSize);
 			//logMsg("line %d, %d chars", l, charsToDraw);
-			drawSpan(cmds, xPos, yPos, projP, std::u16string_view{s, charsToDraw}, vArr, face_, spaceSize);
+			drawSpan(cmds, xPos, yPos, projP, std::u16string_view{s, charsToDraw}, batch, face_, spaceSize);
 			s += charsToDraw;
 			yPos -= nominalHeight_;
 			yPos = projP.alignYToPixel(yPos);
@@ -196,8 +244,9 @@ void Text::draw(RendererCommands &cmds, float xPos, float yPos, _2DOrigin o, Pro
 		float xLineSize = xSize;
 		xPos = startingXPos(xLineSize);
 		//logMsg("line %d, %d chars", l, charsToDraw);
-		drawSpan(cmds, xPos, yPos, projP, std::u16string_view{textStr}, vArr, face_, spaceSize);
+		drawSpan(cmds, xPos, yPos, projP, std::u16string_view{textStr}, batch, face_, spaceSize);
 	}
+	batch.flush();
 }
 
 void Text::draw(RendererCommands &cmds, FP p, _2DOrigin o, ProjectionPlane projP) const
@@ -206,7 +255,7 @@ void Text::draw(RendererCommands &cmds, FP p, _2DOrigin o, ProjectionPlane projP
 }
 
 static void drawSpan(RendererCommands &cmds, float xPos, float yPos, ProjectionPlane projP,
-	std::u16string_view strView, TexQuad &vArr, GlyphTextureSet *face_, float spaceSize)
+	std::u16string_view strView, GlyphQuadBatch &batch, GlyphTextureSet *face_, float spaceSize)
 {
 	auto xViewLimit = projP.wHalf();
 	for(auto c : strView)
@@ -227,15 +276,13 @@ static void drawSpan(RendererCommands &cmds, float xPos, float yPos, ProjectionP
 			//logMsg("skipped %c, off right screen edge", s[i]);
 			continue;
 		}
-		float xSize = projP.unprojectXSize(gly->metrics.xSize);
-		auto x = xPos + projP.unprojectXSize(gly->metrics.xOffset);
-		auto y = yPos - projP.unprojectYSize(gly->metrics.ySize - gly->metrics.yOffset);
-		auto &glyph = gly->glyph();
-		vArr = {{{x, y}, {x + xSize, y + projP.unprojectYSize(gly->metrics.ySize)}}, glyph};
-		cmds.vertexBufferData(vArr.data(), sizeof(vArr));
-		cmds.setTexture(glyph);
-		//logMsg("drawing");
-		cmds.drawPrimitives(Primitive::TRIANGLE_STRIP, 0, 4);
+		if(gly->hasPixels())
+		{
+			float xSize = projP.unprojectXSize(gly->metrics.xSize);
+			auto x = xPos + projP.unprojectXSize(gly->metrics.xOffset);
+			auto y = yPos - projP.unprojectYSize(gly->metrics.ySize - gly->metrics.yOffset);
+			batch.add(gly->pageIndex(), {{{x, y}, {x + xSize, y + projP.unprojectYSize(gly->metrics.ySize)}}, gly->uv});
+		}
 		xPos += projP.unprojectXSize(gly->metrics.xAdvance);
 	}
 }
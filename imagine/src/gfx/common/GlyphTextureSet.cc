@@ -20,6 +20,10 @@
 #include <imagine/gfx/GlyphTextureSet.hh>
 #include <imagine/data-type/image/PixmapSource.hh>
 #include <imagine/logger/logger.h>
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <cstdint>
 #include <cstdlib>
 
 namespace IG::Gfx
@@ -40,6 +44,9 @@ static constexpr int unicodeBmpUsedChars = unicodeBmpChars - unicodeBmpPrivateCh
 
 static constexpr int glyphTableEntries = GlyphTextureSet::supportsUnicode ? unicodeBmpUsedChars : numDrawableAsciiChars;
 
+// each glyph is stored with an empty border so linear filtering never samples its neighbors
+static constexpr int atlasGlyphBorder = 1;
+
 static std::errc mapCharToTable(int c, int &tableIdx);
 
 static int charIsDrawableAscii(int c)
@@ -64,16 +71,30 @@ void GlyphTextureSet::resetGlyphTable()
 	if(!usedGlyphTableBits)
 		return;
 	logMsg("resetting glyph table");
+	glyphGeneration_++;
 	usedGlyphTableBits = 0;
 	glyphTable.resetElements();
+	resetAtlas(false);
+}
+
+void GlyphTextureSet::resetAtlas(bool freeTextures)
+{
+	for(auto &page : atlasPages)
+	{
+		page.shelves.clear();
+		page.yUsed = 0;
+		if(freeTextures)
+			page.texture = {};
+	}
 }
 
 void GlyphTextureSet::freeCaches(uint32_t purgeBits)
 {
 	if(purgeBits == ~0u)
 	{
-		// free the whole table
+		// free the whole table along with the atlas memory
 		resetGlyphTable();
+		resetAtlas(true);
 		return;
 	}
 	auto tableBits = usedGlyphTableBits;
@@ -82,8 +103,10 @@ void GlyphTextureSet::freeCaches(uint32_t purgeBits)
 		if((tableBits & 1) && (purgeBits & 1))
 		{
 			logMsg("purging glyphs from table range %d/31", i);
+			glyphGeneration_++;
+			// atlas space of purged glyphs is reclaimed when their shelf is evicted
 			int firstChar = i << 11;
-			for(auto c : std::views::iota(firstChar, 2048))
+			for(auto c : std::views::iota(firstChar, firstChar + 2048))
 			{
 				int tableIdx;
 				if((bool)mapCharToTable(c, tableIdx))
@@ -91,7 +114,7 @@ void GlyphTextureSet::freeCaches(uint32_t purgeBits)
 					//logMsg( "%c not a known drawable character, skipping", c);
 					continue;
 				}
-				glyphTable[i].~GlyphEntry();
+				glyphTable[tableIdx] = {};
 			}
 			usedGlyphTableBits = IG::clearBits(usedGlyphTableBits, IG::bit(i));
 		}
@@ -145,6 +168,13 @@ bool GlyphTextureSet::setFontSettings(Renderer &r, IG::FontSettings set)
 		return false;
 	resetGlyphTable();
 	settings = set;
+	// size pages to hold a few hundred glyphs, they're allocated on demand up to maxAtlasPages
+	auto pageSize = std::clamp(int(std::bit_ceil(unsigned(settings.pixelHeight()) * 16)), 256, 1024);
+	if(pageSize != atlasPageSize)
+	{
+		resetAtlas(true);
+		atlasPageSize = pageSize;
+	}
 	std::errc ec{};
 	faceSize = font.makeSize(settings, ec);
 	calcMetrics(r);
@@ -169,13 +199,120 @@ std::errc GlyphTextureSet::cacheChar(Renderer &r, int c, int tableIdx)
 		return ec;
 	}
 	//logMsg("setting up table entry %d", tableIdx);
-	glyphTable[tableIdx].metrics = res.metrics;
-	glyphTable[tableIdx].glyph_ = r.makeTexture(res.image, glyphSamplerConfig, false);
+	auto &entry = glyphTable[tableIdx];
+	entry.metrics = res.metrics;
+	auto glyphPix = res.image.pixmap();
+	if(!glyphPix.w() || !glyphPix.h())
+	{
+		entry.page = GlyphEntry::emptyPage;
+	}
+	else
+	{
+		WP slotSize{glyphPix.w() + atlasGlyphBorder * 2, glyphPix.h() + atlasGlyphBorder * 2};
+		auto [pageIdx, shelfIdx] = allocAtlasSlot(r, slotSize);
+		if(pageIdx == -1) [[unlikely]]
+		{
+			logErr("no atlas space for glyph:%c (0x%X) size:%dx%d", c, c, glyphPix.w(), glyphPix.h());
+			return std::errc::not_enough_memory;
+		}
+		auto &page = atlasPages[pageIdx];
+		auto &shelf = page.shelves[shelfIdx];
+		WP slotPos{shelf.xUsed, shelf.y};
+		shelf.xUsed += slotSize.x;
+		shelf.lastUse = ++useCount;
+		shelf.tableIdxs.emplace_back(tableIdx);
+		// write the glyph with its cleared border so old pixels in the slot are overwritten
+		std::vector<uint8_t> slotPixels(slotSize.x * slotSize.y);
+		MutablePixmapView slotPix{{slotSize, glyphPix.format()}, slotPixels.data()};
+		slotPix.write(glyphPix, {atlasGlyphBorder, atlasGlyphBorder});
+		page.texture.write(0, slotPix, slotPos);
+		auto glyphPos = slotPos + WP{atlasGlyphBorder, atlasGlyphBorder};
+		float pageSize = atlasPageSize;
+		entry.uv = {{glyphPos.x / pageSize, glyphPos.y / pageSize},
+			{(glyphPos.x + glyphPix.w()) / pageSize, (glyphPos.y + glyphPix.h()) / pageSize}};
+		entry.shelf = shelfIdx;
+		entry.page = pageIdx + 1;
+	}
 	usedGlyphTableBits |= IG::bit((c >> 11) & 0x1F); // use upper 5 BMP plane bits to map in range 0-31
 	//logMsg("used table bits 0x%X", usedGlyphTableBits);
 	return {};
 }
 
+std::pair<int, int> GlyphTextureSet::allocAtlasSlot(Renderer &r, WP size)
+{
+	if(size.x > atlasPageSize || size.y > atlasPageSize) [[unlikely]]
+		return {-1, -1};
+	// use the shortest shelf the slot fits in, as long as it doesn't waste too much height
+	int bestPage = -1, bestShelf = -1, bestHeight = INT_MAX;
+	for(auto pageIdx : iotaCount(maxAtlasPages))
+	{
+		auto &shelves = atlasPages[pageIdx].shelves;
+		for(auto shelfIdx : iotaCount(shelves.size()))
+		{
+			auto &shelf = shelves[shelfIdx];
+			if(shelf.height >= size.y && shelf.height <= size.y + size.y / 2 && shelf.height < bestHeight &&
+				atlasPageSize - shelf.xUsed >= size.x)
+			{
+				bestPage = pageIdx;
+				bestShelf = shelfIdx;
+				bestHeight = shelf.height;
+			}
+		}
+	}
+	if(bestPage != -1)
+		return {bestPage, bestShelf};
+	// start a new shelf on the first page with room, creating the page texture if needed
+	for(auto pageIdx : iotaCount(maxAtlasPages))
+	{
+		auto &page = atlasPages[pageIdx];
+		if(atlasPageSize - page.yUsed < size.y)
+			continue;
+		if(!page.texture)
+		{
+			logMsg("creating %dx%d glyph atlas page:%d", atlasPageSize, atlasPageSize, pageIdx);
+			page.texture = r.makeTexture({{{atlasPageSize, atlasPageSize}, PIXEL_FMT_A8}, glyphSamplerConfig});
+		}
+		page.shelves.emplace_back(AtlasShelf{.y = int16_t(page.yUsed), .height = int16_t(size.y)});
+		page.yUsed += size.y;
+		return {pageIdx, int(page.shelves.size() - 1)};
+	}
+	// all pages are full, re-use the least recently used shelf that's tall enough
+	uint64_t oldestUse = UINT64_MAX;
+	for(auto pageIdx : iotaCount(maxAtlasPages))
+	{
+		auto &shelves = atlasPages[pageIdx].shelves;
+		for(auto shelfIdx : iotaCount(shelves.size()))
+		{
+			if(shelves[shelfIdx].height >= size.y && shelves[shelfIdx].lastUse < oldestUse)
+			{
+				bestPage = pageIdx;
+				bestShelf = shelfIdx;
+				oldestUse = shelves[shelfIdx].lastUse;
+			}
+		}
+	}
+	if(bestPage == -1)
+		return {-1, -1};
+	evictShelf(bestPage, bestShelf);
+	return {bestPage, bestShelf};
+}
+
+void GlyphTextureSet::evictShelf(int pageIdx, int shelfIdx)
+{
+	auto &shelf = atlasPages[pageIdx].shelves[shelfIdx];
+	logMsg("evicting %zu glyphs from atlas page:%d shelf:%d", shelf.tableIdxs.size(), pageIdx, shelfIdx);
+	glyphGeneration_++;
+	for(auto idx : shelf.tableIdxs)
+	{
+		auto &entry = glyphTable[idx];
+		// skip glyphs that were purged & cached again elsewhere
+		if(entry.pageIndex() == pageIdx && entry.shelf == shelfIdx)
+			entry = {};
+	}
+	shelf.tableIdxs.clear();
+	shelf.xUsed = 0;
+}
+
 static std::errc mapCharToTable(int c, int &tableIdx)
 {
 	if(GlyphTextureSet::supportsUnicode)
@@ -226,7 +363,7 @@ int GlyphTextureSet::precache(Renderer &r, std::string_view string)
 			//logMsg( "%c not a known drawable character, skipping", c);
 			continue;
 		}
-		if(glyphTable[tableIdx].glyph())
+		if(glyphTable[tableIdx].isResident())
 		{
 			//logMsg( "%c already cached", c);
 			continue;
@@ -245,7 +382,8 @@ GlyphEntry *GlyphTextureSet::glyphEntry(Renderer &r, int c, bool allowCache)
 	if((bool)mapCharToTable(c, tableIdx))
 		return nullptr;
 	assert(tableIdx < glyphTableEntries);
-	if(!glyphTable[tableIdx].glyph())
+	auto &entry = glyphTable[tableIdx];
+	if(!entry.isResident())
 	{
 		if(!allowCache)
 		{
@@ -256,7 +394,11 @@ GlyphEntry *GlyphTextureSet::glyphEntry(Renderer &r, int c, bool allowCache)
 			return nullptr;
 		//logMsg("glyph:%c (0x%X) was not in table", c, c);
 	}
-	return &glyphTable[tableIdx];
+	else if(entry.hasPixels())
+	{
+		atlasPages[entry.pageIndex()].shelves[entry.shelf].lastUse = ++useCount;
+	}
+	return &entry;
 }
 
 }
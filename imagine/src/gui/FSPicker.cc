@@ -27,12 +27,99 @@
 #include <imagine/util/math/int.hh>
 #include <imagine/util/format.hh>
 #include <imagine/util/string.h>
+#include <algorithm>
+#include <ctime>
+#include <iterator>
+#include <memory>
 #include <string>
 #include <system_error>
 
 namespace IG
 {
 
+// Recently listed directories shared by all pickers, reused while the directory's modification time is
+// unchanged. Entries are stored before mode/hidden/filter checks so any picker can apply its own.
+class DirListingCache
+{
+public:
+	struct Entry
+	{
+		std::string path;
+		std::string name;
+		FS::file_type type;
+	};
+	using EntryList = std::vector<Entry>;
+
+	std::shared_ptr<const EntryList> find(std::string_view path, FS::file_time_type mTime)
+	{
+		std::scoped_lock lock{mutex};
+		auto it = std::ranges::find(listings, path, &Listing::path);
+		if(it == listings.end())
+			return {};
+		if(it->mTime != mTime)
+		{
+			listings.erase(it);
+			return {};
+		}
+		std::rotate(it, it + 1, listings.end()); // move to most recently used
+		return listings.back().entries;
+	}
+
+	void add(std::string_view path, FS::file_time_type mTime, EntryList entries)
+	{
+		std::scoped_lock lock{mutex};
+		std::erase_if(listings, [&](auto &l){ return l.path == path; });
+		if(listings.size() == maxListings)
+			listings.erase(listings.begin());
+		listings.push_back({std::string{path}, mTime, std::make_shared<const EntryList>(std::move(entries))});
+	}
+
+protected:
+	struct Listing
+	{
+		std::string path;
+		FS::file_time_type mTime;
+		std::shared_ptr<const EntryList> entries;
+	};
+
+	static constexpr size_t maxListings = 4;
+	std::mutex mutex;
+	std::vector<Listing> listings; // least recently used first
+};
+
+static DirListingCache dirListingCache;
+
+// directories first, then by display name
+static constexpr auto fileEntryLess = [](const auto &e1, const auto &e2)
+{
+	if(e1.isDir() != e2.isDir())
+		return e1.isDir();
+	return IG::stringNaturalNoCaseLexCompare(e1.text.text().stringView(), e2.text.text().stringView());
+};
+
+static void mergeSortedEntries(auto &dest, auto &src)
+{
+	auto mid = dest.size();
+	dest.insert(dest.end(), std::make_move_iterator(src.begin()), std::make_move_iterator(src.end()));
+	src.clear();
+	std::inplace_merge(dest.begin(), dest.begin() + mid, dest.end(), fileEntryLess);
+}
+
+void FSPicker::FileMenuItem::compile(Gfx::Renderer &, const Gfx::ProjectionPlane &projP)
+{
+	layoutProjP = &projP;
+}
+
+void FSPicker::FileMenuItem::prepareDraw(Gfx::Renderer &r)
+{
+	if(layoutProjP)
+	{
+		TextMenuItem::compile(r, *layoutProjP);
+		layoutProjP = {};
+	}
+	TextMenuItem::prepareDraw(r);
+}
+
 FSPicker::FSPicker(ViewAttachParams attach, Gfx::TextureSpan backRes, Gfx::TextureSpan closeRes,
 	FilterFunc filter, Mode mode, Gfx::GlyphTextureSet *face_):
 	View{attach},
@@ -71,9 +158,14 @@ FSPicker::FSPicker(ViewAttachParams attach, Gfx::TextureSpan backRes, Gfx::Textu
 			pushFileLocationsView(e);
 		});
 	controller.setNavView(std::move(nav));
-	controller.push(makeView<TableView>([](const TableView &) { return 0; },
+	controller.push(makeView<TableView>([&d = dir](const TableView &) { return d.size(); },
 		[&d = dir](const TableView &, size_t idx) -> MenuItem& { return d[idx].text; }));
 	controller.navView()->showLeftBtn(true);
+	fileTableView().setOnSelectElement(
+		[this](const Input::Event &e, int i, MenuItem &)
+		{
+			selectDirEntry(i, e);
+		});
 	dir.reserve(16); // start with some initial capacity to avoid small reallocations
 }
 
@@ -158,22 +250,19 @@ void FSPicker::prepareDraw()
 
 void FSPicker::draw(Gfx::RendererCommands &__restrict__ cmds)
 {
-	if(!dirListThread.isWorking())
+	if(dir.size())
 	{
-		if(dir.size())
-		{
-			controller.top().draw(cmds);
-		}
-		else
-		{
-			using namespace IG::Gfx;
-			cmds.set(ColorName::WHITE);
-			cmds.basicEffect().enableAlphaTexture(cmds);
-			auto textRect = controller.top().viewRect();
-			if(IG::isOdd(textRect.ySize()))
-				textRect.y2--;
-			msgText.draw(cmds, projP.unProjectRect(textRect).pos(C2DO), C2DO, projP);
-		}
+		controller.top().draw(cmds);
+	}
+	else if(!dirListThread.isWorking())
+	{
+		using namespace IG::Gfx;
+		cmds.set(ColorName::WHITE);
+		cmds.basicEffect().enableAlphaTexture(cmds);
+		auto textRect = controller.top().viewRect();
+		if(IG::isOdd(textRect.ySize()))
+			textRect.y2--;
+		msgText.draw(cmds, projP.unProjectRect(textRect).pos(C2DO), C2DO, projP);
 	}
 	controller.navView()->draw(cmds);
 }
@@ -190,6 +279,7 @@ void FSPicker::setEmptyPath(std::string_view message)
 	dirListEvent.cancel();
 	root = {};
 	dir.clear();
+	pendingDir.clear();
 	msgText.setString(message);
 	if(mode_ == Mode::FILE_IN_DIR)
 	{
@@ -436,14 +526,11 @@ void FSPicker::startDirectoryListThread(CStringView path)
 		return;
 	}
 	dir.clear();
-	fileTableView().setItemsDelegate();
+	pendingDir.clear();
+	fileTableView().resetScroll();
 	dirListEvent.setCallback([this]()
 	{
-		fileTableView().setItemsDelegate([&d = dir](const TableView &) { return d.size(); });
-		if(highlightFirstDirEntry)
-			fileTableView().highlightCell(0);
-		else
-			fileTableView().resetScroll();
+		addPendingDirEntries();
 		place();
 		postDraw();
 	});
@@ -460,75 +547,87 @@ void FSPicker::startDirectoryListThread(CStringView path)
 
 void FSPicker::listDirectory(IG::CStringView path, ThreadStop &stop)
 {
+	// entries are sent to the main thread in sorted batches, starting small so the first page shows quickly
+	static constexpr size_t firstBatchSize = 64, maxBatchSize = 8192;
+	std::vector<FileEntry> batch;
+	size_t batchSize = firstBatchSize;
+	size_t entries{};
+	auto addEntry = [&](const FS::directory_entry &entry)
+	{
+		bool isDir = entry.type() == FS::file_type::directory;
+		if(mode_ == Mode::DIR) // filter non-directories
+		{
+			if(!isDir)
+				return;
+		}
+		else if(mode_ == Mode::FILE_IN_DIR) // filter directories
+		{
+			if(isDir)
+				return;
+		}
+		if(!showHiddenFiles_ && entry.name().starts_with('.'))
+		{
+			return;
+		}
+		if(filter && !filter(entry))
+		{
+			return;
+		}
+		auto &item = batch.emplace_back(FileEntry{std::string{entry.path()}, {entry.name(), &face(), nullptr}});
+		if(isDir)
+			item.text.setFlags(item.text.flags() | FileEntry::IS_DIR_FLAG);
+		entries++;
+		if(batch.size() == batchSize)
+		{
+			sendDirEntries(batch);
+			batchSize = std::min(batchSize * 2, maxBatchSize);
+		}
+	};
 	try
 	{
-		appContext().forEachInDirectoryUri(path,
-			[this, &stop](auto &entry)
+		auto mTime = appContext().fileUriLastWriteTime(path);
+		if(auto cachedEntries = mTime ? dirListingCache.find(path, mTime) : nullptr;
+			cachedEntries)
+		{
+			logMsg("using cached listing with %zu entries", cachedEntries->size());
+			for(auto &e : *cachedEntries)
 			{
-				//logMsg("entry:%s", entry.path().data());
 				if(stop) [[unlikely]]
 				{
 					logMsg("interrupted listing directory");
-					return false;
-				}
-				bool isDir = entry.type() == FS::file_type::directory;
-				if(mode_ == Mode::DIR) // filter non-directories
-				{
-					if(!isDir)
-						return true;
-				}
-				else if(mode_ == Mode::FILE_IN_DIR) // filter directories
-				{
-					if(isDir)
-						return true;
-				}
-				if(!showHiddenFiles_ && entry.name().starts_with('.'))
-				{
-					return true;
+					return;
 				}
-				if(filter && !filter(entry))
+				addEntry(FS::directory_entry{e.path, e.name, e.type});
+			}
+		}
+		else
+		{
+			// skip caching directories modified within the timestamp's resolution since they may still change
+			bool cacheListing = mTime && mTime < std::time(nullptr) - 1;
+			DirListingCache::EntryList listing;
+			auto listingPtr = cacheListing ? &listing : nullptr;
+			appContext().forEachInDirectoryUri(path,
+				[&stop, listingPtr, &addEntry](auto &entry)
 				{
+					//logMsg("entry:%s", entry.path().data());
+					if(stop) [[unlikely]]
+					{
+						logMsg("interrupted listing directory");
+						return false;
+					}
+					if(listingPtr)
+						listingPtr->push_back({std::string{entry.path()}, std::string{entry.name()}, entry.type()});
+					addEntry(entry);
 					return true;
-				}
-				auto &item = dir.emplace_back(FileEntry{std::string{entry.path()}, {entry.name(), &face(), nullptr}});
-				if(isDir)
-					item.text.setFlags(item.text.flags() | FileEntry::IS_DIR_FLAG);
-				return true;
-			});
-		std::sort(dir.begin(), dir.end(),
-			[](const FileEntry &e1, const FileEntry &e2)
-			{
-				if(e1.isDir() && !e2.isDir())
-					return true;
-				else if(!e1.isDir() && e2.isDir())
-					return false;
-				else
-					return IG::stringNoCaseLexCompare(e1.path, e2.path);
-			});
-		if(dir.size())
+				});
+			if(stop)
+				return;
+			if(cacheListing)
+				dirListingCache.add(path, mTime, std::move(listing));
+		}
+		sendDirEntries(batch);
+		if(entries)
 		{
-			for(auto &d : dir)
-			{
-				if(d.isDir())
-				{
-					d.text.setOnSelect(
-						[this, &dirPath = d.path](const Input::Event &e)
-						{
-							assert(!isSingleDirectoryMode());
-							auto path = std::move(dirPath);
-							logMsg("entering dir:%s", path.data());
-							changeDirByInput(path, root.info, e);
-						});
-				}
-				else
-				{
-					d.text.setOnSelect(
-						[this, &dirPath = d.path](const Input::Event &e)
-						{
-							onSelectPath_.callCopy(*this, dirPath, appContext().fileUriDisplayName(dirPath), e);
-						});
-				}
-			}
 			msgText.setString({});
 		}
 		else // no entries, show a message instead
@@ -545,4 +644,62 @@ void FSPicker::listDirectory(IG::CStringView path, ThreadStop &stop)
 	}
 }
 
+void FSPicker::sendDirEntries(std::vector<FileEntry> &batch)
+{
+	if(batch.empty())
+		return;
+	std::ranges::sort(batch, fileEntryLess);
+	{
+		std::scoped_lock lock{pendingDirMutex};
+		if(pendingDir.empty())
+			std::swap(pendingDir, batch);
+		else
+			mergeSortedEntries(pendingDir, batch);
+	}
+	dirListEvent.notify();
+}
+
+void FSPicker::addPendingDirEntries()
+{
+	std::vector<FileEntry> batch;
+	{
+		std::scoped_lock lock{pendingDirMutex};
+		std::swap(batch, pendingDir);
+	}
+	if(batch.empty())
+		return;
+	auto &table = fileTableView();
+	if(dir.empty())
+	{
+		dir = std::move(batch);
+		if(highlightFirstDirEntry)
+			table.highlightCell(0);
+		else
+			table.resetScroll();
+		return;
+	}
+	// keep the highlighted entry selected as others are merged around it
+	auto highlightedIdx = table.highlightedCell();
+	std::string highlightedPath = highlightedIdx >= 0 ? dir[highlightedIdx].path : std::string{};
+	mergeSortedEntries(dir, batch);
+	if(highlightedPath.size())
+		table.highlightCell(std::distance(dir.begin(), std::ranges::find(dir, highlightedPath, &FileEntry::path)));
+}
+
+void FSPicker::selectDirEntry(size_t idx, const Input::Event &e)
+{
+	auto &entry = dir[idx];
+	if(entry.isDir())
+	{
+		assert(!isSingleDirectoryMode());
+		auto path = entry.path; // dir is cleared when changing paths
+		logMsg("entering dir:%s", path.data());
+		changeDirByInput(path, root.info, e);
+	}
+	else
+	{
+		onSelectPath_.callCopy(*this, entry.path, appContext().fileUriDisplayName(entry.path), e);
+	}
+}
+
 }
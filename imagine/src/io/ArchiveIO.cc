@@ -200,6 +200,14 @@ uint32_t ArchiveEntry::crc32() const
 	return archive_entry_crc32(ptr);
 }
 
+bool ArchiveEntry::canBeSolid() const
+{
+	// libarchive doesn't report if an archive is solid, so assume any format that supports it is
+	assumeExpr(arch);
+	auto format = archive_format(arch.get()) & ARCHIVE_FORMAT_BASE_MASK;
+	return format == ARCHIVE_FORMAT_7ZIP || format == ARCHIVE_FORMAT_RAR;
+}
+
 ArchiveIO ArchiveEntry::moveIO()
 {
 	return ArchiveIO{std::move(*this)};
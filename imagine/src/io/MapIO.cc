@@ -21,6 +21,7 @@
 #include "IOUtils.hh"
 #include <cerrno>
 #include <cstring>
+#include <algorithm>
 #if defined __linux__ || defined __APPLE__
 #include <sys/mman.h>
 #include <imagine/util/system/pagesize.h>
@@ -58,8 +59,18 @@ std::span<uint8_t> MapIO::map()
 
 ssize_t MapIO::write(const void *buff, size_t bytes)
 {
-	// TODO
-	return -1;
+	// writes in-place without growing the buffer, the underlying memory must be writable
+	if(currPos >= dataEnd())
+	{
+		if(!data()) [[unlikely]]
+			return -1;
+		else
+			return 0;
+	}
+	size_t bytesToWrite = std::min(bytes, size_t(dataEnd() - currPos));
+	memcpy(currPos, buff, bytesToWrite);
+	currPos += bytesToWrite;
+	return bytesToWrite;
 }
 
 off_t MapIO::seek(off_t offset, IOSeekMode mode)
@@ -13,7 +13,21 @@
 	You should have received a copy of the GNU General Public License
 	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
 
+#include <imagine/pixmap/Pixmap.hh>
 #include <imagine/util/container/array.hh>
+#include <imagine/util/algorithm.h>
+#include <bit>
+#if defined __SSE2__
+#include <emmintrin.h>
+#if defined __GNUC__
+#include <tmmintrin.h>
+#include <immintrin.h>
+#define IG_PIXMAP_HAS_SSSE3_KERNELS
+#define IG_PIXMAP_HAS_AVX2_KERNELS
+#endif
+#elif defined __ARM_NEON
+#include <arm_neon.h>
+#endif
 
 namespace IG
 {
@@ -106,4 +120,544 @@ static uint32_t transformRGB888ToRGBX8888Impl(ByteArray<3> p)
 uint32_t transformRGB888ToRGBX8888(ByteArray<3> p) { return transformRGB888ToRGBX8888Impl(p); }
 uint32_t transformRGB888ToBGRX8888(ByteArray<3> p) { return transformRGB888ToRGBX8888Impl<true>(p); }
 
+// Row converters: a vector kernel handles the bulk of each row and returns the number of pixels
+// processed, then the remainder goes through the scalar functions above. All kernels produce
+// the exact same output as the scalar versions.
+
+#if defined __SSE2__
+
+// 5/6-bit to 8-bit expansion, (c * 255 + 15) / 31 & (c * 255 + 31) / 63 using a multiply-high
+static __m128i expand5To8(__m128i c)
+{
+	auto x = _mm_add_epi16(_mm_mullo_epi16(c, _mm_set1_epi16(255)), _mm_set1_epi16(15));
+	return _mm_srli_epi16(_mm_mulhi_epu16(x, _mm_set1_epi16(8457)), 2);
+}
+
+static __m128i expand6To8(__m128i c)
+{
+	auto x = _mm_add_epi16(_mm_mullo_epi16(c, _mm_set1_epi16(255)), _mm_set1_epi16(31));
+	return _mm_srli_epi16(_mm_mulhi_epu16(x, _mm_set1_epi16(16645)), 4);
+}
+
+// (c * bits + 127) / 255 with the division done as (x + 1 + (x >> 8)) >> 8
+static __m128i reduce8(__m128i c, int16_t maxVal)
+{
+	auto x = _mm_add_epi16(_mm_mullo_epi16(c, _mm_set1_epi16(maxVal)), _mm_set1_epi16(127));
+	return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8)), 8);
+}
+
+// 8 RGB565 pixels to 8 RGBX8888 or BGRX8888 pixels in lo & hi
+template <bool BGR_SWAP>
+static void rgb565ToRGBX8888x8(__m128i p, __m128i &lo, __m128i &hi)
+{
+	auto r = expand5To8(_mm_srli_epi16(p, 11));
+	auto g = expand6To8(_mm_and_si128(_mm_srli_epi16(p, 5), _mm_set1_epi16(0x3F)));
+	auto b = expand5To8(_mm_and_si128(p, _mm_set1_epi16(0x1F)));
+	if constexpr(BGR_SWAP) { std::swap(r, b); }
+	auto rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));
+	lo = _mm_unpacklo_epi16(rg, b);
+	hi = _mm_unpackhi_epi16(rg, b);
+}
+
+// 8 RGBX8888 or BGRX8888 pixels in lo & hi to 8 RGB565 pixels
+template <bool BGR_SWAP>
+static __m128i rgbx8888ToRGB565x8(__m128i lo, __m128i hi)
+{
+	// split into 16-bit lanes of R|G<<8 and B|X<<8, sign extending so the pack is lossless
+	auto rg = _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(lo, 16), 16), _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16));
+	auto bx = _mm_packs_epi32(_mm_srai_epi32(lo, 16), _mm_srai_epi32(hi, 16));
+	auto byteMask = _mm_set1_epi16(0xFF);
+	auto r = reduce8(_mm_and_si128(rg, byteMask), 31);
+	auto g = reduce8(_mm_srli_epi16(rg, 8), 63);
+	auto b = reduce8(_mm_and_si128(bx, byteMask), 31);
+	if constexpr(BGR_SWAP) { std::swap(r, b); }
+	return _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b);
+}
+
+template <bool BGR_SWAP>
+static size_t convertRowRGB565ToRGBX8888SSE2(uint32_t * __restrict__ dest, const uint16_t * __restrict__ src, size_t pixels)
+{
+	size_t i = 0;
+	for(; i + 8 <= pixels; i += 8)
+	{
+		__m128i lo, hi;
+		rgb565ToRGBX8888x8<BGR_SWAP>(_mm_loadu_si128((const __m128i*)&src[i]), lo, hi);
+		_mm_storeu_si128((__m128i*)&dest[i], lo);
+		_mm_storeu_si128((__m128i*)&dest[i + 4], hi);
+	}
+	return i;
+}
+
+template <bool BGR_SWAP>
+static size_t convertRowRGBX8888ToRGB565SSE2(uint16_t * __restrict__ dest, const uint32_t * __restrict__ src, size_t pixels)
+{
+	size_t i = 0;
+	for(; i + 8 <= pixels; i += 8)
+	{
+		_mm_storeu_si128((__m128i*)&dest[i], rgbx8888ToRGB565x8<BGR_SWAP>(
+			_mm_loadu_si128((const __m128i*)&src[i]), _mm_loadu_si128((const __m128i*)&src[i + 4])));
+	}
+	return i;
+}
+
+static size_t convertRowRGBA8888ToBGRA8888SSE2(uint32_t * __restrict__ dest, const uint32_t * __restrict__ src, size_t pixels)
+{
+	size_t i = 0;
+	for(; i + 4 <= pixels; i += 4)
+	{
+		auto p = _mm_loadu_si128((const __m128i*)&src[i]);
+		auto ga = _mm_and_si128(p, _mm_set1_epi32(0xFF00FF00));
+		auto r = _mm_and_si128(_mm_slli_epi32(p, 16), _mm_set1_epi32(0xFF0000));
+		auto b = _mm_and_si128(_mm_srli_epi32(p, 16), _mm_set1_epi32(0xFF));
+		_mm_storeu_si128((__m128i*)&dest[i], _mm_or_si128(_mm_or_si128(ga, r), b));
+	}
+	return i;
+}
+
+#endif
+
+#if defined IG_PIXMAP_HAS_SSSE3_KERNELS
+
+// RGB888 rows are handled 4 pixels (12 bytes) at a time with full 16-byte loads/stores,
+// so each loop stops early enough that the extra bytes stay inside the row
+
+static const bool hasSSSE3 = __builtin_cpu_supports("ssse3");
+
+template <bool BGR_SWAP>
+static __m128i rgb888Compact4Mask()
+{
+	if constexpr(BGR_SWAP)
+		return _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+	else
+		return _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+}
+
+// matches transformRGB888ToRGBX8888(), which places the first byte in bits 16-23
+template <bool BGR_SWAP>
+static __m128i rgb888Expand4Mask()
+{
+	if constexpr(BGR_SWAP)
+		return _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+	else
+		return _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+}
+
+template <bool BGR_SWAP>
+[[gnu::target("ssse3")]]
+static size_t convertRowRGBX8888ToRGB888SSSE3(uint8_t * __restrict__ dest, const uint32_t * __restrict__ src, size_t pixels)
+{
+	auto mask = rgb888Compact4Mask<BGR_SWAP>();
+	size_t i = 0;
+	for(; i + 6 <= pixels; i += 4)
+	{
+		_mm_storeu_si128((__m128i*)&dest[i * 3], _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&src[i]), mask));
+	}
+	return i;
+}
+
+template <bool BGR_SWAP>
+[[gnu::target("ssse3")]]
+static size_t convertRowRGB888ToRGBX8888SSSE3(uint32_t * __restrict__ dest, const uint8_t * __restrict__ src, size_t pixels)
+{
+	auto mask = rgb888Expand4Mask<BGR_SWAP>();
+	size_t i = 0;
+	for(; i + 6 <= pixels; i += 4)
+	{
+		_mm_storeu_si128((__m128i*)&dest[i], _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&src[i * 3]), mask));
+	}
+	return i;
+}
+
+[[gnu::target("ssse3")]]
+static size_t convertRowRGB565ToRGB888SSSE3(uint8_t * __restrict__ dest, const uint16_t * __restrict__ src, size_t pixels)
+{
+	auto mask = rgb888Compact4Mask<false>();
+	size_t i = 0;
+	for(; i + 10 <= pixels; i += 8)
+	{
+		__m128i lo, hi;
+		rgb565ToRGBX8888x8<false>(_mm_loadu_si128((const __m128i*)&src[i]), lo, hi);
+		_mm_storeu_si128((__m128i*)&dest[i * 3], _mm_shuffle_epi8(lo, mask));
+		_mm_storeu_si128((__m128i*)&dest[i * 3 + 12], _mm_shuffle_epi8(hi, mask));
+	}
+	return i;
+}
+
+[[gnu::target("ssse3")]]
+static size_t convertRowRGB888ToRGB565SSSE3(uint16_t * __restrict__ dest, const uint8_t * __restrict__ src, size_t pixels)
+{
+	// expand to RGBX8888 order so the first byte becomes red
+	auto mask = rgb888Expand4Mask<true>();
+	size_t i = 0;
+	for(; i + 10 <= pixels; i += 8)
+	{
+		auto lo = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&src[i * 3]), mask);
+		auto hi = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&src[i * 3 + 12]), mask);
+		_mm_storeu_si128((__m128i*)&dest[i], rgbx8888ToRGB565x8<false>(lo, hi));
+	}
+	return i;
+}
+
+#endif
+
+#if defined __ARM_NEON
+
+static uint16x8_t mulHigh(uint16x8_t x, uint16_t m)
+{
+	return vcombine_u16(vshrn_n_u32(vmull_n_u16(vget_low_u16(x), m), 16),
+		vshrn_n_u32(vmull_n_u16(vget_high_u16(x), m), 16));
+}
+
+static uint8x8_t expand5To8(uint16x8_t c)
+{
+	return vshrn_n_u16(mulHigh(vmlaq_n_u16(vdupq_n_u16(15), c, 255), 8457), 2);
+}
+
+static uint8x8_t expand6To8(uint16x8_t c)
+{
+	return vshrn_n_u16(mulHigh(vmlaq_n_u16(vdupq_n_u16(31), c, 255), 16645), 4);
+}
+
+static uint16x8_t reduce8(uint8x8_t c, uint8_t maxVal)
+{
+	auto x = vmlal_u8(vdupq_n_u16(127), c, vdup_n_u8(maxVal));
+	return vshrq_n_u16(vaddq_u16(vaddq_u16(x, vdupq_n_u16(1)), vshrq_n_u16(x, 8)), 8);
+}
+
+// 8 RGB565 pixels to separate R, G, B channels
+static uint8x8x3_t rgb565ToRGB888x8(uint16x8_t p)
+{
+	return {{expand5To8(vshrq_n_u16(p, 11)), expand6To8(vandq_u16(vshrq_n_u16(p, 5), vdupq_n_u16(0x3F))),
+		expand5To8(vandq_u16(p, vdupq_n_u16(0x1F)))}};
+}
+
+static uint16x8_t rgb888ToRGB565x8(uint8x8_t r, uint8x8_t g, uint8x8_t b)
+{
+	return vorrq_u16(vorrq_u16(vshlq_n_u16(reduce8(r, 31), 11), vshlq_n_u16(reduce8(g, 63), 5)), reduce8(b, 31));
+}
+
+template <bool BGR_SWAP>
+static size_t convertRowRGB565ToRGBX8888NEON(uint32_t * __restrict__ dest, const uint16_t * __restrict__ src, size_t pixels)
+{
+	size_t i = 0;
+	for(; i + 8 <= pixels; i += 8)
+	{
+		auto rgb = rgb565ToRGB888x8(vld1q_u16(&src[i]));
+		if constexpr(BGR_SWAP) { std::swap(rgb.val[0], rgb.val[2]); }
+		vst4_u8((uint8_t*)&dest[i], uint8x8x4_t{{rgb.val[0], rgb.val[1], rgb.val[2], vdup_n_u8(0)}});
+	}
+	return i;
+}
+
+template <bool BGR_SWAP>
+static size_t convertRowRGBX8888ToRGB565NEON(uint16_t * __restrict__ dest, const uint32_t * __restrict__ src, size_t pixels)
+{
+	size_t i = 0;
+	for(; i + 8 <= pixels; i += 8)
+	{
+		auto p = vld4_u8((const uint8_t*)&src[i]);
+		if constexpr(BGR_SWAP) { std::swap(p.val[0], p.val[2]); }
+		vst1q_u16(&dest[i], rgb888ToRGB565x8(p.val[0], p.val[1], p.val[2]));
+	}
+	return i;
+}
+
+static size_t convertRowRGBA8888ToBGRA8888NEON(uint32_t * __restrict__ dest, const uint32_t * __restrict__ src, size_t pixels)
+{
+	size_t i = 0;
+	for(; i + 16 <= pixels; i += 16)
+	{
+		auto p = vld4q_u8((const uint8_t*)&src[i]);
+		std::swap(p.val[0], p.val[2]);
+		vst4q_u8((uint8_t*)&dest[i], p);
+	}
+	return i;
+}
+
+template <bool BGR_SWAP>
+static size_t convertRowRGBX8888ToRGB888NEON(uint8_t * __restrict__ dest, const uint32_t * __restrict__ src, size_t pixels)
+{
+	size_t i = 0;
+	for(; i + 16 <= pixels; i += 16)
+	{
+		auto p = vld4q_u8((const uint8_t*)&src[i]);
+		if constexpr(BGR_SWAP) { std::swap(p.val[0], p.val[2]); }
+		vst3q_u8(&dest[i * 3], uint8x16x3_t{{p.val[0], p.val[1], p.val[2]}});
+	}
+	return i;
+}
+
+// matches transformRGB888ToRGBX8888(), which places the first byte in bits 16-23
+template <bool BGR_SWAP>
+static size_t convertRowRGB888ToRGBX8888NEON(uint32_t * __restrict__ dest, const uint8_t * __restrict__ src, size_t pixels)
+{
+	size_t i = 0;
+	for(; i + 16 <= pixels; i += 16)
+	{
+		auto p = vld3q_u8(&src[i * 3]);
+		if constexpr(!BGR_SWAP) { std::swap(p.val[0], p.val[2]); }
+		vst4q_u8((uint8_t*)&dest[i], uint8x16x4_t{{p.val[0], p.val[1], p.val[2], vdupq_n_u8(0)}});
+	}
+	return i;
+}
+
+static size_t convertRowRGB565ToRGB888NEON(uint8_t * __restrict__ dest, const uint16_t * __restrict__ src, size_t pixels)
+{
+	size_t i = 0;
+	for(; i + 8 <= pixels; i += 8)
+	{
+		vst3_u8(&dest[i * 3], rgb565ToRGB888x8(vld1q_u16(&src[i])));
+	}
+	return i;
+}
+
+static size_t convertRowRGB888ToRGB565NEON(uint16_t * __restrict__ dest, const uint8_t * __restrict__ src, size_t pixels)
+{
+	size_t i = 0;
+	for(; i + 8 <= pixels; i += 8)
+	{
+		auto p = vld3_u8(&src[i * 3]);
+		vst1q_u16(&dest[i], rgb888ToRGB565x8(p.val[0], p.val[1], p.val[2]));
+	}
+	return i;
+}
+
+#endif
+
+template <bool BGR_SWAP>
+static void convertRowRGB565ToRGBX8888Impl(uint32_t * __restrict__ dest, const uint16_t * __restrict__ src, size_t pixels)
+{
+	size_t i = 0;
+	#if defined __SSE2__
+	i = convertRowRGB565ToRGBX8888SSE2<BGR_SWAP>(dest, src, pixels);
+	#elif defined __ARM_NEON
+	i = convertRowRGB565ToRGBX8888NEON<BGR_SWAP>(dest, src, pixels);
+	#endif
+	transformN(src + i, pixels - i, dest + i, transformRGB565ToRGBX8888Impl<BGR_SWAP>);
+}
+
+void convertRowRGB565ToRGBX8888(uint32_t *dest, const uint16_t *src, size_t pixels) { convertRowRGB565ToRGBX8888Impl<false>(dest, src, pixels); }
+void convertRowRGB565ToBGRX8888(uint32_t *dest, const uint16_t *src, size_t pixels) { convertRowRGB565ToRGBX8888Impl<true>(dest, src, pixels); }
+
+template <bool BGR_SWAP>
+static void convertRowRGBX8888ToRGB565Impl(uint16_t * __restrict__ dest, const uint32_t * __restrict__ src, size_t pixels)
+{
+	size_t i = 0;
+	#if defined __SSE2__
+	i = convertRowRGBX8888ToRGB565SSE2<BGR_SWAP>(dest, src, pixels);
+	#elif defined __ARM_NEON
+	i = convertRowRGBX8888ToRGB565NEON<BGR_SWAP>(dest, src, pixels);
+	#endif
+	transformN(src + i, pixels - i, dest + i, transformRGBX8888ToRGB565Impl<BGR_SWAP>);
+}
+
+void convertRowRGBX8888ToRGB565(uint16_t *dest, const uint32_t *src, size_t pixels) { convertRowRGBX8888ToRGB565Impl<false>(dest, src, pixels); }
+void convertRowBGRX8888ToRGB565(uint16_t *dest, const uint32_t *src, size_t pixels) { convertRowRGBX8888ToRGB565Impl<true>(dest, src, pixels); }
+
+void convertRowRGBA8888ToBGRA8888(uint32_t * __restrict__ dest, const uint32_t * __restrict__ src, size_t pixels)
+{
+	size_t i = 0;
+	#if defined __SSE2__
+	i = convertRowRGBA8888ToBGRA8888SSE2(dest, src, pixels);
+	#elif defined __ARM_NEON
+	i = convertRowRGBA8888ToBGRA8888NEON(dest, src, pixels);
+	#endif
+	transformN(src + i, pixels - i, dest + i, transformRGBA8888ToBGRA8888);
+}
+
+template <bool BGR_SWAP>
+static void convertRowRGBX8888ToRGB888Impl(ByteArray<3> * __restrict__ dest, const uint32_t * __restrict__ src, size_t pixels)
+{
+	size_t i = 0;
+	#if defined IG_PIXMAP_HAS_SSSE3_KERNELS
+	if(hasSSSE3)
+		i = convertRowRGBX8888ToRGB888SSSE3<BGR_SWAP>((uint8_t*)dest, src, pixels);
+	#elif defined __ARM_NEON
+	i = convertRowRGBX8888ToRGB888NEON<BGR_SWAP>((uint8_t*)dest, src, pixels);
+	#endif
+	transformN(src + i, pixels - i, dest + i, transformRGBX8888ToRGB888Impl<BGR_SWAP>);
+}
+
+void convertRowRGBX8888ToRGB888(ByteArray<3> *dest, const uint32_t *src, size_t pixels) { convertRowRGBX8888ToRGB888Impl<false>(dest, src, pixels); }
+void convertRowBGRX8888ToRGB888(ByteArray<3> *dest, const uint32_t *src, size_t pixels) { convertRowRGBX8888ToRGB888Impl<true>(dest, src, pixels); }
+
+template <bool BGR_SWAP>
+static void convertRowRGB888ToRGBX8888Impl(uint32_t * __restrict__ dest, const ByteArray<3> * __restrict__ src, size_t pixels)
+{
+	size_t i = 0;
+	#if defined IG_PIXMAP_HAS_SSSE3_KERNELS
+	if(hasSSSE3)
+		i = convertRowRGB888ToRGBX8888SSSE3<BGR_SWAP>(dest, (const uint8_t*)src, pixels);
+	#elif defined __ARM_NEON
+	i = convertRowRGB888ToRGBX8888NEON<BGR_SWAP>(dest, (const uint8_t*)src, pixels);
+	#endif
+	transformN(src + i, pixels - i, dest + i, transformRGB888ToRGBX8888Impl<BGR_SWAP>);
+}
+
+void convertRowRGB888ToRGBX8888(uint32_t *dest, const ByteArray<3> *src, size_t pixels) { convertRowRGB888ToRGBX8888Impl<false>(dest, src, pixels); }
+void convertRowRGB888ToBGRX8888(uint32_t *dest, const ByteArray<3> *src, size_t pixels) { convertRowRGB888ToRGBX8888Impl<true>(dest, src, pixels); }
+
+void convertRowRGB565ToRGB888(ByteArray<3> * __restrict__ dest, const uint16_t * __restrict__ src, size_t pixels)
+{
+	size_t i = 0;
+	#if defined IG_PIXMAP_HAS_SSSE3_KERNELS
+	if(hasSSSE3)
+		i = convertRowRGB565ToRGB888SSSE3((uint8_t*)dest, src, pixels);
+	#elif defined __ARM_NEON
+	i = convertRowRGB565ToRGB888NEON((uint8_t*)dest, src, pixels);
+	#endif
+	transformN(src + i, pixels - i, dest + i, transformRGB565ToRGB888);
+}
+
+void convertRowRGB888ToRGB565(uint16_t * __restrict__ dest, const ByteArray<3> * __restrict__ src, size_t pixels)
+{
+	size_t i = 0;
+	#if defined IG_PIXMAP_HAS_SSSE3_KERNELS
+	if(hasSSSE3)
+		i = convertRowRGB888ToRGB565SSSE3(dest, (const uint8_t*)src, pixels);
+	#elif defined __ARM_NEON
+	i = convertRowRGB888ToRGB565NEON(dest, (const uint8_t*)src, pixels);
+	#endif
+	transformN(src + i, pixels - i, dest + i, transformRGB888ToRGB565);
+}
+
+// Indexed rows
+
+#if defined IG_PIXMAP_HAS_AVX2_KERNELS
+
+// Palette lookups use AVX2 gathers, 8 pixels per iteration
+
+static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+
+template <class Index>
+[[gnu::target("avx2")]]
+static __m256i loadIndexesx8(const Index *src, __m256i indexMask)
+{
+	if constexpr(sizeof(Index) == 1)
+		return _mm256_and_si256(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)src)), indexMask);
+	else
+		return _mm256_and_si256(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)src)), indexMask);
+}
+
+template <class Index>
+[[gnu::target("avx2")]]
+static size_t convertRowIndexedAVX2(uint32_t * __restrict__ dest, const Index * __restrict__ src, size_t pixels, std::span<const uint32_t> palette)
+{
+	auto indexMask = _mm256_set1_epi32(palette.size() - 1);
+	size_t i = 0;
+	for(; i + 8 <= pixels; i += 8)
+	{
+		auto idx = loadIndexesx8(&src[i], indexMask);
+		_mm256_storeu_si256((__m256i*)&dest[i], _mm256_i32gather_epi32((const int*)palette.data(), idx, 4));
+	}
+	return i;
+}
+
+template <class Index>
+[[gnu::target("avx2")]]
+static size_t convertRowIndexedAVX2(uint16_t * __restrict__ dest, const Index * __restrict__ src, size_t pixels, std::span<const uint16_t> palette)
+{
+	// gathers are 32-bit so the last entry can't be loaded without reading past the end of the palette,
+	// mask off those lanes & take the entry from the fallback value instead
+	auto lastIdx = _mm256_set1_epi32(palette.size() - 1);
+	auto lastEntry = _mm256_set1_epi32(palette.back());
+	auto lowMask = _mm256_set1_epi32(0xFFFF);
+	size_t i = 0;
+	for(; i + 16 <= pixels; i += 16)
+	{
+		auto idxLo = loadIndexesx8(&src[i], lastIdx);
+		auto idxHi = loadIndexesx8(&src[i + 8], lastIdx);
+		auto lo = _mm256_mask_i32gather_epi32(lastEntry, (const int*)palette.data(), idxLo,
+			_mm256_xor_si256(_mm256_cmpeq_epi32(idxLo, lastIdx), _mm256_set1_epi32(-1)), 2);
+		auto hi = _mm256_mask_i32gather_epi32(lastEntry, (const int*)palette.data(), idxHi,
+			_mm256_xor_si256(_mm256_cmpeq_epi32(idxHi, lastIdx), _mm256_set1_epi32(-1)), 2);
+		auto packed = _mm256_packus_epi32(_mm256_and_si256(lo, lowMask), _mm256_and_si256(hi, lowMask));
+		_mm256_storeu_si256((__m256i*)&dest[i], _mm256_permute4x64_epi64(packed, 0b11'01'10'00));
+	}
+	return i;
+}
+
+#endif
+
+#if defined __ARM_NEON && defined __aarch64__
+
+// 8-bit indexes use table lookups on each byte plane of the palette, 4 x 64-byte tables per plane,
+// out of range indexes return 0 from TBL so the results of each table can be OR'd together
+
+static uint8x16_t lookupPlane(const uint8_t *plane, uint8x16_t idx)
+{
+	auto offset = vdupq_n_u8(64);
+	auto r = vqtbl4q_u8(vld1q_u8_x4(plane), idx);
+	idx = vsubq_u8(idx, offset);
+	r = vorrq_u8(r, vqtbl4q_u8(vld1q_u8_x4(plane + 64), idx));
+	idx = vsubq_u8(idx, offset);
+	r = vorrq_u8(r, vqtbl4q_u8(vld1q_u8_x4(plane + 128), idx));
+	idx = vsubq_u8(idx, offset);
+	return vorrq_u8(r, vqtbl4q_u8(vld1q_u8_x4(plane + 192), idx));
+}
+
+template <class T>
+static size_t convertRowIndexedNEON(T * __restrict__ dest, const uint8_t * __restrict__ src, size_t pixels, std::span<const T> palette)
+{
+	// smaller palettes would need their indexes wrapped first, not worth it for short rows either
+	if(palette.size() != 256 || pixels < 64)
+		return 0;
+	alignas(16) uint8_t planes[sizeof(T)][256];
+	for(size_t e = 0; e < 256; e += 16)
+	{
+		if constexpr(sizeof(T) == 2)
+		{
+			auto p = vld2q_u8((const uint8_t*)&palette[e]);
+			vst1q_u8(&planes[0][e], p.val[0]);
+			vst1q_u8(&planes[1][e], p.val[1]);
+		}
+		else
+		{
+			auto p = vld4q_u8((const uint8_t*)&palette[e]);
+			vst1q_u8(&planes[0][e], p.val[0]);
+			vst1q_u8(&planes[1][e], p.val[1]);
+			vst1q_u8(&planes[2][e], p.val[2]);
+			vst1q_u8(&planes[3][e], p.val[3]);
+		}
+	}
+	size_t i = 0;
+	for(; i + 16 <= pixels; i += 16)
+	{
+		auto idx = vld1q_u8(&src[i]);
+		if constexpr(sizeof(T) == 2)
+		{
+			vst2q_u8((uint8_t*)&dest[i], uint8x16x2_t{{lookupPlane(planes[0], idx), lookupPlane(planes[1], idx)}});
+		}
+		else
+		{
+			vst4q_u8((uint8_t*)&dest[i], uint8x16x4_t{{lookupPlane(planes[0], idx), lookupPlane(planes[1], idx),
+				lookupPlane(planes[2], idx), lookupPlane(planes[3], idx)}});
+		}
+	}
+	return i;
+}
+
+#endif
+
+template <class T, class Index>
+static void convertRowIndexedImpl(T * __restrict__ dest, const Index * __restrict__ src, size_t pixels, std::span<const T> palette)
+{
+	assumeExpr(std::has_single_bit(palette.size()));
+	size_t i = 0;
+	#if defined IG_PIXMAP_HAS_AVX2_KERNELS
+	if(hasAVX2)
+		i = convertRowIndexedAVX2(dest, src, pixels, palette);
+	#elif defined __ARM_NEON && defined __aarch64__
+	if constexpr(sizeof(Index) == 1)
+		i = convertRowIndexedNEON(dest, src, pixels, palette);
+	#endif
+	auto indexMask = palette.size() - 1;
+	transformN(src + i, pixels - i, dest + i, [&](Index p){ return palette[p & indexMask]; });
+}
+
+void convertRowIndexed8(uint16_t *dest, const uint8_t *src, size_t pixels, std::span<const uint16_t> palette) { convertRowIndexedImpl(dest, src, pixels, palette); }
+void convertRowIndexed8(uint32_t *dest, const uint8_t *src, size_t pixels, std::span<const uint32_t> palette) { convertRowIndexedImpl(dest, src, pixels, palette); }
+void convertRowIndexed16(uint16_t *dest, const uint16_t *src, size_t pixels, std::span<const uint16_t> palette) { convertRowIndexedImpl(dest, src, pixels, palette); }
+void convertRowIndexed16(uint32_t *dest, const uint16_t *src, size_t pixels, std::span<const uint32_t> palette) { convertRowIndexedImpl(dest, src, pixels, palette); }
+
 }
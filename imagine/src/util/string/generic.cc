@@ -19,6 +19,7 @@
 #include <imagine/util/utf.hh>
 #include <cstdint>
 #include <cstring>
+#include <cwctype>
 #include <algorithm>
 #include <system_error>
 
@@ -83,4 +84,33 @@ bool stringNoCaseLexCompare(std::string_view s1, std::string_view s2)
 		});
 }
 
+// case-insensitive compare where runs of digits are ordered by numeric value, so "Disc 2" sorts before "Disc 10"
+bool stringNaturalNoCaseLexCompare(std::u16string_view s1, std::u16string_view s2)
+{
+	auto isDigit = [](char16_t c) { return c >= u'0' && c <= u'9'; };
+	size_t i1{}, i2{};
+	while(i1 < s1.size() && i2 < s2.size())
+	{
+		if(isDigit(s1[i1]) && isDigit(s2[i2]))
+		{
+			while(i1 < s1.size() && s1[i1] == u'0') i1++;
+			while(i2 < s2.size() && s2[i2] == u'0') i2++;
+			auto start1 = i1, start2 = i2;
+			while(i1 < s1.size() && isDigit(s1[i1])) i1++;
+			while(i2 < s2.size() && isDigit(s2[i2])) i2++;
+			auto num1 = s1.substr(start1, i1 - start1), num2 = s2.substr(start2, i2 - start2);
+			if(num1.size() != num2.size())
+				return num1.size() < num2.size();
+			if(auto cmp = num1.compare(num2); cmp)
+				return cmp < 0;
+			continue;
+		}
+		auto c1 = std::towlower(s1[i1]), c2 = std::towlower(s2[i2]);
+		if(c1 != c2)
+			return c1 < c2;
+		i1++; i2++;
+	}
+	return (s1.size() - i1) < (s2.size() - i2);
+}
+
 }
@@ -146,6 +146,14 @@ void RingBuffer::commitWrite(SizeType size)
 	written.fetch_add(size, std::memory_order_release);
 }
 
+void RingBuffer::uncommitWrite(SizeType size_)
+{
+	// remove the most recently written bytes, allowing the buffer to be used as a stack
+	assert(size_ <= size());
+	end = rewindAddr(end, size_);
+	written.fetch_sub(size_, std::memory_order_release);
+}
+
 SizeType RingBuffer::read(void *buff, SizeType size_)
 {
 	auto writtenSize = size();
@@ -174,6 +182,13 @@ char *RingBuffer::advanceAddr(char *ptr, SizeType size) const
 	return wrapPtr(ptr + size);
 }
 
+char *RingBuffer::rewindAddr(char *ptr, SizeType size) const
+{
+	if(size > SizeType(ptr - buff))
+		return ptr + (buffSize - size);
+	return ptr - size;
+}
+
 char *RingBuffer::wrapPtr(char *ptr) const
 {
 	if(ptr >= buff + buffSize)
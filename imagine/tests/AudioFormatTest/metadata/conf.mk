@@ -0,0 +1,7 @@
+metadata_name = Audio Format Test
+metadata_pkgName = AudioFormatTest
+metadata_exec = audioformattest
+metadata_id = com.explusalpha.$(metadata_pkgName)
+metadata_vendor = Robert Broglia
+metadata_version = 1.0.0
+metadata_noIcon = 1
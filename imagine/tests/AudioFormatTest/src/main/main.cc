@@ -0,0 +1,182 @@
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "main"
+#include <imagine/base/ApplicationContext.hh>
+#include <imagine/base/Application.hh>
+#include <imagine/audio/Format.hh>
+#include <imagine/time/Time.hh>
+#include <imagine/util/ranges.hh>
+#include <imagine/logger/logger.h>
+#include <meta.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Checks each vector kernel set of Audio::Format::copyFrames() produces the same bytes as the scalar code
+// for every sample format & channel combination, then times them. The exit status is non-zero on a mismatch.
+
+namespace AudioFormatTest
+{
+
+using namespace IG::Audio;
+
+struct KernelDesc
+{
+	SampleKernels kernels;
+	const char *name;
+};
+
+static constexpr KernelDesc vectorKernels[]
+{
+	{SampleKernels::SSE2, "SSE2"},
+	{SampleKernels::AVX2, "AVX2"},
+	{SampleKernels::NEON, "NEON"},
+};
+
+static constexpr SampleFormat sampleFormats[]{SampleFormats::i16, SampleFormats::f32};
+static constexpr int channelCounts[]{1, 2};
+static constexpr float volumes[]{1.f, .5f};
+static constexpr size_t maxFrames = 4096;
+static constexpr int benchmarkRuns = 2000;
+
+static const char *formatName(SampleFormat fmt) { return fmt.isFloat() ? "f32" : "i16"; }
+
+// samples cover the full int16 range and floats slightly past [-1, 1] to exercise clamping
+static std::vector<uint8_t> makeInput(SampleFormat fmt, size_t samples)
+{
+	std::mt19937 gen{1234};
+	std::vector<uint8_t> data(samples * fmt.bytes());
+	if(fmt.isFloat())
+	{
+		std::uniform_real_distribution<float> dist{-1.1f, 1.1f};
+		for(auto i : IG::iotaCount(samples))
+		{
+			auto s = dist(gen);
+			memcpy(&data[i * sizeof(s)], &s, sizeof(s));
+		}
+	}
+	else
+	{
+		std::uniform_int_distribution<int> dist{-32768, 32767};
+		for(auto i : IG::iotaCount(samples))
+		{
+			int16_t s = dist(gen);
+			memcpy(&data[i * sizeof(s)], &s, sizeof(s));
+		}
+	}
+	return data;
+}
+
+static std::vector<uint8_t> copyWith(SampleKernels kernels, Format destFmt, Format srcFmt,
+	const std::vector<uint8_t> &src, size_t frames, float volume)
+{
+	IG::Audio::setSampleKernels(kernels);
+	std::vector<uint8_t> dest(destFmt.framesToBytes(frames));
+	destFmt.copyFrames(dest.data(), src.data(), frames, srcFmt, volume);
+	return dest;
+}
+
+static bool testEquivalence(KernelDesc desc)
+{
+	bool passed = true;
+	for(auto srcSample : sampleFormats)
+	{
+		for(auto destSample : sampleFormats)
+		{
+			for(auto channels : channelCounts)
+			{
+				Format srcFmt{48000, srcSample, (int8_t)channels};
+				Format destFmt{48000, destSample, (int8_t)channels};
+				auto src = makeInput(srcSample, maxFrames * channels);
+				for(auto volume : volumes)
+				{
+					// sizes around the vector widths to cover the scalar tail after the kernels
+					for(size_t frames : {size_t{1}, size_t{3}, size_t{7}, size_t{8}, size_t{9}, size_t{15}, size_t{16},
+						size_t{17}, size_t{31}, size_t{33}, size_t{257}, maxFrames})
+					{
+						auto expected = copyWith(SampleKernels::SCALAR, destFmt, srcFmt, src, frames, volume);
+						auto result = copyWith(desc.kernels, destFmt, srcFmt, src, frames, volume);
+						if(result != expected)
+						{
+							std::printf("%s mismatch: %s -> %s, %d channel(s), volume %.2f, %zu frames\n", desc.name,
+								formatName(srcSample), formatName(destSample), channels, volume, frames);
+							passed = false;
+						}
+					}
+				}
+			}
+		}
+	}
+	return passed;
+}
+
+static void runBenchmark(KernelDesc desc)
+{
+	for(auto srcSample : sampleFormats)
+	{
+		for(auto destSample : sampleFormats)
+		{
+			constexpr int channels = 2;
+			Format srcFmt{48000, srcSample, channels};
+			Format destFmt{48000, destSample, channels};
+			auto src = makeInput(srcSample, maxFrames * channels);
+			std::vector<uint8_t> dest(destFmt.framesToBytes(maxFrames));
+			IG::Audio::setSampleKernels(desc.kernels);
+			auto time = IG::timeFunc([&]()
+			{
+				for([[maybe_unused]] auto i : IG::iotaCount(benchmarkRuns))
+				{
+					destFmt.copyFrames(dest.data(), src.data(), maxFrames, srcFmt, .5f);
+				}
+			});
+			std::printf("%-6s %s -> %s: %8.1fns per %zu stereo frames\n", desc.name, formatName(srcSample),
+				formatName(destSample), std::chrono::duration<double, std::nano>{time}.count() / benchmarkRuns, maxFrames);
+		}
+	}
+}
+
+}
+
+namespace IG
+{
+
+const char *const ApplicationContext::applicationName{CONFIG_APP_NAME};
+
+void ApplicationContext::onInit(ApplicationInitParams)
+{
+	using namespace AudioFormatTest;
+	auto defaultKernels = IG::Audio::sampleKernels();
+	bool passed = true;
+	runBenchmark({IG::Audio::SampleKernels::SCALAR, "scalar"});
+	for(auto desc : vectorKernels)
+	{
+		if(!IG::Audio::setSampleKernels(desc.kernels))
+		{
+			std::printf("%s kernels not supported, skipping\n", desc.name);
+			continue;
+		}
+		bool kernelsPassed = testEquivalence(desc);
+		std::printf("%s kernels match scalar: %s\n", desc.name, kernelsPassed ? "passed" : "FAILED");
+		passed &= kernelsPassed;
+		runBenchmark(desc);
+	}
+	IG::Audio::setSampleKernels(defaultKernels);
+	::exit(passed ? 0 : 1);
+}
+
+}
@@ -0,0 +1,155 @@
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "main"
+#include <imagine/base/ApplicationContext.hh>
+#include <imagine/base/Application.hh>
+#include <imagine/base/EventLoop.hh>
+#include <imagine/base/MessagePort.hh>
+#include <imagine/base/SPSCMessagePort.hh>
+#include <imagine/thread/Thread.hh>
+#include <imagine/time/Time.hh>
+#include <imagine/util/ranges.hh>
+#include <imagine/logger/logger.h>
+#include <meta.h>
+#include <cstdio>
+#include <cstdlib>
+
+// Compares PipeMessagePort & SPSCMessagePort with a thread receiving messages from the main thread:
+// round trips where each message waits for its reply, and bursts of messages with a reply only on the last one.
+// Also checks every message arrives once & in order, the exit status is non-zero if not.
+
+namespace MessagePortTest
+{
+
+struct TestMessage
+{
+	std::binary_semaphore *semPtr{};
+	uint32_t seq{};
+	bool quit{};
+	bool valid{true}; // PipeMessagePort ends its message iteration on a false message
+
+	explicit operator bool() const { return valid; }
+	void setReplySemaphore(std::binary_semaphore *sem) { semPtr = sem; }
+};
+
+static constexpr int roundTrips = 100000;
+static constexpr int bursts = 10000;
+static constexpr int burstSize = 8;
+
+struct Receiver
+{
+	uint32_t nextSeq{};
+	bool inOrder{true};
+
+	// returns false when the quit message arrives
+	bool onMessages(auto msgs)
+	{
+		for(auto msg : msgs)
+		{
+			if(msg.seq != nextSeq++)
+				inOrder = false;
+			if(msg.semPtr)
+				msg.semPtr->release();
+			if(msg.quit)
+				return false;
+		}
+		return true;
+	}
+};
+
+static std::thread startReceiver(IG::PipeMessagePort<TestMessage> &port, Receiver &receiver)
+{
+	return IG::makeThreadSync(
+		[&](auto &sem)
+		{
+			auto eventLoop = IG::EventLoop::makeForThread();
+			bool running = true;
+			port.attach(eventLoop,
+				[&](auto msgs)
+				{
+					if(receiver.onMessages(msgs))
+						return true;
+					running = false;
+					IG::EventLoop::forThread().stop();
+					return false;
+				});
+			sem.release();
+			eventLoop.run(running);
+			port.detach();
+		});
+}
+
+static std::thread startReceiver(IG::SPSCMessagePort<TestMessage> &port, Receiver &receiver)
+{
+	return IG::makeThreadSync(
+		[&](auto &sem)
+		{
+			sem.release();
+			port.run([&](auto msgs){ return receiver.onMessages(msgs); });
+		});
+}
+
+template<class Port>
+static bool runPortTest(const char *name)
+{
+	Port port{name};
+	Receiver receiver;
+	auto thread = startReceiver(port, receiver);
+	uint32_t seq{};
+	auto roundTripTime = IG::timeFunc([&]()
+	{
+		for([[maybe_unused]] auto i : IG::iotaCount(roundTrips))
+		{
+			port.send(TestMessage{.seq = seq++}, true);
+		}
+	});
+	auto burstTime = IG::timeFunc([&]()
+	{
+		for([[maybe_unused]] auto i : IG::iotaCount(bursts))
+		{
+			for([[maybe_unused]] auto j : IG::iotaCount(burstSize - 1))
+			{
+				port.send(TestMessage{.seq = seq++});
+			}
+			port.send(TestMessage{.seq = seq++}, true);
+		}
+	});
+	port.send(TestMessage{.seq = seq++, .quit = true}, true);
+	thread.join();
+	bool passed = receiver.inOrder && receiver.nextSeq == seq;
+	std::printf("%-16s round trip: %8.1fns  burst of %d: %8.1fns  %s\n", name,
+		std::chrono::duration<double, std::nano>{roundTripTime}.count() / roundTrips,
+		burstSize, std::chrono::duration<double, std::nano>{burstTime}.count() / bursts,
+		passed ? "passed" : "FAILED (messages lost or out of order)");
+	return passed;
+}
+
+}
+
+namespace IG
+{
+
+const char *const ApplicationContext::applicationName{CONFIG_APP_NAME};
+
+void ApplicationContext::onInit(ApplicationInitParams)
+{
+	using namespace MessagePortTest;
+	bool passed = runPortTest<IG::PipeMessagePort<TestMessage>>("PipeMessagePort");
+	passed &= runPortTest<IG::SPSCMessagePort<TestMessage>>("SPSCMessagePort");
+	::exit(passed ? 0 : 1);
+}
+
+}
@@ -0,0 +1,7 @@
+metadata_name = Pixmap Test
+metadata_pkgName = PixmapTest
+metadata_exec = pixmaptest
+metadata_id = com.explusalpha.$(metadata_pkgName)
+metadata_vendor = Robert Broglia
+metadata_version = 1.0.0
+metadata_noIcon = 1
@@ -0,0 +1,183 @@
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#define LOGTAG "main"
+#include <imagine/base/ApplicationContext.hh>
+#include <imagine/base/Application.hh>
+#include <imagine/pixmap/Pixmap.hh>
+#include <imagine/time/Time.hh>
+#include <imagine/util/ranges.hh>
+#include <imagine/logger/logger.h>
+#include <meta.h>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// Checks the indexed row converters & PixmapView::writeIndexed() against a plain palette lookup for
+// every index & palette entry size, then times them against that lookup on emulator sized frames.
+// The exit status is non-zero on a mismatch.
+
+namespace PixmapTest
+{
+
+static constexpr int benchmarkRuns = 500;
+
+template <class T>
+static std::vector<T> makeRandom(size_t size, std::mt19937 &gen)
+{
+	std::uniform_int_distribution<uint32_t> dist{0, std::numeric_limits<T>::max()};
+	std::vector<T> v(size);
+	for(auto &e : v) { e = dist(gen); }
+	return v;
+}
+
+template <class Dest, class Index>
+static void lookupRow(Dest *dest, const Index *src, size_t pixels, std::span<const Dest> palette)
+{
+	auto indexMask = palette.size() - 1;
+	for(auto i : IG::iotaCount(pixels))
+	{
+		dest[i] = palette[src[i] & indexMask];
+	}
+}
+
+template <class Dest, class Index>
+static void convertRow(Dest *dest, const Index *src, size_t pixels, std::span<const Dest> palette)
+{
+	if constexpr(sizeof(Index) == 1)
+		IG::convertRowIndexed8(dest, src, pixels, palette);
+	else
+		IG::convertRowIndexed16(dest, src, pixels, palette);
+}
+
+template <class Dest, class Index>
+static bool testRows(size_t paletteSize)
+{
+	std::mt19937 gen{1234};
+	auto palette = makeRandom<Dest>(paletteSize, gen);
+	// indexes use the full range of their type so masking is covered on smaller palettes
+	auto src = makeRandom<Index>(1024, gen);
+	bool passed = true;
+	// lengths around the vector widths so the scalar tail runs too
+	for(size_t pixels : {size_t{1}, size_t{7}, size_t{8}, size_t{9}, size_t{15}, size_t{16}, size_t{17},
+		size_t{63}, size_t{64}, size_t{65}, size_t{240}, size_t{1024}})
+	{
+		std::vector<Dest> expected(pixels), result(pixels);
+		lookupRow<Dest, Index>(expected.data(), src.data(), pixels, palette);
+		convertRow<Dest, Index>(result.data(), src.data(), pixels, palette);
+		if(result != expected)
+		{
+			std::printf("mismatch: %zu-bit index, %zu-bit entries, %zu entry palette, %zu pixels\n",
+				sizeof(Index) * 8, sizeof(Dest) * 8, paletteSize, pixels);
+			passed = false;
+		}
+	}
+	return passed;
+}
+
+// writes a frame with padded rows on both sides, checking the padding is untouched
+template <class Dest, class Index>
+static bool testWriteIndexed(size_t paletteSize)
+{
+	std::mt19937 gen{5678};
+	auto palette = makeRandom<Dest>(paletteSize, gen);
+	constexpr int w = 61, h = 7, srcPitch = 64, destPitch = 67;
+	auto src = makeRandom<Index>(srcPitch * h, gen);
+	constexpr Dest padding = 0x5A;
+	std::vector<Dest> dest(destPitch * h, padding), expected(destPitch * h, padding);
+	for(auto y : IG::iotaCount(h))
+	{
+		lookupRow<Dest, Index>(&expected[y * destPitch], &src[y * srcPitch], w, palette);
+	}
+	auto srcFmt = sizeof(Index) == 1 ? IG::PIXEL_FMT_I8 : IG::PIXEL_FMT_RGB565;
+	auto destFmt = sizeof(Dest) == 2 ? IG::PIXEL_FMT_RGB565 : IG::PIXEL_FMT_RGBA8888;
+	IG::PixmapView srcPix{{{w, h}, srcFmt}, src.data(), {srcPitch, IG::PixmapUnits::PIXEL}};
+	IG::MutablePixmapView destPix{{{w, h}, destFmt}, dest.data(), {destPitch, IG::PixmapUnits::PIXEL}};
+	destPix.writeIndexed<Dest>(palette, srcPix);
+	if(dest != expected)
+	{
+		std::printf("writeIndexed mismatch: %zu-bit index, %zu-bit entries, %zu entry palette\n",
+			sizeof(Index) * 8, sizeof(Dest) * 8, paletteSize);
+		return false;
+	}
+	return true;
+}
+
+template <class Dest, class Index>
+static bool runTests(size_t paletteSize)
+{
+	bool rowsPassed = testRows<Dest, Index>(paletteSize);
+	bool writePassed = testWriteIndexed<Dest, Index>(paletteSize);
+	return rowsPassed && writePassed;
+}
+
+template <class Dest, class Index>
+static void runBenchmark(const char *name, int w, int h, size_t paletteSize)
+{
+	std::mt19937 gen{1234};
+	auto palette = makeRandom<Dest>(paletteSize, gen);
+	auto src = makeRandom<Index>(w * h, gen);
+	std::vector<Dest> dest(w * h);
+	auto timeRuns = [&](auto &&rowFunc)
+	{
+		auto time = IG::timeFunc([&]()
+		{
+			for([[maybe_unused]] auto i : IG::iotaCount(benchmarkRuns))
+			{
+				for(auto y : IG::iotaCount(h))
+				{
+					rowFunc(&dest[y * w], &src[y * w], size_t(w), std::span<const Dest>{palette});
+				}
+			}
+		});
+		return std::chrono::duration<double, std::micro>{time}.count() / benchmarkRuns;
+	};
+	auto lookupTime = timeRuns(lookupRow<Dest, Index>);
+	auto convertTime = timeRuns(convertRow<Dest, Index>);
+	std::printf("%-32s lookup: %7.2fus  convertRowIndexed: %7.2fus per frame\n", name, lookupTime, convertTime);
+}
+
+}
+
+namespace IG
+{
+
+const char *const ApplicationContext::applicationName{CONFIG_APP_NAME};
+
+void ApplicationContext::onInit(ApplicationInitParams)
+{
+	using namespace PixmapTest;
+	bool passed = true;
+	for(size_t paletteSize : {16, 64, 256})
+	{
+		passed &= runTests<uint16_t, uint8_t>(paletteSize);
+		passed &= runTests<uint32_t, uint8_t>(paletteSize);
+	}
+	for(size_t paletteSize : {16, 4096, 65536})
+	{
+		passed &= runTests<uint16_t, uint16_t>(paletteSize);
+		passed &= runTests<uint32_t, uint16_t>(paletteSize);
+	}
+	std::printf("indexed conversions match lookup: %s\n", passed ? "passed" : "FAILED");
+	runBenchmark<uint16_t, uint8_t>("NES 256x240 8-bit -> RGB565", 256, 240, 256);
+	runBenchmark<uint32_t, uint8_t>("NES 256x240 8-bit -> RGBA8888", 256, 240, 256);
+	runBenchmark<uint16_t, uint16_t>("GBA 240x160 16-bit -> RGB565", 240, 160, 65536);
+	runBenchmark<uint32_t, uint16_t>("GBA 240x160 16-bit -> RGBA8888", 240, 160, 65536);
+	runBenchmark<uint32_t, uint16_t>("NGP 160x152 12-bit -> RGBA8888", 160, 152, 4096);
+	::exit(passed ? 0 : 1);
+}
+
+}